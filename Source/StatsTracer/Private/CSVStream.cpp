@@ -20,9 +20,70 @@
 
 namespace StatsTracer {
 
-	CSVStream::CSVStream(const FString& sessionName, const FString& tracerName) :
-		m_Buffer(FString())
+	///-------------------------------------------------------------------------------------------------
+	/// Fn:	static ANSICHAR* FormatInt(int32 value, ANSICHAR* dest)
+	///
+	/// Summary:	Writes the decimal digits of value to dest.
+	///
+	/// Returns:	The end of the written characters.
+	///-------------------------------------------------------------------------------------------------
+
+	static FORCEINLINE ANSICHAR* FormatInt(int32 value, ANSICHAR* dest)
 	{
+		ANSICHAR digits[10];
+		int32 numDigits = 0;
+
+		uint32 magnitude = value < 0 ? 0u - (uint32)value : (uint32)value;
+		do
+		{
+			digits[numDigits++] = (ANSICHAR)('0' + magnitude % 10);
+			magnitude /= 10;
+		}
+		while (magnitude != 0);
+
+		if (value < 0)
+			*dest++ = '-';
+
+		while (numDigits > 0)
+			*dest++ = digits[--numDigits];
+
+		return dest;
+	}
+
+	///-------------------------------------------------------------------------------------------------
+	/// Fn:	static ANSICHAR* FormatFloat(float value, ANSICHAR* dest)
+	///
+	/// Summary:	Writes the shortest decimal representation (6 to 9 significant digits) of value
+	/// that reads back as the very same float, including the sign of negative zero. Integral values
+	/// take the integer path. dest must hold CSVStream::MAX_VALUE_LENGTH characters.
+	///
+	/// Returns:	The end of the written characters.
+	///-------------------------------------------------------------------------------------------------
+
+	static ANSICHAR* FormatFloat(float value, ANSICHAR* dest)
+	{
+		// exactly representable integers, most counters and frame numbers end up here
+		if (FMath::Abs(value) < 16777216.0f && value == (float)(int32)value && (value != 0.0f || FMath::IsNegativeFloat(value) == false))
+			return FormatInt((int32)value, dest);
+
+		// most values round-trip with fewer digits than the 9 a float needs at most
+		for (int32 precision = 6; precision < 9; ++precision)
+		{
+			const int32 length = FCStringAnsi::Snprintf(dest, 32, "%.*g", precision, value);
+
+			// parsed as float directly, a detour through double may round differently
+			const float parsed = strtof(dest, nullptr);
+			if (FMemory::Memcmp(&parsed, &value, sizeof(float)) == 0)
+				return dest + length;
+		}
+
+		return dest + FCStringAnsi::Snprintf(dest, 32, "%.9g", value);
+	}
+
+	CSVStream::CSVStream(const FString& sessionName, const FString& tracerName)
+	{
+		this->m_Buffer.Reserve(INITIAL_BUFFER_SIZE);
+
 		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
 		
 		auto fileDir = FPaths::Combine(UStatsTracerEditorSettings::GetInstance()->CsvOutputDir.Path, sessionName);
@@ -32,22 +93,21 @@ namespace StatsTracer {
 			FString fullFileName = FPaths::Combine(fileDir, FString::Printf(TEXT("%s.csv"), *tracerName));
 
 			// if there is already a file with the same name add an suffix to name
-			if (PlatformFile.FileExists(*fullFileName) == true)
+			if (PlatformFile.FileExists(*fullFileName) == true || PlatformFile.FileExists(*(fullFileName + FTraceFileWriter::COMPRESSED_EXTENSION)) == true)
 			{
 				int32 suffix = 1;
 				while (true)
 				{
 					fullFileName = FPaths::Combine(fileDir, FString::Printf(TEXT("%s-%d.csv"), *tracerName, suffix++));
 
-					if (PlatformFile.FileExists(*fullFileName) == true)
+					if (PlatformFile.FileExists(*fullFileName) == true || PlatformFile.FileExists(*(fullFileName + FTraceFileWriter::COMPRESSED_EXTENSION)) == true)
 						continue;
 
 					break;
 				}
 			}
 
-			this->m_FileHandle = PlatformFile.OpenWrite(*fullFileName);
-			if (this->m_FileHandle == nullptr)
+			if (this->m_Output.OpenFile(fullFileName) == false)
 			{
 				UE_LOG(LogTemp, Warning, TEXT("Failed to open csv file '%s'!"), *fullFileName);
 			}
@@ -58,9 +118,29 @@ namespace StatsTracer {
 		}
 	}
 
+	CSVStream::CSVStream(const FString& fileName)
+	{
+		this->m_Buffer.Reserve(INITIAL_BUFFER_SIZE);
+
+		if (this->m_Output.OpenFile(fileName) == false)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to open csv file '%s'!"), *fileName);
+		}
+	}
+
+	CSVStream::CSVStream(const FSessionContainerHandle& container, const FString& tracerName)
+	{
+		this->m_Buffer.Reserve(INITIAL_BUFFER_SIZE);
+
+		if (this->m_Output.OpenStream(container, FString::Printf(TEXT("%s.csv"), *tracerName)) == false)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to add csv stream '%s' to the session container!"), *tracerName);
+		}
+	}
+
 	CSVStream::~CSVStream()
 	{
-		if (this->m_FileHandle != nullptr)
+		if (this->m_Output.IsOpen() == true)
 			Close();
 	}
 
@@ -68,37 +148,55 @@ namespace StatsTracer {
 	{
 		SCOPE_CYCLE_COUNTER(STAT_CSVFlush);
 
-		// write to file
+		// hand the buffer to the output, the file writer flushes the file on its own schedule
 		Write();
 
-		// clear buffer
-		this->m_Buffer.Empty();
-
-		// flush file handle
-		this->m_FileHandle->Flush();
+		// clear buffer, but keep its allocation for the next row
+		this->m_Buffer.Reset();
 	}
 
 	void CSVStream::Close()
 	{
+		if (this->m_Output.IsOpen() == false)
+			return;
+
 		Flush();
 
-		delete this->m_FileHandle;
-		this->m_FileHandle = nullptr;
+		this->m_Output.Close();
+	}
+	 
+	void CSVStream::HandOffIfDue()
+	{
+		// rows are handed to the output as they end, only the output may still hold some back
+		if (this->m_Output.IsHandOffDue() == true)
+			this->m_Output.HandOff();
 	}
 	 
 	bool CSVStream::IsValid() const
 	{
-		if (this->m_FileHandle != nullptr)
-			return true;
+		return this->m_Output.IsValid();
+	}
+
+	void CSVStream::WriteSchemaChange(uint64 frame)
+	{
+		// a complete row without separators, csv readers skip it as a comment
+		const FString comment = FString::Printf(TEXT("# schema changed at frame %llu"), frame);
 
-		return false;
+		for (int32 i = 0; i < comment.Len(); ++i)
+			this->m_Buffer.Add((ANSICHAR)comment[i]);
+
+		for (int32 i = 0; i < NEWLINE.Len(); ++i)
+			this->m_Buffer.Add((ANSICHAR)NEWLINE[i]);
+
+		Flush();
 	}
 
 	void CSVStream::Write()
 	{
-		if (this->m_Buffer.Len() > 0)
+		if (this->m_Buffer.Num() > 0)
 		{
-			this->m_FileHandle->Write((const uint8*)TCHAR_TO_ANSI(*this->m_Buffer), this->m_Buffer.Len());
+			// the buffer already holds UTF-8, no conversion needed
+			this->m_Output.Write(this->m_Buffer.GetData(), this->m_Buffer.Num());
 		}
 	}
 
@@ -110,23 +208,15 @@ namespace StatsTracer {
 		{
 			case CSVStream::endl:
 			{
-//#if PLATFORM_WINDOWS
-//				static const FString NEWLINE = FString(TEXT("\r\n"));
-//#elif PLATFORM_LINUX
-//				static const FString NEWLINE = FString(TEXT("\n"));
-//#elif PLATFORM_MAC
-//				static const FString NEWLINE = FString(TEXT("\r"));
-//#else
-//				static const FString NEWLINE = FString(TEXT("\r\n"));
-//#endif
-
-				if (stream.m_Buffer.Len() > 0)
+				if (stream.m_Buffer.Num() > 0)
 				{
 					// overwrite last ','
-					stream.m_Buffer.RemoveAt(stream.m_Buffer.Len() - 1);
+					stream.m_Buffer.Pop(false);
 				}
 
-				stream.m_Buffer.Append(NEWLINE);
+				for (int32 i = 0; i < NEWLINE.Len(); ++i)
+					stream.m_Buffer.Add((ANSICHAR)NEWLINE[i]);
+
 				stream.Flush();
 				break;
 			}
@@ -139,7 +229,11 @@ namespace StatsTracer {
 	{
 		SCOPE_CYCLE_COUNTER(STAT_CSVSteamOperator);
 
-		stream.m_Buffer.Append(value).AppendChar(CSVStream::SEPERATOR);
+		// converts on the stack for all but very long strings
+		FTCHARToUTF8 utf8(*value);
+
+		stream.m_Buffer.Append((const ANSICHAR*)utf8.Get(), utf8.Length());
+		stream.m_Buffer.Add(CSVStream::SEPERATOR);
 		return stream;
 	}
 
@@ -147,7 +241,8 @@ namespace StatsTracer {
 	{
 		SCOPE_CYCLE_COUNTER(STAT_CSVSteamOperator);
 
-		stream.m_Buffer.AppendChar(value == true ? '1' : '0').AppendChar(CSVStream::SEPERATOR);
+		stream.m_Buffer.Add(value == true ? '1' : '0');
+		stream.m_Buffer.Add(CSVStream::SEPERATOR);
 		return stream;
 	}
 
@@ -155,7 +250,7 @@ namespace StatsTracer {
 	{
 		SCOPE_CYCLE_COUNTER(STAT_CSVSteamOperator);
 
-		stream.m_Buffer.AppendChar(value).AppendChar(CSVStream::SEPERATOR);
+		stream.EndValue(FormatInt(value, stream.BeginValue()));
 		return stream;
 	}
 
@@ -163,7 +258,7 @@ namespace StatsTracer {
 	{
 		SCOPE_CYCLE_COUNTER(STAT_CSVSteamOperator);
 
-		stream.m_Buffer.Append(FString::FromInt(value)).AppendChar(CSVStream::SEPERATOR);
+		stream.EndValue(FormatInt(value, stream.BeginValue()));
 		return stream;
 	}
 
@@ -171,7 +266,7 @@ namespace StatsTracer {
 	{
 		SCOPE_CYCLE_COUNTER(STAT_CSVSteamOperator);
 
-		stream.m_Buffer.Append(FString::SanitizeFloat(value)).AppendChar(CSVStream::SEPERATOR);
+		stream.EndValue(FormatFloat(value, stream.BeginValue()));
 		return stream;
 	}
 
@@ -189,7 +284,8 @@ namespace StatsTracer {
 
 	CSVStream& operator<<(CSVStream& stream, const FTransform& value)
 	{
-		stream << value.GetLocation() << value.GetRotation().Rotator() << value.GetScale3D();
+		// the quaternion is converted once, the rotator columns need Euler angles
+		stream << value.GetTranslation() << value.Rotator() << value.GetScale3D();
 		return stream;
 	}
 
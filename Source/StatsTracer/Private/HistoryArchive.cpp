@@ -0,0 +1,504 @@
+///-------------------------------------------------------------------------------------------------
+/// File:	StatsTracer\Private\HistoryArchive.cpp
+///
+/// Summary:	Implements the disk backed history archive class.
+///-------------------------------------------------------------------------------------------------
+
+#include "HistoryArchive.h"
+#include "StatsTracerPCH.h"
+
+#include "HAL/PlatformFilemanager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Misc/FileHelper.h"
+
+namespace StatsTracer {
+
+	/*
+		File layout:
+
+			header		MAGIC, VERSION, chunk length, number of columns, { type, sample size } per column
+			chunks		frames, elapsed times, one column per data source, each chunk GetChunkSize() bytes
+			index		{ offset, first frame, last frame, number of rows } per chunk, written by Close()
+			footer		number of chunks, index offset, MAGIC
+
+		Archives opened by OpenTrace have no file of their own, their chunks are decoded from the trace.
+	*/
+
+	/// Summary:	Decodes one row of a trace column (see FTraceStream) into a sample of the given type.
+	static FORCEINLINE void DecodeTraceSample(uint32 type, const uint8* source, uint8* dest)
+	{
+		float c[9];
+
+		switch ((EDataSourceType)type)
+		{
+			case Bool:
+			{
+				const bool value = *source != 0;
+				FMemory::Memcpy(dest, &value, sizeof(bool));
+				break;
+			}
+
+			case Byte:
+				*dest = *source;
+				break;
+
+			case Int:
+			case Float:
+				FMemory::Memcpy(dest, source, sizeof(uint32));
+				break;
+
+			case Vector:
+			{
+				FMemory::Memcpy(c, source, 3 * sizeof(float));
+				const FVector value(c[0], c[1], c[2]);
+				FMemory::Memcpy(dest, &value, sizeof(FVector));
+				break;
+			}
+
+			// rotators are written Roll, Pitch, Yaw
+			case Rotator:
+			{
+				FMemory::Memcpy(c, source, 3 * sizeof(float));
+				const FRotator value(c[1], c[2], c[0]);
+				FMemory::Memcpy(dest, &value, sizeof(FRotator));
+				break;
+			}
+
+			case Transform:
+			{
+				FMemory::Memcpy(c, source, 9 * sizeof(float));
+				const FTransform value(FRotator(c[4], c[5], c[3]), FVector(c[0], c[1], c[2]), FVector(c[6], c[7], c[8]));
+				FMemory::Memcpy(dest, &value, sizeof(FTransform));
+				break;
+			}
+		}
+	}
+
+	/// Summary:	Writes the zero sample of the given type, for columns a trace chunk was written without.
+	static FORCEINLINE void WriteZeroSample(uint32 type, uint8* dest)
+	{
+		switch ((EDataSourceType)type)
+		{
+			case Bool:		FMemory::Memcpy(dest, &ZeroSample<bool>::Value, sizeof(bool)); break;
+			case Int:		FMemory::Memcpy(dest, &ZeroSample<int32>::Value, sizeof(int32)); break;
+			case Float:		FMemory::Memcpy(dest, &ZeroSample<float>::Value, sizeof(float)); break;
+			case Byte:		FMemory::Memcpy(dest, &ZeroSample<uint8>::Value, sizeof(uint8)); break;
+			case Vector:	FMemory::Memcpy(dest, &ZeroSample<FVector>::Value, sizeof(FVector)); break;
+			case Rotator:	FMemory::Memcpy(dest, &ZeroSample<FRotator>::Value, sizeof(FRotator)); break;
+			case Transform:	FMemory::Memcpy(dest, &ZeroSample<FTransform>::Value, sizeof(FTransform)); break;
+		}
+	}
+
+	FHistoryArchive::FHistoryArchive(uint32 chunkLength, const TArray<FColumn>& columns) :
+		m_ChunkLength(chunkLength),
+		m_Columns(columns),
+		m_ChunkSize(0),
+		m_DataOffset(0),
+		m_NumChunks(0),
+		m_Writer(nullptr),
+		m_Reader(nullptr),
+		m_PageClock(0),
+		m_Trace(nullptr)
+	{
+		// timeline columns first, then one column per data source
+		this->m_ChunkSize = (sizeof(uint64) + sizeof(double)) * this->m_ChunkLength;
+
+		for (const FColumn& column : this->m_Columns)
+		{
+			this->m_ColumnOffsets.Add(this->m_ChunkSize);
+			this->m_ChunkSize += (int64)column.SampleSize * this->m_ChunkLength;
+		}
+	}
+
+	FHistoryArchive::FHistoryArchive(const FString& directory, const FString& name, uint32 chunkLength, const TArray<FColumn>& columns) :
+		FHistoryArchive(chunkLength, columns)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+		if (PlatformFile.CreateDirectoryTree(*directory) == false)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Unable to access history archive directory '%s'!"), *directory);
+			return;
+		}
+
+		this->m_FileName = FPaths::Combine(directory, FString::Printf(TEXT("%s.history"), *name));
+
+		// if there is already a file with the same name add an suffix to name
+		int32 suffix = 1;
+		while (PlatformFile.FileExists(*this->m_FileName) == true)
+		{
+			this->m_FileName = FPaths::Combine(directory, FString::Printf(TEXT("%s-%d.history"), *name, suffix++));
+		}
+
+		this->m_Writer = PlatformFile.OpenWrite(*this->m_FileName);
+		if (this->m_Writer == nullptr)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to open history archive '%s'!"), *this->m_FileName);
+			return;
+		}
+
+		const uint32 header[] { MAGIC, VERSION, this->m_ChunkLength, (uint32)this->m_Columns.Num() };
+
+		this->m_Writer->Write((const uint8*)header, sizeof(header));
+		this->m_Writer->Write((const uint8*)this->m_Columns.GetData(), this->m_Columns.Num() * sizeof(FColumn));
+
+		this->m_DataOffset = this->m_Writer->Tell();
+	}
+
+	FHistoryArchive::~FHistoryArchive()
+	{
+		if (this->m_Writer != nullptr)
+			Close();
+
+		ReleasePages();
+
+		// regions must be released before their file
+		this->m_TraceRegion.Reset();
+		this->m_MappedFile.Reset();
+
+		if (this->m_Reader != nullptr)
+		{
+			delete this->m_Reader;
+			this->m_Reader = nullptr;
+		}
+	}
+
+	void FHistoryArchive::AppendChunk(const uint8* data, uint32 numRows, uint64 firstFrame, uint64 lastFrame)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ArchiveHistoryChunk);
+
+		if (this->m_Writer == nullptr || numRows == 0)
+			return;
+
+		check(numRows <= this->m_ChunkLength);
+
+		const int64 offset = this->m_Writer->Tell();
+
+		if (this->m_Writer->Write(data, this->m_ChunkSize) == false)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to write history archive '%s', archiving stopped."), *this->m_FileName);
+
+			delete this->m_Writer;
+			this->m_Writer = nullptr;
+			return;
+		}
+
+		// the read cache opens its own handle, make the chunk visible to it
+		this->m_Writer->Flush();
+
+		this->m_ChunkIndex.Add({ offset, firstFrame, lastFrame, numRows });
+
+		// publish the chunk to readers once it is flushed
+		FPlatformAtomics::InterlockedExchange(&this->m_NumChunks, this->m_ChunkIndex.Num());
+	}
+
+	void FHistoryArchive::Close()
+	{
+		if (this->m_Writer == nullptr)
+			return;
+
+		// chunk index and footer
+		const int64 indexOffset = this->m_Writer->Tell();
+		const uint32 numChunks = (uint32)this->m_ChunkIndex.Num();
+		const uint32 magic = MAGIC;
+
+		this->m_Writer->Write((const uint8*)this->m_ChunkIndex.GetData(), this->m_ChunkIndex.Num() * sizeof(FChunkEntry));
+		this->m_Writer->Write((const uint8*)&numChunks, sizeof(numChunks));
+		this->m_Writer->Write((const uint8*)&indexOffset, sizeof(indexOffset));
+		this->m_Writer->Write((const uint8*)&magic, sizeof(magic));
+
+		delete this->m_Writer;
+		this->m_Writer = nullptr;
+
+		// pages read through the file handle are dropped, from now on chunks are mapped
+		ReleasePages();
+
+		if (this->m_Reader != nullptr)
+		{
+			delete this->m_Reader;
+			this->m_Reader = nullptr;
+		}
+
+		if (GetNumChunks() > 0)
+			this->m_MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*this->m_FileName));
+	}
+
+	const uint8* FHistoryArchive::PageIn(int32 chunk) const
+	{
+		if (chunk < 0 || chunk >= GetNumChunks())
+			return nullptr;
+
+		this->m_PageClock++;
+
+		// already resident?
+		for (FPage& page : this->m_Pages)
+		{
+			if (page.Chunk == chunk)
+			{
+				page.LastUse = this->m_PageClock;
+				return page.Region.IsValid() == true ? page.Region->GetMappedPtr() : page.Data.GetData();
+			}
+		}
+
+		// evict the least recently used page
+		FPage* page = nullptr;
+		if (this->m_Pages.Num() < MAX_RESIDENT_PAGES)
+		{
+			page = &this->m_Pages.AddDefaulted_GetRef();
+		}
+		else
+		{
+			page = &this->m_Pages[0];
+			for (FPage& other : this->m_Pages)
+			{
+				if (other.LastUse < page->LastUse)
+					page = &other;
+			}
+		}
+
+		page->Chunk = INDEX_NONE;
+		page->LastUse = this->m_PageClock;
+		page->Region.Reset();
+
+		// trace chunks are decoded into the archive's layout
+		if (this->m_Trace != nullptr)
+		{
+			FTraceChunk& traceChunk = this->m_TraceChunks[chunk];
+
+			if (traceChunk.State == ETraceChunkState::Unchecked)
+			{
+				FTraceReader::FChunk check;
+				FMemory::Memzero(check);
+
+				check.Payload = this->m_Trace + traceChunk.PayloadOffset;
+				check.PayloadSize = traceChunk.PayloadSize;
+				check.Checksum = traceChunk.Checksum;
+
+				traceChunk.State = FTraceReader::IsIntact(check) == true ? ETraceChunkState::Intact : ETraceChunkState::Damaged;
+
+				if (traceChunk.State == ETraceChunkState::Damaged)
+					UE_LOG(LogTemp, Warning, TEXT("Chunk %d of trace file '%s' is damaged, its samples are skipped!"), chunk, *this->m_FileName);
+			}
+
+			if (traceChunk.State == ETraceChunkState::Damaged)
+				return nullptr;
+
+			page->Data.SetNumUninitialized(this->m_ChunkSize, false);
+			DecodeTraceChunk(chunk, page->Data.GetData());
+
+			page->Chunk = chunk;
+			return page->Data.GetData();
+		}
+
+		const int64 offset = this->m_DataOffset + chunk * this->m_ChunkSize;
+
+		if (this->m_MappedFile.IsValid() == true)
+		{
+			page->Data.Empty();
+			page->Region.Reset(this->m_MappedFile->MapRegion(offset, this->m_ChunkSize));
+
+			if (page->Region.IsValid() == false)
+				return nullptr;
+
+			page->Chunk = chunk;
+			return page->Region->GetMappedPtr();
+		}
+
+		// still recording (or mapping not supported), read through a shared file handle
+		if (this->m_Reader == nullptr)
+			this->m_Reader = FPlatformFileManager::Get().GetPlatformFile().OpenRead(*this->m_FileName, true);
+
+		if (this->m_Reader == nullptr)
+			return nullptr;
+
+		page->Data.SetNumUninitialized(this->m_ChunkSize, false);
+
+		if (this->m_Reader->Seek(offset) == false || this->m_Reader->Read(page->Data.GetData(), this->m_ChunkSize) == false)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to read chunk %d of history archive '%s'!"), chunk, *this->m_FileName);
+			return nullptr;
+		}
+
+		page->Chunk = chunk;
+		return page->Data.GetData();
+	}
+
+	void FHistoryArchive::DecodeTraceChunk(int32 chunk, uint8* dest) const
+	{
+		SCOPE_CYCLE_COUNTER(STAT_DecodeTraceChunk);
+
+		const uint32 numRows = this->m_ChunkIndex[chunk].NumRows;
+		const uint8* source = this->m_Trace + this->m_ChunkIndex[chunk].Offset;
+
+		FMemory::Memcpy(dest + GetFramesOffset(), source, sizeof(uint64) * numRows);
+		source += sizeof(uint64) * numRows;
+
+		FMemory::Memcpy(dest + GetElapsedTimesOffset(), source, sizeof(double) * numRows);
+		source += sizeof(double) * numRows;
+
+		// columns added later in the recording are not part of earlier chunks
+		const int32 numColumns = (int32)this->m_TraceChunks[chunk].NumColumns;
+
+		for (int32 column = 0; column < this->m_Columns.Num(); ++column)
+		{
+			const uint32 type = this->m_Columns[column].Type;
+			const uint32 sampleSize = this->m_Columns[column].SampleSize;
+			const uint32 width = FTraceStream::GetNumComponents(type) * FTraceStream::GetComponentSize(type);
+
+			uint8* samples = dest + this->m_ColumnOffsets[column];
+
+			if (column >= numColumns)
+			{
+				for (uint32 row = 0; row < numRows; ++row)
+					WriteZeroSample(type, samples + row * sampleSize);
+
+				continue;
+			}
+
+			for (uint32 row = 0; row < numRows; ++row)
+				DecodeTraceSample(type, source + row * width, samples + row * sampleSize);
+
+			source += width * numRows;
+		}
+	}
+
+	void FHistoryArchive::ReleasePages() const
+	{
+		this->m_Pages.Empty();
+	}
+
+	TUniquePtr<FHistoryArchive> FHistoryArchive::OpenTrace(const FString& traceFileName, TArray<FTraceStream::FColumn>& outColumns)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+		FString fileName = traceFileName;
+
+		// only uncompressed traces can be mapped, a decompressed copy is reused as long as it is up to date
+		if (FTraceFileWriter::IsCompressedFile(traceFileName) == true)
+		{
+			fileName = FTraceFileWriter::GetUncompressedFileName(traceFileName);
+			if (fileName.Equals(traceFileName) == true)
+				fileName += TEXT(".trace");
+
+			if (PlatformFile.FileExists(*fileName) == false || PlatformFile.GetTimeStamp(*fileName) < PlatformFile.GetTimeStamp(*traceFileName))
+			{
+				if (FTraceFileWriter::DecompressFile(traceFileName, fileName) == false)
+					return nullptr;
+			}
+		}
+
+		TUniquePtr<IMappedFileHandle> mappedFile(PlatformFile.OpenMapped(*fileName));
+		TUniquePtr<IMappedFileRegion> region;
+		TArray<uint8> data;
+
+		if (mappedFile.IsValid() == true && mappedFile->GetFileSize() > 0)
+			region.Reset(mappedFile->MapRegion(0, mappedFile->GetFileSize()));
+
+		if (region.IsValid() == false)
+		{
+			mappedFile.Reset();
+
+			// mapping not supported, load the trace instead
+			if (FFileHelper::LoadFileToArray(data, *fileName) == false)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Failed to read trace file '%s'!"), *fileName);
+				return nullptr;
+			}
+		}
+
+		const uint8* trace = region.IsValid() == true ? region->GetMappedPtr() : data.GetData();
+		const int64 traceSize = region.IsValid() == true ? region->GetMappedSize() : data.Num();
+
+		// checksums are checked when a chunk is paged in, the whole trace is not read up front
+		FTraceReader reader(trace, traceSize, true);
+
+		if (reader.ReadHeader() == false)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("'%s' is not a trace file, has an unsupported version or a corrupt header!"), *fileName);
+			return nullptr;
+		}
+
+		const uint32 chunkLength = reader.GetChunkLength();
+
+		TArray<FChunkEntry> chunkIndex;
+		TArray<FTraceChunk> traceChunks;
+
+		// only the record headers and sizes are read, columns are decoded when their chunk is paged in
+		for (FTraceReader::ERecord record = reader.Next(); record != FTraceReader::End; record = reader.Next())
+		{
+			if (record != FTraceReader::Chunk)
+				continue;
+
+			const FTraceReader::FChunk& chunk = reader.GetChunk();
+
+			chunkIndex.Add({ chunk.Body - trace, chunk.FirstFrame, chunk.LastFrame, chunk.NumRows });
+			traceChunks.Add({ (uint32)reader.GetColumns().Num(), chunk.Payload - trace, chunk.PayloadSize, chunk.Checksum, ETraceChunkState::Unchecked });
+		}
+
+		if (chunkIndex.Num() == 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Trace file '%s' holds no samples!"), *fileName);
+			return nullptr;
+		}
+
+		if (reader.GetNumDamagedRecords() > 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Trace file '%s' is damaged, skipped %d damaged part(s) and imported the remaining %d chunks."), *fileName, reader.GetNumDamagedRecords(), reader.GetNumChunks());
+		}
+
+		outColumns = reader.GetColumns();
+
+		// the archive holds all columns the trace ever had
+		TArray<FColumn> columns;
+		for (const FTraceStream::FColumn& column : outColumns)
+			columns.Add({ column.Type, GetSampleSize(column.Type) });
+
+		TUniquePtr<FHistoryArchive> archive(new FHistoryArchive(chunkLength, columns));
+		archive->m_FileName = fileName;
+
+		archive->m_ChunkIndex = MoveTemp(chunkIndex);
+		archive->m_TraceChunks = MoveTemp(traceChunks);
+
+		archive->m_NumChunks = archive->m_ChunkIndex.Num();
+		archive->m_TraceColumns = outColumns;
+
+		archive->m_MappedFile = MoveTemp(mappedFile);
+		archive->m_TraceRegion = MoveTemp(region);
+		archive->m_TraceData = MoveTemp(data);
+		archive->m_Trace = archive->m_TraceRegion.IsValid() == true ? archive->m_TraceRegion->GetMappedPtr() : archive->m_TraceData.GetData();
+
+		return archive;
+	}
+
+	uint32 FHistoryArchive::GetSampleSize(uint32 type)
+	{
+		switch ((EDataSourceType)type)
+		{
+			case Bool:		return sizeof(bool);
+			case Int:		return sizeof(int32);
+			case Float:		return sizeof(float);
+			case Byte:		return sizeof(uint8);
+			case Vector:	return sizeof(FVector);
+			case Rotator:	return sizeof(FRotator);
+			case Transform:	return sizeof(FTransform);
+			default:		return 0;
+		}
+	}
+
+	uint64 FHistoryArchive::GetPhysicalMemorySize() const
+	{
+		// a mapped trace is paged by the OS, only a loaded one is resident
+		uint64 result = this->m_ChunkIndex.GetAllocatedSize() + this->m_TraceChunks.GetAllocatedSize() + this->m_TraceData.GetAllocatedSize();
+
+		for (const FPage& page : this->m_Pages)
+		{
+			result += page.Data.GetAllocatedSize();
+
+			if (page.Region.IsValid() == true)
+				result += page.Region->GetMappedSize();
+		}
+
+		return result;
+	}
+
+} // namespace StatsTracer
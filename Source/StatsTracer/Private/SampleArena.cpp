@@ -0,0 +1,129 @@
+///-------------------------------------------------------------------------------------------------
+/// File:	StatsTracer\Private\SampleArena.cpp
+///
+/// Summary:	Implements the sample arena class.
+///-------------------------------------------------------------------------------------------------
+
+#include "SampleArena.h"
+#include "StatsTracerPCH.h"
+
+#include "MemoryAccount.h"
+
+namespace StatsTracer {
+
+	// page data starts 16 byte aligned behind the header
+	static const SIZE_T PAGE_HEADER_SIZE { Align(sizeof(FSampleArena::FPage), 16) };
+
+	FSampleArena::FSampleArena() :
+		m_CurrentPage(nullptr),
+		m_AllocatedSize(0),
+		m_MemoryAccount(nullptr)
+	{}
+
+	FSampleArena::~FSampleArena()
+	{
+		// one free per page, no matter how many rings were carved from it
+		for (FPage* page : this->m_Pages)
+			FMemory::Free(page);
+
+		this->m_Pages.Empty();
+		this->m_CurrentPage = nullptr;
+
+		if (this->m_MemoryAccount != nullptr)
+			this->m_MemoryAccount->Adjust(-(int64)this->m_AllocatedSize, 0);
+	}
+
+	FSampleArena::FPage* FSampleArena::NewPage(SIZE_T dataSize)
+	{
+		FPage* page = (FPage*)FMemory::Malloc(PAGE_HEADER_SIZE + dataSize, 16);
+		page->Size = dataSize;
+		page->Used = 0;
+		page->NumLive = 0;
+
+		this->m_Pages.Add(page);
+		this->m_AllocatedSize += PAGE_HEADER_SIZE + dataSize;
+
+		if (this->m_MemoryAccount != nullptr)
+			this->m_MemoryAccount->Adjust((int64)(PAGE_HEADER_SIZE + dataSize), 0);
+
+		return page;
+	}
+
+	void FSampleArena::FreePage(FPage* page)
+	{
+		this->m_Pages.RemoveSingleSwap(page, false);
+		this->m_AllocatedSize -= PAGE_HEADER_SIZE + page->Size;
+
+		if (this->m_MemoryAccount != nullptr)
+			this->m_MemoryAccount->Adjust(-(int64)(PAGE_HEADER_SIZE + page->Size), 0);
+
+		FMemory::Free(page);
+	}
+
+	void* FSampleArena::Allocate(SIZE_T size, uint32 alignment, FPage*& outPage)
+	{
+		check(alignment <= 16);
+
+		FScopeLock lock(&this->m_Lock);
+
+		FPage* page = this->m_CurrentPage;
+
+		if (size > MAX_SHARED_ALLOCATION)
+		{
+			page = NewPage(size);
+		}
+		else if (page == nullptr || Align(page->Used, alignment) + size > page->Size)
+		{
+			// the retired page lives on until its last allocation is released
+			if (page != nullptr && page->NumLive == 0)
+				FreePage(page);
+
+			page = this->m_CurrentPage = NewPage(PAGE_SIZE);
+		}
+
+		const SIZE_T offset = Align(page->Used, alignment);
+
+		page->Used = offset + size;
+		page->NumLive++;
+
+		outPage = page;
+		return (uint8*)page + PAGE_HEADER_SIZE + offset;
+	}
+
+	void FSampleArena::Release(FPage* page)
+	{
+		FScopeLock lock(&this->m_Lock);
+
+		check(page->NumLive > 0);
+
+		// the current page keeps being bumped, it is reused from the start once it runs empty
+		if (--page->NumLive == 0)
+		{
+			if (page == this->m_CurrentPage)
+				page->Used = 0;
+			else
+				FreePage(page);
+		}
+	}
+
+	uint64 FSampleArena::GetAllocatedSize() const
+	{
+		FScopeLock lock(&const_cast<FSampleArena*>(this)->m_Lock);
+
+		return this->m_AllocatedSize;
+	}
+
+	void FSampleArena::BindMemoryAccount(FMemoryAccount* account)
+	{
+		FScopeLock lock(&this->m_Lock);
+
+		if (this->m_MemoryAccount != nullptr)
+			this->m_MemoryAccount->Adjust(-(int64)this->m_AllocatedSize, 0);
+
+		this->m_MemoryAccount = account;
+
+		if (this->m_MemoryAccount != nullptr)
+			this->m_MemoryAccount->Adjust((int64)this->m_AllocatedSize, 0);
+	}
+
+} // namespace StatsTracer
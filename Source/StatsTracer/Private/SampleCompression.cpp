@@ -0,0 +1,67 @@
+///-------------------------------------------------------------------------------------------------
+/// File:	StatsTracer\Private\SampleCompression.cpp
+///
+/// Summary:	Implements the sample history compression.
+///-------------------------------------------------------------------------------------------------
+
+#include "SampleCompression.h"
+#include "StatsTracerPCH.h"
+
+namespace StatsTracer {
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	FCompressedTimeline
+	///-------------------------------------------------------------------------------------------------
+
+	FCompressedTimeline::FCompressedTimeline() :
+		m_NumEntries(0)
+	{}
+
+	void FCompressedTimeline::DecodeChunk(int32 chunk, uint64* outFrames, double* outElapsedTimes) const
+	{
+		FSampleBitReader reader(this->m_Words.GetData() + this->m_ChunkOffsets[chunk]);
+		FDeltaOfDeltaCodec frameCodec;
+		FXorCodec timeCodec;
+
+		const int32 count = GetChunkEntryCount(chunk);
+		for (int32 i = 0; i < count; ++i)
+		{
+			outFrames[i] = frameCodec.Decode(reader);
+
+			const uint64 timeBits = timeCodec.Decode(reader, 64);
+			FMemory::Memcpy(&outElapsedTimes[i], &timeBits, sizeof(double));
+		}
+	}
+
+	FCompressedTimeline::FEncoder::FEncoder(FCompressedTimeline& timeline) :
+		m_Timeline(timeline),
+		m_Writer(timeline.m_Words)
+	{}
+
+	FCompressedTimeline::FEncoder::~FEncoder()
+	{
+		this->m_Timeline.m_Words.Shrink();
+		this->m_Timeline.m_ChunkOffsets.Shrink();
+	}
+
+	void FCompressedTimeline::FEncoder::Add(uint64 frame, double elapsedTime)
+	{
+		if ((this->m_Timeline.m_NumEntries & (SAMPLE_CHUNK_SIZE - 1)) == 0)
+		{
+			this->m_Writer.Align();
+			this->m_Timeline.m_ChunkOffsets.Add(this->m_Timeline.m_Words.Num());
+
+			this->m_FrameCodec = FDeltaOfDeltaCodec();
+			this->m_TimeCodec = FXorCodec();
+		}
+
+		uint64 timeBits;
+		FMemory::Memcpy(&timeBits, &elapsedTime, sizeof(double));
+
+		this->m_FrameCodec.Encode(this->m_Writer, frame);
+		this->m_TimeCodec.Encode(this->m_Writer, timeBits, 64);
+
+		this->m_Timeline.m_NumEntries++;
+	}
+
+} // namespace StatsTracer
@@ -0,0 +1,446 @@
+///-------------------------------------------------------------------------------------------------
+/// File:	StatsTracer\Private\SessionContainer.cpp
+///
+/// Summary:	Implements the session container file and the trace output class.
+///-------------------------------------------------------------------------------------------------
+
+#include "SessionContainer.h"
+#include "StatsTracerPCH.h"
+
+#include "HAL/PlatformFilemanager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+
+namespace StatsTracer {
+
+	/*
+		File layout:
+
+			header		MAGIC, VERSION
+			records		STREAM_MAGIC, stream id, name length, UTF-8 name		declares a stream
+						BLOCK_MAGIC, stream id, size, data						a block of a stream's output
+			index		INDEX_MAGIC, number of streams,
+						per stream { name length, UTF-8 name, number of blocks, { offset (uint64), size } per block }
+			trailer		index offset (uint64), MAGIC, written by Close()
+	*/
+
+	static const int64 TRAILER_SIZE = sizeof(uint64) + sizeof(uint32);
+
+	/// Summary:	Reads a length prefixed UTF-8 name.
+	static bool ReadName(IFileHandle& file, FString& outName)
+	{
+		uint32 length = 0;
+		if (file.Read((uint8*)&length, sizeof(uint32)) == false || length > 4096)
+			return false;
+
+		TArray<ANSICHAR> name;
+		name.SetNumUninitialized(length);
+
+		if (file.Read((uint8*)name.GetData(), length) == false)
+			return false;
+
+		FUTF8ToTCHAR converted(name.GetData(), length);
+		outName = FString(converted.Length(), converted.Get());
+		return true;
+	}
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	FSessionContainer
+	///-------------------------------------------------------------------------------------------------
+
+	FSessionContainer::FSessionContainer(const FString& sessionName) :
+		m_Offset(0),
+		m_File(nullptr)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+		const FString fileDir = FPaths::Combine(UStatsTracerEditorSettings::GetInstance()->CsvOutputDir.Path, sessionName);
+
+		if (PlatformFile.CreateDirectoryTree(*fileDir) == false)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Unable to access session container directory '%s'!"), *fileDir);
+			return;
+		}
+
+		this->m_FileName = FPaths::Combine(fileDir, TEXT("Session.container"));
+
+		this->m_File = FTraceFileWriter::Get().Open(this->m_FileName);
+		if (this->m_File.IsValid() == false)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to open session container '%s'!"), *this->m_FileName);
+			return;
+		}
+
+		// compression appends its extension
+		this->m_FileName = this->m_File->GetFileName();
+
+		const uint32 header[] { MAGIC, VERSION };
+		Write(header, sizeof(header));
+	}
+
+	FSessionContainer::~FSessionContainer()
+	{
+		Close();
+	}
+
+	void FSessionContainer::Write(const void* data, uint32 size)
+	{
+		FTraceFileWriter::Get().Write(*this->m_File, data, size);
+		this->m_Offset += size;
+	}
+
+	int32 FSessionContainer::AddStream(const FString& name)
+	{
+		FScopeLock lock(&this->m_Lock);
+
+		// a repository started twice gets a second stream, keep the extracted file names apart
+		FString uniqueName = name;
+
+		int32 suffix = 1;
+		while (this->m_Streams.ContainsByPredicate([&uniqueName](const FStream& stream) { return stream.Name == uniqueName; }) == true)
+		{
+			uniqueName = FString::Printf(TEXT("%s-%d.%s"), *FPaths::GetBaseFilename(name), suffix++, *FPaths::GetExtension(name));
+		}
+
+		const int32 streamId = this->m_Streams.Num();
+		this->m_Streams.AddDefaulted_GetRef().Name = uniqueName;
+
+		if (IsValid() == true)
+		{
+			FTCHARToUTF8 utf8(*uniqueName);
+
+			const uint32 record[] { STREAM_MAGIC, (uint32)streamId, (uint32)utf8.Length() };
+			Write(record, sizeof(record));
+			Write(utf8.Get(), utf8.Length());
+		}
+
+		return streamId;
+	}
+
+	void FSessionContainer::WriteBlock(int32 streamId, const void* data, int32 size)
+	{
+		FScopeLock lock(&this->m_Lock);
+
+		if (IsValid() == false || this->m_Streams.IsValidIndex(streamId) == false || size <= 0)
+			return;
+
+		const uint32 record[] { BLOCK_MAGIC, (uint32)streamId, (uint32)size };
+		Write(record, sizeof(record));
+
+		this->m_Streams[streamId].Blocks.Add({ this->m_Offset, (uint32)size });
+		Write(data, size);
+	}
+
+	void FSessionContainer::HandOff()
+	{
+		FScopeLock lock(&this->m_Lock);
+
+		if (this->m_File.IsValid() == true)
+			FTraceFileWriter::Get().HandOff(*this->m_File);
+	}
+
+	void FSessionContainer::Close()
+	{
+		FScopeLock lock(&this->m_Lock);
+
+		if (this->m_File.IsValid() == false)
+			return;
+
+		const uint64 indexOffset = this->m_Offset;
+
+		const uint32 index[] { INDEX_MAGIC, (uint32)this->m_Streams.Num() };
+		Write(index, sizeof(index));
+
+		for (const FStream& stream : this->m_Streams)
+		{
+			FTCHARToUTF8 utf8(*stream.Name);
+
+			const uint32 length = (uint32)utf8.Length();
+			Write(&length, sizeof(uint32));
+			Write(utf8.Get(), length);
+
+			const uint32 numBlocks = (uint32)stream.Blocks.Num();
+			Write(&numBlocks, sizeof(uint32));
+
+			for (const FBlock& block : stream.Blocks)
+			{
+				Write(&block.Offset, sizeof(uint64));
+				Write(&block.Size, sizeof(uint32));
+			}
+		}
+
+		const uint32 magic = MAGIC;
+		Write(&indexOffset, sizeof(uint64));
+		Write(&magic, sizeof(uint32));
+
+		FTraceFileWriter::Get().Close(this->m_File);
+		this->m_File.Reset();
+	}
+
+	bool FSessionContainer::Extract(const FString& containerFileName, const FString& outputDir, const FString& streamName)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+		// blocks are located by their uncompressed offsets, decompress into a temporary file first
+		if (FTraceFileWriter::IsCompressedFile(containerFileName) == true)
+		{
+			const FString fileDir = FPaths::GetPath(containerFileName);
+			const FString tempFileName = FPaths::CreateTempFilename(*fileDir, TEXT("Session"), TEXT(".container"));
+
+			bool extracted = FTraceFileWriter::DecompressFile(containerFileName, tempFileName) == true && Extract(tempFileName, outputDir.IsEmpty() == true ? fileDir : outputDir, streamName) == true;
+
+			PlatformFile.DeleteFile(*tempFileName);
+			return extracted;
+		}
+
+		TUniquePtr<IFileHandle> file(PlatformFile.OpenRead(*containerFileName));
+		if (file.IsValid() == false)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to read session container '%s'!"), *containerFileName);
+			return false;
+		}
+
+		const int64 fileSize = file->Size();
+
+		uint32 header[2];
+		if (file->Read((uint8*)header, sizeof(header)) == false || header[0] != MAGIC || header[1] != VERSION)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("'%s' is not a session container or has an unsupported version!"), *containerFileName);
+			return false;
+		}
+
+		TArray<FStream> streams;
+
+		// the trailer points to the index
+		bool hasIndex = false;
+		{
+			uint64 indexOffset = 0;
+			uint32 magic = 0;
+
+			if (fileSize >= (int64)sizeof(header) + TRAILER_SIZE &&
+				file->Seek(fileSize - TRAILER_SIZE) == true &&
+				file->Read((uint8*)&indexOffset, sizeof(uint64)) == true &&
+				file->Read((uint8*)&magic, sizeof(uint32)) == true &&
+				magic == MAGIC && indexOffset >= sizeof(header) && (int64)indexOffset < fileSize - TRAILER_SIZE &&
+				file->Seek(indexOffset) == true)
+			{
+				uint32 index[2];
+				hasIndex = file->Read((uint8*)index, sizeof(index)) == true && index[0] == INDEX_MAGIC;
+
+				for (uint32 i = 0; hasIndex == true && i < index[1]; ++i)
+				{
+					FStream& stream = streams.AddDefaulted_GetRef();
+
+					uint32 numBlocks = 0;
+					hasIndex = ReadName(*file, stream.Name) == true && file->Read((uint8*)&numBlocks, sizeof(uint32)) == true;
+
+					for (uint32 b = 0; hasIndex == true && b < numBlocks; ++b)
+					{
+						FBlock block;
+						hasIndex = file->Read((uint8*)&block.Offset, sizeof(uint64)) == true && file->Read((uint8*)&block.Size, sizeof(uint32)) == true && block.Offset + block.Size <= indexOffset;
+
+						stream.Blocks.Add(block);
+					}
+				}
+			}
+		}
+
+		// no (valid) index, the container was not closed; collect the blocks one by one
+		if (hasIndex == false)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Session container '%s' has no index, extracting what was written."), *containerFileName);
+
+			streams.Reset();
+			file->Seek(sizeof(header));
+
+			uint32 record[2];
+			while (file->Read((uint8*)record, sizeof(record)) == true)
+			{
+				const uint32 streamId = record[1];
+
+				if (record[0] == STREAM_MAGIC)
+				{
+					FString name;
+					if (ReadName(*file, name) == false)
+						break;
+
+					if ((int32)streamId >= streams.Num())
+						streams.SetNum(streamId + 1);
+
+					streams[streamId].Name = name;
+				}
+				else if (record[0] == BLOCK_MAGIC)
+				{
+					uint32 size = 0;
+					if (file->Read((uint8*)&size, sizeof(uint32)) == false)
+						break;
+
+					const int64 offset = file->Tell();
+					if (offset + size > fileSize || streams.IsValidIndex(streamId) == false)
+						break;
+
+					streams[streamId].Blocks.Add({ (uint64)offset, size });
+					file->Seek(offset + size);
+				}
+				else
+				{
+					// index or corrupt record
+					break;
+				}
+			}
+		}
+
+		const FString fileDir = outputDir.IsEmpty() == true ? FPaths::GetPath(containerFileName) : outputDir;
+		PlatformFile.CreateDirectoryTree(*fileDir);
+
+		bool extractedAny = false;
+		TArray<uint8> buffer;
+
+		for (const FStream& stream : streams)
+		{
+			if (stream.Name.IsEmpty() == true || (streamName.IsEmpty() == false && stream.Name != streamName))
+				continue;
+
+			const FString fileName = FPaths::Combine(fileDir, stream.Name);
+
+			TUniquePtr<IFileHandle> output(PlatformFile.OpenWrite(*fileName));
+			if (output.IsValid() == false)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Failed to open '%s'!"), *fileName);
+				return false;
+			}
+
+			for (const FBlock& block : stream.Blocks)
+			{
+				buffer.SetNumUninitialized(block.Size, false);
+
+				if (file->Seek(block.Offset) == false || file->Read(buffer.GetData(), block.Size) == false || output->Write(buffer.GetData(), block.Size) == false)
+				{
+					UE_LOG(LogTemp, Warning, TEXT("Failed to extract '%s' from session container '%s'!"), *stream.Name, *containerFileName);
+					return false;
+				}
+			}
+
+			extractedAny = true;
+		}
+
+		if (extractedAny == false && streamName.IsEmpty() == false)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Session container '%s' has no stream '%s'!"), *containerFileName, *streamName);
+			return false;
+		}
+
+		return true;
+	}
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	FTraceOutput
+	///-------------------------------------------------------------------------------------------------
+
+	FTraceOutput::FTraceOutput() :
+		m_File(nullptr),
+		m_Container(nullptr),
+		m_StreamId(INDEX_NONE),
+		m_FlushInterval(1.0),
+		m_NextHandOffTime(0.0)
+	{}
+
+	void FTraceOutput::ScheduleHandOff()
+	{
+		this->m_NextHandOffTime = FPlatformTime::Seconds() + this->m_FlushInterval;
+	}
+
+	bool FTraceOutput::OpenFile(const FString& fileName)
+	{
+		this->m_File = FTraceFileWriter::Get().Open(fileName);
+		if (this->m_File.IsValid() == false)
+			return false;
+
+		this->m_Name = this->m_File->GetFileName();
+		this->m_FlushInterval = FMath::Max(0.01f, UStatsTracerEditorSettings::GetInstance()->TraceWriterFlushInterval);
+
+		ScheduleHandOff();
+		return true;
+	}
+
+	bool FTraceOutput::OpenStream(const FSessionContainerHandle& container, const FString& name)
+	{
+		if (container.IsValid() == false || container->IsValid() == false)
+			return false;
+
+		this->m_Name = name;
+		this->m_Container = container;
+		this->m_StreamId = container->AddStream(name);
+		this->m_Staged.Reserve(FSessionContainer::BLOCK_SIZE);
+		this->m_FlushInterval = FMath::Max(0.01f, UStatsTracerEditorSettings::GetInstance()->TraceWriterFlushInterval);
+
+		ScheduleHandOff();
+		return true;
+	}
+
+	void FTraceOutput::Write(const void* data, int64 size)
+	{
+		if (this->m_File.IsValid() == true)
+		{
+			FTraceFileWriter::Get().Write(*this->m_File, data, size);
+		}
+		else if (this->m_Container.IsValid() == true)
+		{
+			this->m_Staged.Append((const uint8*)data, size);
+
+			if (this->m_Staged.Num() >= FSessionContainer::BLOCK_SIZE)
+			{
+				this->m_Container->WriteBlock(this->m_StreamId, this->m_Staged.GetData(), this->m_Staged.Num());
+				this->m_Staged.Reset();
+			}
+		}
+	}
+
+	void FTraceOutput::HandOff()
+	{
+		if (this->m_Container.IsValid() == true)
+		{
+			if (this->m_Staged.Num() > 0)
+			{
+				this->m_Container->WriteBlock(this->m_StreamId, this->m_Staged.GetData(), this->m_Staged.Num());
+				this->m_Staged.Reset();
+			}
+
+			this->m_Container->HandOff();
+		}
+		else if (this->m_File.IsValid() == true)
+		{
+			FTraceFileWriter::Get().HandOff(*this->m_File);
+		}
+
+		ScheduleHandOff();
+	}
+
+	void FTraceOutput::Close()
+	{
+		if (this->m_Container.IsValid() == true)
+		{
+			this->m_Container->WriteBlock(this->m_StreamId, this->m_Staged.GetData(), this->m_Staged.Num());
+
+			this->m_Staged.Empty();
+			this->m_Container.Reset();
+		}
+
+		if (this->m_File.IsValid() == true)
+		{
+			FTraceFileWriter::Get().Close(this->m_File);
+			this->m_File.Reset();
+		}
+	}
+
+	bool FTraceOutput::IsValid() const
+	{
+		if (this->m_File.IsValid() == true)
+			return this->m_File->IsValid();
+
+		if (this->m_Container.IsValid() == true)
+			return this->m_Container->IsValid();
+
+		return false;
+	}
+
+} // namespace StatsTracer
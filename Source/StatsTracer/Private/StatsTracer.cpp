@@ -17,6 +17,7 @@
 #include "ISettingsModule.h"
 #include "ISettingsSection.h"
 #include "ISettingsContainer.h"
+#include "Misc/CoreDelegates.h"
 
 #define LOCTEXT_NAMESPACE "FStatsTracerModule"
 
@@ -25,6 +26,8 @@ void FStatsTracerModule::StartupModule()
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
 	
 	RegisterSettings();
+
+	SystemErrorHandle = FCoreDelegates::OnHandleSystemError.AddRaw(this, &FStatsTracerModule::OnSystemError);
 }
 
 void FStatsTracerModule::ShutdownModule()
@@ -32,9 +35,20 @@ void FStatsTracerModule::ShutdownModule()
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
 	
+	FCoreDelegates::OnHandleSystemError.Remove(SystemErrorHandle);
+
+	// write what is still pending and stop the file writer thread
+	StatsTracer::FTraceFileWriter::Shutdown();
+
 	UnregisterSettings();
 }
 
+void FStatsTracerModule::OnSystemError()
+{
+	// the streams may be in use by the crashed thread, only the blocks already handed to the file writer are written
+	StatsTracer::FTraceFileWriter::Flush();
+}
+
 void FStatsTracerModule::RegisterSettings()
 {
 	ISettingsModule* settingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings");
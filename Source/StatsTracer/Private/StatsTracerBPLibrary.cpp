@@ -44,3 +44,23 @@ UTracer* UStatsTracerBPLibrary::CreateStatsTracer(
 	return tracerObject;
 	// ... End critical section
 }
+
+bool UStatsTracerBPLibrary::ConvertTraceToCsv(const FString& traceFileName, const FString& csvFileName)
+{
+	return StatsTracer::FTraceStream::ConvertToCsv(traceFileName, csvFileName);
+}
+
+bool UStatsTracerBPLibrary::ExtractSessionContainer(const FString& containerFileName, const FString& outputDir, const FString& streamName)
+{
+	return StatsTracer::FSessionContainer::Extract(containerFileName, outputDir, streamName);
+}
+
+bool UStatsTracerBPLibrary::DecompressTraceFile(const FString& compressedFileName, const FString& fileName)
+{
+	return StatsTracer::FTraceFileWriter::DecompressFile(compressedFileName, fileName);
+}
+
+bool UStatsTracerBPLibrary::ImportTracerSession(const FString& path)
+{
+	return StatsTracer::TDRM->ImportSession(path).IsValid();
+}
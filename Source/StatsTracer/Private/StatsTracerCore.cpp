@@ -14,6 +14,8 @@
 #include "StatsTracerCore.h"
 #include "StatsTracerPCH.h"
 
+#include "Async/ParallelFor.h"
+
 namespace StatsTracer {
 
 
@@ -28,16 +30,188 @@ namespace StatsTracer {
 	const FRotator ZeroSample<FRotator>::Value { FRotator(0.0f) }; 
 	const FTransform ZeroSample<FTransform>::Value { FTransform::Identity }; 
 
+	///-------------------------------------------------------------------------------------------------
+	/// Struct:	FTracerSampleRate
+	///-------------------------------------------------------------------------------------------------
+
+	FTracerSampleRate FTracerSampleRate::GetDefault()
+	{
+		const UStatsTracerEditorSettings* settings = UStatsTracerEditorSettings::GetInstance();
 
+		if (settings->SampleClock == ETracerSampleClock::Frames)
+			return FTracerSampleRate(ETracerSampleClock::Frames, (float)settings->UpdateFrequency);
 
-	IDataSample::IDataSample() :
-		Frame(0),
-		ElapsedTime(0.0f)
-	{}
+		return FTracerSampleRate(settings->SampleClock, settings->SampleRate);
+	}
+
+	bool FTracerSampleRate::GetStride(const FTracerSampleRate& other, uint32& outStride) const
+	{
+		outStride = 1;
+
+		if (other.IsSet() == false || IsSet() == false)
+			return true;
+
+		if (other.Clock != this->Clock)
+			return false;
+
+		// frames count the interval, time based clocks the frequency
+		const float ratio = IsTimeBased() == true ? this->Value / other.Value : other.Value / this->Value;
+
+		outStride = (uint32)FMath::Max(1, FMath::RoundToInt(ratio));
+		return true;
+	}
+
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	FTracerTimeline
+	///-------------------------------------------------------------------------------------------------
+
+	FTracerTimeline::FTracerTimeline(uint32 windowSize, const FSampleArenaHandle& arena) :
+		m_WindowSize(FMath::RoundUpToPowerOfTwo(windowSize + 1) / 2), // rounded down, never more than asked for
+		m_IndexMask(m_WindowSize - 1),
+		m_Sequence(0),
+		m_IsCompressed(false),
+		m_DecodedChunk(INDEX_NONE),
+		m_HistoryArchive(nullptr),
+		m_HistoryPage(INDEX_NONE),
+		m_PagedChunkCount(0),
+		m_PagedCount(0),
+		m_PageGeneration(1),
+		m_PagedGeneration(0)
+	{
+		this->m_Frames.BindArena(arena);
+		this->m_ElapsedTimes.BindArena(arena);
 
-	IDataSample::~IDataSample()
+		this->m_Frames.SetNumZeroed(this->m_WindowSize);
+		this->m_ElapsedTimes.SetNumZeroed(this->m_WindowSize);
+	}
+
+	FTracerTimeline::~FTracerTimeline()
 	{}
 
+	void FTracerTimeline::DecodeChunk(int32 chunk) const
+	{
+		if (this->m_DecodedChunk == chunk)
+			return;
+
+		this->m_DecodedFrames.SetNumUninitialized(SAMPLE_CHUNK_SIZE, false);
+		this->m_DecodedElapsedTimes.SetNumUninitialized(SAMPLE_CHUNK_SIZE, false);
+
+		this->m_Compressed->DecodeChunk(chunk, this->m_DecodedFrames.GetData(), this->m_DecodedElapsedTimes.GetData());
+		this->m_DecodedChunk = chunk;
+	}
+
+	void FTracerTimeline::PageInHistory() const
+	{
+		if (this->m_PagedGeneration == this->m_PageGeneration || IsPaged() == false)
+			return;
+
+		SCOPE_CYCLE_COUNTER(STAT_PageInHistory);
+
+		this->m_PagedFrames.SetNumZeroed(GetPagedCount(), false);
+		this->m_PagedElapsedTimes.SetNumZeroed(GetPagedCount(), false);
+
+		uint32 index = 0;
+
+		for (int32 i = 0; i < GetPagedChunkCount(); ++i)
+		{
+			const uint32 numRows = this->m_HistoryArchive->GetChunkRows(this->m_HistoryPage + i);
+
+			const uint8* chunk = this->m_HistoryArchive->PageIn(this->m_HistoryPage + i);
+			if (chunk != nullptr)
+			{
+				FMemory::Memcpy(this->m_PagedFrames.GetData() + index, chunk + this->m_HistoryArchive->GetFramesOffset(), sizeof(uint64) * numRows);
+				FMemory::Memcpy(this->m_PagedElapsedTimes.GetData() + index, chunk + this->m_HistoryArchive->GetElapsedTimesOffset(), sizeof(double) * numRows);
+			}
+
+			index += numRows;
+		}
+
+		this->m_PagedGeneration = this->m_PageGeneration;
+	}
+
+	void FTracerTimeline::SetHistoryPage(int32 chunk)
+	{
+		if (this->m_HistoryArchive == nullptr || this->m_HistoryArchive->GetNumChunks() == 0)
+			chunk = INDEX_NONE;
+		else if (chunk != INDEX_NONE)
+			chunk = FMath::Clamp<int32>(chunk, 0, this->m_HistoryArchive->GetNumChunks() - 1);
+
+		if (chunk == this->m_HistoryPage)
+			return;
+
+		this->m_HistoryPage = chunk;
+		this->m_PagedChunkCount = chunk != INDEX_NONE ? FMath::Min<int32>(GetChunksPerPage(), this->m_HistoryArchive->GetNumChunks() - chunk) : 0;
+		this->m_PagedCount = 0;
+
+		for (int32 i = 0; i < this->m_PagedChunkCount; ++i)
+			this->m_PagedCount += this->m_HistoryArchive->GetChunkRows(chunk + i);
+
+		this->m_PageGeneration++;
+
+		this->m_PagedFrames.Empty();
+		this->m_PagedElapsedTimes.Empty();
+		this->m_PagedGeneration = 0;
+	}
+
+	void FTracerTimeline::EncodeHistory()
+	{
+		if (this->m_IsCompressed == true || this->m_Compressed.IsValid() == true)
+			return;
+
+		TUniquePtr<FCompressedTimeline> compressed = MakeUnique<FCompressedTimeline>();
+		{
+			FCompressedTimeline::FEncoder encoder(*compressed);
+
+			for (uint64 sequence = this->m_Sequence - GetCount(); sequence < this->m_Sequence; ++sequence)
+			{
+				const uint32 index = (uint32)(sequence & this->m_IndexMask);
+				encoder.Add(this->m_Frames[index], this->m_ElapsedTimes[index]);
+			}
+		}
+
+		this->m_Compressed = MoveTemp(compressed);
+	}
+
+	void FTracerTimeline::ApplyEncodedHistory()
+	{
+		if (this->m_IsCompressed == true || this->m_Compressed.IsValid() == false)
+			return;
+
+		this->m_Frames.Empty();
+		this->m_ElapsedTimes.Empty();
+
+		this->m_DecodedChunk = INDEX_NONE;
+		this->m_IsCompressed = true;
+	}
+
+	void FTracerTimeline::ReleaseDecodedHistory()
+	{
+		this->m_DecodedFrames.Empty();
+		this->m_DecodedElapsedTimes.Empty();
+		this->m_DecodedChunk = INDEX_NONE;
+
+		this->m_PagedFrames.Empty();
+		this->m_PagedElapsedTimes.Empty();
+		this->m_PagedGeneration = 0;
+
+		if (this->m_HistoryArchive != nullptr)
+			this->m_HistoryArchive->ReleasePages();
+	}
+
+	uint64 FTracerTimeline::GetPhysicalMemorySize() const
+	{
+		uint64 result = this->m_PagedFrames.GetAllocatedSize() + this->m_PagedElapsedTimes.GetAllocatedSize();
+
+		if (this->m_HistoryArchive != nullptr)
+			result += this->m_HistoryArchive->GetPhysicalMemorySize();
+
+		if (this->m_IsCompressed == true)
+			return result + this->m_Compressed->GetPhysicalMemorySize() + this->m_DecodedFrames.GetAllocatedSize() + this->m_DecodedElapsedTimes.GetAllocatedSize();
+
+		// rings allocated from the session's arena are accounted by the arena
+		return result + this->m_Frames.GetHeapAllocatedSize() + this->m_ElapsedTimes.GetHeapAllocatedSize();
+	}
 
 	///-------------------------------------------------------------------------------------------------
 	/// Class:	IDataSource
@@ -53,7 +227,10 @@ namespace StatsTracer {
 		m_Group(group),
 		m_Description(FText::FromString(description)),
 		m_Color(color),
-		m_StreamToCsv(streamToCsv)
+		m_StreamToCsv(streamToCsv),
+		m_Timeline(nullptr),
+		m_ArchiveColumn(INDEX_NONE),
+		m_MemoryAccount(nullptr)
 	{}
 
 	IDataSource::~IDataSource()
@@ -61,488 +238,1896 @@ namespace StatsTracer {
 
 
 	///-------------------------------------------------------------------------------------------------
-	/// Class:	FTracerDataRepository
+	/// Class:	FDataSourceSamplingPlan
 	///-------------------------------------------------------------------------------------------------
 
-	FTracerDataRepository::FTracerDataRepository(const FString& name, const FString& repositoryDescription, AActor* tracedActor, TSharedPtr<FTracerSession> session, const bool streamToCsv, const bool autostart) :
-		m_RepositoryId(tracedActor->GetUniqueID()),
-		m_RepositoryName(name),
-		m_RepositoryDescription(FText::FromString(repositoryDescription)),
-		m_TracedActor(tracedActor),
-		m_TracedActorFName(tracedActor->GetFName()),
-		m_Session(session),
-		m_State(INITIALIZED),
-		m_StreamToCsv(streamToCsv),
-		m_AutoStartOnBeginPlay(autostart),
-		m_CSVStream(nullptr),
-		m_NextColorStartHue(0.0f)
-	{}
+	template<class T>
+	static FORCEINLINE void GatherSamples(const TArray<FDataSource<T>*>& dataSources, uint64 sequence)
+	{
+		FDataSource<T>* const* it = dataSources.GetData();
+		FDataSource<T>* const* end = it + dataSources.Num();
 
-	FTracerDataRepository::~FTracerDataRepository()
+		for (; it != end; ++it)
+			(*it)->Push(sequence);
+	}
+
+	template<class T>
+	static FORCEINLINE uint8* CaptureSamples(const TArray<FDataSource<T>*>& dataSources, uint8* row)
 	{
-		if (this->m_CSVStream != nullptr)
-		{
-			delete this->m_CSVStream;
-			this->m_CSVStream = nullptr;
-		}
+		FDataSource<T>* const* it = dataSources.GetData();
+		FDataSource<T>* const* end = it + dataSources.Num();
 
-		this->m_TracedActor = nullptr;
-		this->m_Session = nullptr;
-		this->m_DataGroups.Empty();
+		for (; it != end; ++it, row += sizeof(T))
+			(*it)->Capture(row);
+
+		return row;
 	}
 
-	void FTracerDataRepository::AddDataSource(IDataSource* dataSourcePtr)
+	template<class T>
+	static FORCEINLINE const uint8* ApplySamples(const TArray<FDataSource<T>*>& dataSources, const uint8* row, uint64 sequence)
 	{
-		SCOPE_CYCLE_COUNTER(STAT_AddDatasource);
+		FDataSource<T>* const* it = dataSources.GetData();
+		FDataSource<T>* const* end = it + dataSources.Num();
 
-		if (this->m_State > INITIALIZED)
+		T value;
+		for (; it != end; ++it, row += sizeof(T))
 		{
-			UE_LOG(LogTemp, Warning, TEXT("Tracer data-repository is already active, no more data-sources can be added."));
-			return;
+			FMemory::Memcpy(&value, row, sizeof(T));
+			(*it)->PushValue(value, sequence);
 		}
 
-		/* DO NOT TRACE THE SAME STAT TWICE! */
-		for (auto GROUP : this->m_DataGroups)
-		{
-			for (auto SOURCE : GROUP.Value)
-			{
-				if (dataSourcePtr->GetRawDataPtr() == SOURCE->GetRawDataPtr())
-				{
-					UE_LOG(LogTemp, Warning, TEXT("DataSources '%s' and '%s' are tracing the same stat. Ignoring duplicate data source."), *SOURCE->GetName(), *dataSourcePtr->GetName());
-					return;
-				}
-			}
-		}
+		return row;
+	}
 
-		// create smart pointer for memory management
-		TDataSourceHandle dataSource { dataSourcePtr };
+	template<class T>
+	static FORCEINLINE void StreamSnapshotValue(CSVStream& stream, const uint8* data)
+	{
+		T value;
+		FMemory::Memcpy(&value, data, sizeof(T));
 
-		// If check if there is still enough memory to store this datasource
-		{
-			uint32 dataSourceTotalMemorySize = dataSource->GetDataSourcePhysicalMemorySize();
-			if (StatsTracer::TDRM->GetAvailablePhysicalMemory() < dataSourceTotalMemorySize)
-			{
-				UE_LOG(LogTemp, Warning, TEXT("StatsTracer plugin reached memory limitation. '%s' stat will not be traced."), *dataSource->GetName());
-				StatsTracer::TDRM->ConsumePhysicalMemory(0);
-				return;
-			}
-			else
-			{
-				StatsTracer::TDRM->ConsumePhysicalMemory(dataSourceTotalMemorySize);
-			}
-		}
+		stream << value;
+	}
 
+	FDataSourceSamplingPlan::FDataSourceSamplingPlan() :
+		m_NumDataSources(0),
+		m_SnapshotSize(0),
+		m_IsCompiled(false)
+	{}
 
-		FString group = dataSource->GetGroup();
-		group = group.TrimStartAndEnd().Equals("") == true ? FString("Default") : dataSource->GetGroup();
+	FDataSourceSamplingPlan::~FDataSourceSamplingPlan()
+	{
+		Reset();
+	}
 
-		TArray<TDataSourceHandle>* dataSourceGroup = this->m_DataGroups.Find(*group);
-		if(dataSourceGroup != nullptr)
+	void FDataSourceSamplingPlan::Compile(const TDataGroupMap& dataGroups)
+	{
+		Reset();
+
+		for (auto& dataGroup : dataGroups)
 		{
-			// duplicate check
-			bool result = dataSourceGroup->ContainsByPredicate([&](TDataSourceHandle& other) { return dataSource->GetName().Equals(other->GetName()); });
-			if (result == false)
+			for (const TDataSourceHandle& dataSource : dataGroup.Value)
 			{
-				dataSourceGroup->Add(dataSource);
-			}
-			else
-			{
-				UE_LOG(LogTemp, Warning, TEXT("DataSource \'%s\' already exists in group \'%s\'. DataSource will be ignored."), *dataSource->GetName(), *group);
+				if (dataSource.IsValid() == false)
+					continue;
+
+				AddToBucket(dataSource.Get());
 			}
 		}
-		// group does not exist yet, create it.
-		else
+
+		Layout();
+
+		this->m_IsCompiled = true;
+	}
+
+	void FDataSourceSamplingPlan::Append(IDataSource* dataSource)
+	{
+		check(this->m_IsCompiled == true);
+
+		if (AddToBucket(dataSource) == true)
+			Layout();
+	}
+
+	bool FDataSourceSamplingPlan::AddToBucket(IDataSource* dataSource)
+	{
+		int32 bucketIndex = 0;
+
+		switch (dataSource->GetDataSourceType())
 		{
-			this->m_DataGroups.Add(group).Add(dataSource);
+			case Bool:		bucketIndex = this->m_BoolSources.Add(dataSource->GetAs<FDataSource<bool>>()); break;
+			case Int:		bucketIndex = this->m_IntSources.Add(dataSource->GetAs<FDataSource<int32>>()); break;
+			case Float:		bucketIndex = this->m_FloatSources.Add(dataSource->GetAs<FDataSource<float>>()); break;
+			case Byte:		bucketIndex = this->m_ByteSources.Add(dataSource->GetAs<FDataSource<uint8>>()); break;
+			case Vector:	bucketIndex = this->m_VectorSources.Add(dataSource->GetAs<FDataSource<FVector>>()); break;
+			case Rotator:	bucketIndex = this->m_RotatorSources.Add(dataSource->GetAs<FDataSource<FRotator>>()); break;
+			case Transform:	bucketIndex = this->m_TransformSources.Add(dataSource->GetAs<FDataSource<FTransform>>()); break;
+
+			default:
+				return false;
 		}
+
+		this->m_Columns.Add({ dataSource->GetDataSourceType(), dataSource, (uint32)bucketIndex, 0 });
+
+		this->m_NumDataSources++;
+		return true;
 	}
 
-	void FTracerDataRepository::Update(uint64 frame, float ElapsedTime, bool forceUpdate)
+	void FDataSourceSamplingPlan::Layout()
 	{
-		SCOPE_CYCLE_COUNTER(STAT_UpdateRepository);
+		/*
+			Snapshot rows store the buckets back to back in the order Capture and Apply walk them.
+		*/
+		uint32 bucketOffsets[Transform + 1] = { 0 };
 
-		if (this->m_Session.IsValid() == false)
-			return;
+		this->m_SnapshotSize = 0;
+
+		bucketOffsets[Bool]			= this->m_SnapshotSize;	this->m_SnapshotSize += this->m_BoolSources.Num() * (uint32)sizeof(bool);
+		bucketOffsets[Int]			= this->m_SnapshotSize;	this->m_SnapshotSize += this->m_IntSources.Num() * (uint32)sizeof(int32);
+		bucketOffsets[Float]		= this->m_SnapshotSize;	this->m_SnapshotSize += this->m_FloatSources.Num() * (uint32)sizeof(float);
+		bucketOffsets[Byte]			= this->m_SnapshotSize;	this->m_SnapshotSize += this->m_ByteSources.Num() * (uint32)sizeof(uint8);
+		bucketOffsets[Vector]		= this->m_SnapshotSize;	this->m_SnapshotSize += this->m_VectorSources.Num() * (uint32)sizeof(FVector);
+		bucketOffsets[Rotator]		= this->m_SnapshotSize;	this->m_SnapshotSize += this->m_RotatorSources.Num() * (uint32)sizeof(FRotator);
+		bucketOffsets[Transform]	= this->m_SnapshotSize;	this->m_SnapshotSize += this->m_TransformSources.Num() * (uint32)sizeof(FTransform);
+
+		this->m_CsvColumns.Reset();
 
-		if (this->m_TracedActor == nullptr || this->m_TracedActor->IsValidLowLevel() == false || this->m_TracedActor->IsPendingKillOrUnreachable() == true)
+		for (FSnapshotColumn& column : this->m_Columns)
 		{
-			this->Stop();
-			return;
+			column.SnapshotOffset = bucketOffsets[column.Type] + column.BucketIndex * column.DataSource->GetSampleSize();
+
+			// keep csv columns in the same order the header was written in
+			if (column.DataSource->ShouldStreamtoCsv() == true)
+				this->m_CsvColumns.Add(column);
 		}
+	}
 
+	void FDataSourceSamplingPlan::Reset()
+	{
+		this->m_BoolSources.Reset();
+		this->m_IntSources.Reset();
+		this->m_FloatSources.Reset();
+		this->m_ByteSources.Reset();
+		this->m_VectorSources.Reset();
+		this->m_RotatorSources.Reset();
+		this->m_TransformSources.Reset();
+		this->m_Columns.Reset();
+		this->m_CsvColumns.Reset();
+
+		this->m_NumDataSources = 0;
+		this->m_SnapshotSize = 0;
+		this->m_IsCompiled = false;
+	}
 
+	void FDataSourceSamplingPlan::Execute(uint64 sequence, CSVStream* stream) const
+	{
+		// gather
+		GatherSamples(this->m_BoolSources, sequence);
+		GatherSamples(this->m_IntSources, sequence);
+		GatherSamples(this->m_FloatSources, sequence);
+		GatherSamples(this->m_ByteSources, sequence);
+		GatherSamples(this->m_VectorSources, sequence);
+		GatherSamples(this->m_RotatorSources, sequence);
+		GatherSamples(this->m_TransformSources, sequence);
+
+		if (stream == nullptr)
+			return;
 
-		if (forceUpdate == true || (this->m_State == TRACING && (this->m_Session.Pin()->GetSessionState() == FTracerSession::TRACING)))
-		{
-			for (auto& dataGroup : this->m_DataGroups)
-			{
-				for (int i = 0; i < dataGroup.Value.Num(); ++i)
-				{
-					dataGroup.Value[i]->SampleData(frame, ElapsedTime, this->m_CSVStream);
-				}
-			}
+		StreamLatest(*stream);
+	}
 
-			if (this->ShouldStreamToCsv() && this->m_CSVStream != nullptr)
+	void FDataSourceSamplingPlan::StreamLatest(CSVStream& stream) const
+	{
+		for (const FSnapshotColumn& column : this->m_CsvColumns)
+		{
+			switch (column.Type)
 			{
-				// line break	
-				(*this->m_CSVStream) << CSVStream::endl;
+				case Bool:		static_cast<const FDataSource<bool>*>(column.DataSource)->StreamLatest(stream); break;
+				case Int:		static_cast<const FDataSource<int32>*>(column.DataSource)->StreamLatest(stream); break;
+				case Float:		static_cast<const FDataSource<float>*>(column.DataSource)->StreamLatest(stream); break;
+				case Byte:		static_cast<const FDataSource<uint8>*>(column.DataSource)->StreamLatest(stream); break;
+				case Vector:	static_cast<const FDataSource<FVector>*>(column.DataSource)->StreamLatest(stream); break;
+				case Rotator:	static_cast<const FDataSource<FRotator>*>(column.DataSource)->StreamLatest(stream); break;
+				case Transform:	static_cast<const FDataSource<FTransform>*>(column.DataSource)->StreamLatest(stream); break;
 			}
 		}
 	}
 
-	void FTracerDataRepository::Start(const FDateTime& sessionStart)
+	void FDataSourceSamplingPlan::Capture(uint8* row) const
 	{
-		this->m_State = TRACING;
+		row = CaptureSamples(this->m_BoolSources, row);
+		row = CaptureSamples(this->m_IntSources, row);
+		row = CaptureSamples(this->m_FloatSources, row);
+		row = CaptureSamples(this->m_ByteSources, row);
+		row = CaptureSamples(this->m_VectorSources, row);
+		row = CaptureSamples(this->m_RotatorSources, row);
+		row = CaptureSamples(this->m_TransformSources, row);
+	}
 
-		// open csv file stream if used and there are data sources to be sampled from
-		if (this->m_DataGroups.Num() > 0 && this->m_StreamToCsv == true)
+	void FDataSourceSamplingPlan::Apply(const uint8* row, uint64 sequence) const
+	{
+		// scatter
+		row = ApplySamples(this->m_BoolSources, row, sequence);
+		row = ApplySamples(this->m_IntSources, row, sequence);
+		row = ApplySamples(this->m_FloatSources, row, sequence);
+		row = ApplySamples(this->m_ByteSources, row, sequence);
+		row = ApplySamples(this->m_VectorSources, row, sequence);
+		row = ApplySamples(this->m_RotatorSources, row, sequence);
+		row = ApplySamples(this->m_TransformSources, row, sequence);
+	}
+
+	void FDataSourceSamplingPlan::StreamRow(const uint8* row, CSVStream& stream) const
+	{
+		for (const FSnapshotColumn& column : this->m_CsvColumns)
 		{
-			const FString sessionAllias = FString::Printf(TEXT("Session-%02d%02d%04d-%02d%02d%02d%03d"),
-				sessionStart.GetDay(),
-				sessionStart.GetMonth(),
-				sessionStart.GetYear(),
-				sessionStart.GetHour(),
-				sessionStart.GetMinute(),
-				sessionStart.GetSecond(),
-				sessionStart.GetMillisecond());
+			const uint8* data = row + column.SnapshotOffset;
 
-			this->m_CSVStream = new CSVStream(sessionAllias, FString::Printf(TEXT("%s-%u"), *this->m_RepositoryName, this->m_RepositoryId));
+			switch (column.Type)
+			{
+				case Bool:		StreamSnapshotValue<bool>(stream, data); break;
+				case Int:		StreamSnapshotValue<int32>(stream, data); break;
+				case Float:		StreamSnapshotValue<float>(stream, data); break;
+				case Byte:		StreamSnapshotValue<uint8>(stream, data); break;
+				case Vector:	StreamSnapshotValue<FVector>(stream, data); break;
+				case Rotator:	StreamSnapshotValue<FRotator>(stream, data); break;
+				case Transform:	StreamSnapshotValue<FTransform>(stream, data); break;
+			}
 		}
-		else
+	}
+
+	int32 FDataSourceSamplingPlan::FindSnapshotOffset(const IDataSource* dataSource) const
+	{
+		for (const FSnapshotColumn& column : this->m_Columns)
 		{
-			this->m_CSVStream = nullptr;
+			if (column.DataSource == dataSource)
+				return (int32)column.SnapshotOffset;
 		}
 
-		// write csv header
-		if (this->m_CSVStream != nullptr)
+		return INDEX_NONE;
+	}
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	FTracerDataRepository
+	///-------------------------------------------------------------------------------------------------
+
+	// number of samples the consumers of the published samples may fall behind, the writer task and the views consume every frame
+	static const uint32 PUBLISHED_SAMPLES_CAPACITY = 256;
+
+	/// Summary:	The csv column names of a data source, one per component (e.g. 'Velocity.X').
+	static void GetCsvColumnNames(const IDataSource& dataSource, TArray<FString>& outNames)
+	{
+		static const FString REPLACE_PATTERN(" ");
+		static const FString REPLACEMENT("_");
+
+		FString name = dataSource.GetName(); 
+		name = name.ConvertTabsToSpaces(1).TrimStartAndEnd().Replace(*REPLACE_PATTERN, *REPLACEMENT);
+
+		switch (dataSource.GetDataSourceType())
 		{
-			CSVStream& stream = *this->m_CSVStream;
+			case Bool:
+			case Int:
+			case Float:
+			case Byte:
+			{
+				outNames.Add(name);
+				break;
+			}
 
-			for (auto& dataGroup : this->m_DataGroups)
+			case Vector:
 			{
-				for (int i = 0; i < dataGroup.Value.Num(); ++i)
-				{
-					if (dataGroup.Value[i]->ShouldStreamtoCsv() == true)
-					{
-						static const FString REPLACE_PATTERN(" ");
-						static const FString REPLACEMENT("_");
-
-						FString name = dataGroup.Value[i]->GetName(); 
-						name = name.ConvertTabsToSpaces(1).TrimStartAndEnd().Replace(*REPLACE_PATTERN, *REPLACEMENT);
-
-						switch (dataGroup.Value[i]->GetDataSourceType())
-						{
-							case Bool:
-							case Int:
-							case Float:
-							case Byte:
-							{
-								stream << name;
-								break;
-							}
-
-							case Vector:
-							{
-								stream << FString::Printf(TEXT("%s.X"), *name);
-								stream << FString::Printf(TEXT("%s.Y"), *name);
-								stream << FString::Printf(TEXT("%s.Z"), *name);
-								break;
-							}
-
-							case Rotator:
-							{
-								stream << FString::Printf(TEXT("%s.Roll"), *name);
-								stream << FString::Printf(TEXT("%s.Pitch"), *name);
-								stream << FString::Printf(TEXT("%s.Yaw"), *name);
-								break;
-							}
-
-							case Transform:
-							{
-								stream << FString::Printf(TEXT("%s.Location.X"), *name);
-								stream << FString::Printf(TEXT("%s.Location.Y"), *name);
-								stream << FString::Printf(TEXT("%s.Location.Z"), *name);
-								stream << FString::Printf(TEXT("%s.Rotation.Roll"), *name);
-								stream << FString::Printf(TEXT("%s.Rotation.Pitch"), *name);
-								stream << FString::Printf(TEXT("%s.Rotation.Yaw"), *name);
-								stream << FString::Printf(TEXT("%s.Scale.X"), *name);
-								stream << FString::Printf(TEXT("%s.Scale.Y"), *name);
-								stream << FString::Printf(TEXT("%s.Scale.Z"), *name);
-								break;
-							}
-						}				
-					}
-				}
+				outNames.Add(FString::Printf(TEXT("%s.X"), *name));
+				outNames.Add(FString::Printf(TEXT("%s.Y"), *name));
+				outNames.Add(FString::Printf(TEXT("%s.Z"), *name));
+				break;
+			}
+
+			case Rotator:
+			{
+				outNames.Add(FString::Printf(TEXT("%s.Roll"), *name));
+				outNames.Add(FString::Printf(TEXT("%s.Pitch"), *name));
+				outNames.Add(FString::Printf(TEXT("%s.Yaw"), *name));
+				break;
 			}
 
-			stream << CSVStream::endl;
+			case Transform:
+			{
+				outNames.Add(FString::Printf(TEXT("%s.Location.X"), *name));
+				outNames.Add(FString::Printf(TEXT("%s.Location.Y"), *name));
+				outNames.Add(FString::Printf(TEXT("%s.Location.Z"), *name));
+				outNames.Add(FString::Printf(TEXT("%s.Rotation.Roll"), *name));
+				outNames.Add(FString::Printf(TEXT("%s.Rotation.Pitch"), *name));
+				outNames.Add(FString::Printf(TEXT("%s.Rotation.Yaw"), *name));
+				outNames.Add(FString::Printf(TEXT("%s.Scale.X"), *name));
+				outNames.Add(FString::Printf(TEXT("%s.Scale.Y"), *name));
+				outNames.Add(FString::Printf(TEXT("%s.Scale.Z"), *name));
+				break;
+			}
 		}
 	}
 
-	void FTracerDataRepository::Pause()
+	/// Summary:	The binary trace columns of a sampling plan, one per csv column.
+	static void GetTraceColumns(const FDataSourceSamplingPlan& plan, TArray<FTraceStream::FColumn>& outColumns)
 	{
-		if (this->m_State >= PAUSED)
-			return;
+		for (const FDataSourceSamplingPlan::FSnapshotColumn& column : plan.GetCsvColumns())
+		{
+			FTraceStream::FColumn& traceColumn = outColumns.AddDefaulted_GetRef();
+			traceColumn.Type = (uint32)column.Type;
+			traceColumn.SnapshotOffset = column.SnapshotOffset;
 
-		this->m_State = PAUSED;
+			GetCsvColumnNames(*column.DataSource, traceColumn.ComponentNames);
+		}
 	}
 
-	void FTracerDataRepository::Resume()
+	/// Summary:	Name of the directory csv files and history archives of a session are written to.
+	static FString GetSessionDirectoryName(const FDateTime& sessionStart)
 	{
-		if (this->m_State != PAUSED)
-			return;
-
-		this->m_State = TRACING;
+		return FString::Printf(TEXT("Session-%02d%02d%04d-%02d%02d%02d%03d"),
+			sessionStart.GetDay(),
+			sessionStart.GetMonth(),
+			sessionStart.GetYear(),
+			sessionStart.GetHour(),
+			sessionStart.GetMinute(),
+			sessionStart.GetSecond(),
+			sessionStart.GetMillisecond());
 	}
 
-	void FTracerDataRepository::Stop()
+	/// Summary:	Creates a data source without source for a traced stat, named after the stat's csv columns (see GetCsvColumnNames).
+	static IDataSource* CreateImportedDataSource(const FTraceStream::FColumn& column, const FColor& color)
 	{
-		if (this->m_State >= STOPPED)
-			return;
+		// 'Velocity.X' -> 'Velocity', 'Transform.Location.X' -> 'Transform'
+		FString name = column.ComponentNames.Num() > 0 ? column.ComponentNames[0] : FString();
+
+		const int32 numSuffixes = column.Type == Transform ? 2 : (column.ComponentNames.Num() > 1 ? 1 : 0);
+		for (int32 i = 0; i < numSuffixes; ++i)
+		{
+			int32 dot = INDEX_NONE;
+			if (name.FindLastChar(TEXT('.'), dot) == true)
+				name = name.Left(dot);
+		}
+
+		switch ((EDataSourceType)column.Type)
+		{
+			case Bool:		return new FBoolDataSource(nullptr, name, "", "", color, false);
+			case Int:		return new FIntDataSource(nullptr, name, "", "", color, false);
+			case Float:		return new FFloatDataSource(nullptr, name, "", "", color, false);
+			case Byte:		return new FByteDataSource(nullptr, name, "", "", color, false);
+			case Vector:	return new FVectorDataSource(nullptr, name, "", "", color, false);
+			case Rotator:	return new FRotatorDataSource(nullptr, name, "", "", color, false);
+			case Transform:	return new FTransformDataSource(nullptr, name, "", "", color, false);
+			default:		return nullptr;
+		}
+	}
+
+	FTracerDataRepository::FTracerDataRepository(const FString& name, const FString& repositoryDescription, AActor* tracedActor, TSharedPtr<FTracerSession> session, const bool streamToCsv, const bool autostart) :
+		m_RepositoryId(tracedActor->GetUniqueID()),
+		m_RepositoryName(name),
+		m_RepositoryDescription(FText::FromString(repositoryDescription)),
+		m_TracedActor(tracedActor),
+		m_TracedActorFName(tracedActor->GetFName()),
+		m_Session(session),
+		m_Timeline(UStatsTracerEditorSettings::GetInstance()->GetSampleWindowSize(), session.IsValid() == true ? session->GetSampleArena() : FSampleArenaHandle()),
+		m_SampleRate(FTracerSampleRate::GetDefault()),
+		m_NextSampleTime(0.0),
+		m_State(INITIALIZED),
+		m_StreamToCsv(streamToCsv),
+		m_AutoStartOnBeginPlay(autostart),
+		m_CSVStream(nullptr),
+		m_WritesAsynchronously(false),
+		m_NextColorStartHue(0.0f),
+		m_IsImported(false),
+		m_MemoryAccount(session.IsValid() == true ? &session->GetMemoryAccount() : nullptr),
+		m_MemoryChanged(false)
+	{}
+
+	FTracerDataRepository::FTracerDataRepository(const FString& name, uint32 repositoryId, TSharedPtr<FTracerSession> session, TUniquePtr<FHistoryArchive> trace, const TArray<FTraceStream::FColumn>& columns) :
+		m_RepositoryId(repositoryId),
+		m_RepositoryName(name),
+		m_RepositoryDescription(FText::FromString(trace->GetFileName())),
+		m_TracedActor(nullptr),
+		m_TracedActorFName(NAME_None),
+		m_Session(session),
+		m_Timeline(UStatsTracerEditorSettings::GetInstance()->GetSampleWindowSize(), session.IsValid() == true ? session->GetSampleArena() : FSampleArenaHandle()),
+		m_SampleRate(FTracerSampleRate::GetDefault()),
+		m_NextSampleTime(0.0),
+		m_State(INITIALIZED),
+		m_StreamToCsv(false),
+		m_AutoStartOnBeginPlay(false),
+		m_CSVStream(nullptr),
+		m_WritesAsynchronously(false),
+		m_NextColorStartHue(0.0f),
+		m_IsImported(true),
+		m_MemoryAccount(session.IsValid() == true ? &session->GetMemoryAccount() : nullptr),
+		m_MemoryChanged(false)
+	{
+		// bound first, the sources are charged for what the trace keeps resident rather than a sample window
+		this->m_HistoryArchive = MoveTemp(trace);
+		this->m_Timeline.BindHistoryArchive(this->m_HistoryArchive.Get());
+
+		for (int32 column = 0; column < columns.Num(); ++column)
+		{
+			IDataSource* dataSource = CreateImportedDataSource(columns[column], GetNextDefaultDataSourceColor());
+			if (dataSource == nullptr)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Trace file '%s' holds a stat of unknown type, it will not be shown."), *this->m_HistoryArchive->GetFileName());
+				continue;
+			}
+
+			dataSource->BindArchiveColumn(column);
+			AddDataSource(dataSource);
+		}
+
+		// nothing is recorded anymore, views start at the end of the trace
+		this->m_State = COMPLETE;
+		SetHistoryPage(INDEX_NONE);
+	}
+
+	FTracerDataRepository::~FTracerDataRepository()
+	{
+		if (this->m_CSVStream != nullptr)
+		{
+			delete this->m_CSVStream;
+			this->m_CSVStream = nullptr;
+		}
+
+		this->m_TracedActor = nullptr;
+		this->m_Session = nullptr;
+		this->m_SamplingPlan.Reset();
+
+		// data sources refer to the archive through the timeline
+		this->m_Timeline.BindHistoryArchive(nullptr);
+		this->m_ArchivedSources.Empty();
+		this->m_HistoryArchive.Reset();
+
+		// editor views may keep a source alive, it must not report to this repository's account anymore
+		for (auto& dataGroup : this->m_DataGroups)
+		{
+			for (TDataSourceHandle& dataSource : dataGroup.Value)
+				dataSource->BindMemoryAccount(nullptr);
+		}
+
+		this->m_DataGroups.Empty();
+	}
+
+	void FTracerDataRepository::AddDataSource(IDataSource* dataSourcePtr)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_AddDatasource);
+
+		if (this->m_State >= STOPPED)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Tracer data-repository '%s' is no longer active, no more data-sources can be added."), *this->m_RepositoryName);
+			return;
+		}
+
+		/* DO NOT TRACE THE SAME STAT TWICE! */
+		for (auto GROUP : this->m_DataGroups)
+		{
+			for (auto SOURCE : GROUP.Value)
+			{
+				if (dataSourcePtr->GetRawDataPtr() != nullptr && dataSourcePtr->GetRawDataPtr() == SOURCE->GetRawDataPtr())
+				{
+					UE_LOG(LogTemp, Warning, TEXT("DataSources '%s' and '%s' are tracing the same stat. Ignoring duplicate data source."), *SOURCE->GetName(), *dataSourcePtr->GetName());
+					return;
+				}
+			}
+		}
+
+		for (const TDataSourceHandle& SOURCE : this->m_DeferredDataSources)
+		{
+			if (dataSourcePtr->GetRawDataPtr() != nullptr && dataSourcePtr->GetRawDataPtr() == SOURCE->GetRawDataPtr())
+			{
+				UE_LOG(LogTemp, Warning, TEXT("DataSources '%s' and '%s' are tracing the same stat. Ignoring duplicate data source."), *SOURCE->GetName(), *dataSourcePtr->GetName());
+				return;
+			}
+		}
+
+		// create smart pointer for memory management
+		TDataSourceHandle dataSource { dataSourcePtr };
+
+		// all sources of this repository share its timeline
+		dataSource->BindTimeline(&this->m_Timeline);
+		dataSource->BindMemoryAccount(&this->m_MemoryAccount);
+
+		AdmitDataSource(dataSource);
+	}
+
+	void FTracerDataRepository::AddDeferredDataSources()
+	{
+		if (this->m_DeferredDataSources.Num() == 0)
+			return;
+
+		if (this->m_State >= STOPPED)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Tracer data-repository '%s' stopped before there was memory for %d deferred data-sources, they will not be traced."), *this->m_RepositoryName, this->m_DeferredDataSources.Num());
+			this->m_DeferredDataSources.Empty();
+			return;
+		}
+
+		// sources that have to wait once more are deferred again
+		TDataSourceArray deferred = MoveTemp(this->m_DeferredDataSources);
+		for (const TDataSourceHandle& dataSource : deferred)
+			AdmitDataSource(dataSource);
+	}
+
+	void FTracerDataRepository::AdmitDataSource(const TDataSourceHandle& dataSource)
+	{
+		// If check if there is still enough memory to store this datasource
+		{
+			// nothing is allocated yet, the budget is checked against the size of the raw samples. An imported source
+			// has none, it reads the page shown from the trace and that page is accounted once it is read.
+			uint64 dataSourceTotalMemorySize = this->m_IsImported == false ? dataSource->GetDataSourceUncompressedMemorySize() : 0;
+
+			// the first data source also pays for the repository's shared timeline, or for what an imported trace keeps resident
+			if (this->m_DataGroups.Num() == 0)
+				dataSourceTotalMemorySize += this->m_IsImported == false ? this->m_Timeline.GetUncompressedMemorySize() : this->m_HistoryArchive->GetPhysicalMemorySize();
+
+			// older sessions give way first, the source is only refused if that is not enough
+			if (StatsTracer::TDRM->GetAvailablePhysicalMemory() < dataSourceTotalMemorySize)
+			{
+				switch (StatsTracer::TDRM->ReclaimPhysicalMemory(dataSourceTotalMemorySize))
+				{
+					case FTracerDataRepositoryManager::ReclaimPending:
+						UE_LOG(LogTemp, Log, TEXT("StatsTracer plugin reached memory limitation. '%s' stat will be traced once an older session is compressed."), *dataSource->GetName());
+						this->m_DeferredDataSources.Add(dataSource);
+						return;
+
+					case FTracerDataRepositoryManager::ReclaimExhausted:
+						UE_LOG(LogTemp, Warning, TEXT("StatsTracer plugin reached memory limitation. '%s' stat will not be traced."), *dataSource->GetName());
+						return;
+
+					default:
+						break;
+				}
+			}
+		}
+
+		// the sample ring is allocated from the session's arena once the stride is known, see ResolveSampleStride
+		if (this->m_Session.IsValid() == true)
+			dataSource->BindSampleArena(this->m_Session.Pin()->GetSampleArena());
+		else
+			dataSource->BindSampleArena(nullptr);
+
+
+		FString group = dataSource->GetGroup();
+		group = group.TrimStartAndEnd().Equals("") == true ? FString("Default") : dataSource->GetGroup();
+
+		bool added = false;
+
+		TArray<TDataSourceHandle>* dataSourceGroup = this->m_DataGroups.Find(*group);
+		if(dataSourceGroup != nullptr)
+		{
+			// duplicate check
+			bool result = dataSourceGroup->ContainsByPredicate([&](TDataSourceHandle& other) { return dataSource->GetName().Equals(other->GetName()); });
+			if (result == false)
+			{
+				dataSourceGroup->Add(dataSource);
+				added = true;
+			}
+			else
+			{
+				UE_LOG(LogTemp, Warning, TEXT("DataSource \'%s\' already exists in group \'%s\'. DataSource will be ignored."), *dataSource->GetName(), *group);
+			}
+		}
+		// group does not exist yet, create it.
+		else
+		{
+			this->m_DataGroups.Add(group).Add(dataSource);
+			added = true;
+		}
+
+		// the repository is already sampling, the new source joins with the next sample
+		if (added == true && (this->m_State == TRACING || this->m_State == PAUSED))
+		{
+			ExtendSchema(dataSource.Get());
+		}
+
+		if (added == true)
+			RequestMemorySync();
+	}
+
+	IDataSource* FTracerDataRepository::FindDataSource(const FString& name) const
+	{
+		for (auto& dataGroup : this->m_DataGroups)
+		{
+			for (const TDataSourceHandle& dataSource : dataGroup.Value)
+			{
+				if (dataSource->GetName().Equals(name) == true)
+					return dataSource.Get();
+			}
+		}
+
+		return nullptr;
+	}
+
+	void FTracerDataRepository::SetSampleRate(const FTracerSampleRate& rate)
+	{
+		if (this->m_State > INITIALIZED)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Tracer data-repository '%s' is already active, sample rate will not be changed."), *this->m_RepositoryName);
+			return;
+		}
+
+		this->m_SampleRate = rate.IsSet() == true ? rate : FTracerSampleRate::GetDefault();
+	}
+
+	bool FTracerDataRepository::IsSampleDue(uint64 frame, double ElapsedTime)
+	{
+		double now = 0.0;
+
+		switch (this->m_SampleRate.Clock)
+		{
+			case ETracerSampleClock::Frames:
+				return (frame % this->m_SampleRate.GetFrameInterval()) == 0;
+
+			case ETracerSampleClock::GameTime:
+				now = ElapsedTime;
+				break;
+
+			case ETracerSampleClock::RealTime:
+				now = FPlatformTime::Seconds();
+				break;
+		}
+
+		if (now < this->m_NextSampleTime)
+			return false;
+
+		// keep a steady rate, but do not try to catch up after a hitch or a pause
+		const double period = this->m_SampleRate.GetPeriod();
+
+		this->m_NextSampleTime += period;
+		if (this->m_NextSampleTime <= now)
+			this->m_NextSampleTime = now + period;
+
+		return true;
+	}
+
+	void FTracerDataRepository::ResolveSampleStrides()
+	{
+		for (auto& dataGroup : this->m_DataGroups)
+		{
+			for (TDataSourceHandle& dataSource : dataGroup.Value)
+			{
+				ResolveSampleStride(*dataSource);
+			}
+		}
+	}
+
+	void FTracerDataRepository::ResolveSampleStride(IDataSource& dataSource)
+	{
+		uint32 stride = 1;
+
+		if (this->m_SampleRate.GetStride(dataSource.GetSampleRate(), stride) == false)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("DataSource '%s' uses a different sample clock than tracer '%s' and will be sampled at the tracer's rate."), *dataSource.GetName(), *this->m_RepositoryName);
+		}
+
+		dataSource.SetSampleStride(stride);
+	}
+
+	void FTracerDataRepository::ExtendSchema(IDataSource* dataSource)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ExtendSchema);
+
+		// published rows are laid out for the old plan, write and apply them before it changes
+		if (this->m_WritesAsynchronously == true)
+		{
+			if (this->m_Session.IsValid() == true)
+				this->m_Session.Pin()->WaitForPendingSamples();
+
+			WriteSamples();
+			ApplyPublishedSamples();
+		}
+
+		ResolveSampleStride(*dataSource);
+
+		this->m_SamplingPlan.Append(dataSource);
+
+		if (this->m_WritesAsynchronously == true)
+		{
+			this->m_PublishedSamples.Initialize(Align(sizeof(FSampleRecord) + this->m_SamplingPlan.GetSnapshotSize(), alignof(FSampleRecord)), PUBLISHED_SAMPLES_CAPACITY);
+			this->m_WriteCursor = FSampleBlockRing::FCursor();
+			this->m_ViewCursor = FSampleBlockRing::FCursor();
+		}
+
+		const uint64 frame = this->m_Session.IsValid() == true ? this->m_Session.Pin()->GetFrameCounter() : 0;
+
+		// earlier rows stay as they are, a comment and a new header mark the change
+		if (this->m_CSVStream != nullptr && dataSource->ShouldStreamtoCsv() == true)
+		{
+			this->m_CSVStream->WriteSchemaChange(frame);
+			WriteCsvHeader();
+		}
+
+		if (this->m_TraceStream.IsValid() == true)
+		{
+			TArray<FTraceStream::FColumn> columns;
+			GetTraceColumns(this->m_SamplingPlan, columns);
+
+			this->m_TraceStream->ExtendColumns(frame, columns);
+			this->m_TraceRow.SetNumZeroed(this->m_SamplingPlan.GetSnapshotSize());
+		}
+
+		// archived sources keep their columns, only their snapshot offsets move
+		for (int32 column = 0; column < this->m_ArchivedSources.Num(); ++column)
+			this->m_ArchiveSnapshotOffsets[column] = (uint32)FMath::Max<int32>(0, this->m_SamplingPlan.FindSnapshotOffset(this->m_ArchivedSources[column]));
+	}
+
+	void FTracerDataRepository::Update(uint64 frame, double ElapsedTime, bool forceUpdate)
+	{
+		if (this->m_Session.IsValid() == false)
+			return;
+
+		const bool sessionTracing = this->m_Session.Pin()->GetSessionState() == FTracerSession::TRACING;
+
+		if (BeginUpdate(frame, ElapsedTime, sessionTracing, forceUpdate) == true)
+		{
+			SampleUpdate(frame, ElapsedTime, UStatsTracerEditorSettings::GetInstance()->UseCompiledSamplingPlan);
+		}
+	}
+
+	bool FTracerDataRepository::BeginUpdate(uint64 frame, double ElapsedTime, bool sessionTracing, bool forceUpdate)
+	{
+		// the actor is released by TrackActorLifetime's delegates the moment it goes away
+		if (this->m_TracedActor.IsValid() == false)
+		{
+			this->Stop();
+			return false;
+		}
+
+		if (forceUpdate == false && (this->m_State != TRACING || sessionTracing == false))
+			return false;
+
+		if (IsSampleDue(frame, ElapsedTime) == false)
+			return false;
+
+		return true;
+	}
+
+	void FTracerDataRepository::SampleUpdate(uint64 frame, double ElapsedTime, bool useCompiledPlan)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_UpdateRepository);
+
+		// record timestamp once, all data sources refer to it by its sequence number
+		const uint64 sequence = this->m_Timeline.Record(frame, ElapsedTime);
+
+		// run-length encoded sources and the archive grow while sampling
+		if (((sequence + 1) % MEMORY_SYNC_INTERVAL) == 0)
+			RequestMemorySync();
+
+		if (this->m_WritesAsynchronously == true)
+		{
+			PublishSample(sequence, frame, ElapsedTime);
+			return;
+		}
+
+		CSVStream* stream = this->ShouldStreamToCsv() ? this->m_CSVStream : nullptr;
+
+		if (this->m_SamplingPlan.IsCompiled() == true && useCompiledPlan == true)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_SampleRepositoryPlan);
+
+			this->m_SamplingPlan.Execute(sequence, stream);
+
+			INC_DWORD_STAT_BY(STAT_SampledDataSources, this->m_SamplingPlan.Num());
+		}
+		else
+		{
+			SCOPE_CYCLE_COUNTER(STAT_SampleRepositoryVirtual);
+
+			for (auto& dataGroup : this->m_DataGroups)
+			{
+				for (int i = 0; i < dataGroup.Value.Num(); ++i)
+				{
+					dataGroup.Value[i]->SampleData(sequence);
+				}
+
+				INC_DWORD_STAT_BY(STAT_SampledDataSources, dataGroup.Value.Num());
+			}
+
+			// csv columns follow the plan, sources added while tracing are not in group order
+			if (stream != nullptr)
+				this->m_SamplingPlan.StreamLatest(*stream);
+		}
+
+		if (this->ShouldStreamToCsv() && this->m_CSVStream != nullptr)
+		{
+			// line break	
+			(*this->m_CSVStream) << CSVStream::endl;
+		}
+
+		// the binary trace takes a snapshot row of the values just sampled
+		if (this->m_TraceStream.IsValid() == true)
+		{
+			this->m_SamplingPlan.Capture(this->m_TraceRow.GetData());
+			this->m_TraceStream->WriteRow(frame, ElapsedTime, this->m_TraceRow.GetData());
+		}
+
+		// seal the chunk completed by this sample
+		if (this->m_HistoryArchive.IsValid() == true)
+		{
+			const uint32 chunkLength = this->m_HistoryArchive->GetChunkLength();
+
+			if (((sequence + 1) & (chunkLength - 1)) == 0)
+				ArchiveHistoryChunk(sequence + 1 - chunkLength, chunkLength);
+		}
+	}
+
+	void FTracerDataRepository::PublishSample(uint64 sequence, uint64 frame, double ElapsedTime)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_PublishSample);
+
+		uint8* block = this->m_PublishedSamples.BeginPublish();
+
+		FSampleRecord* record = (FSampleRecord*)block;
+		record->Sequence = sequence;
+		record->Frame = frame;
+		record->ElapsedTime = ElapsedTime;
+
+		uint8* row = block + sizeof(FSampleRecord);
+		this->m_SamplingPlan.Capture(row);
+
+		this->m_PublishedSamples.EndPublish();
+
+		// nobody views the repository, its sample rings catch up in a batch before they lose samples
+		if (this->m_PublishedSamples.GetBacklog(this->m_ViewCursor) >= PUBLISHED_SAMPLES_CAPACITY / 2)
+			ApplyPublishedSamples();
+
+		INC_DWORD_STAT_BY(STAT_SampledDataSources, this->m_SamplingPlan.Num());
+	}
+
+	void FTracerDataRepository::ApplyPublishedSamples()
+	{
+		if (this->m_WritesAsynchronously == false)
+			return;
+
+		SCOPE_CYCLE_COUNTER(STAT_ApplyPublishedSamples);
+
+		uint64 next = this->m_ViewCursor.Next;
+
+		this->m_PublishedSamples.Consume(this->m_ViewCursor, [this, &next](uint64 sequence, const uint8* block)
+		{
+			// records were lost, the rings restart from the oldest record still published rather than hold a gap
+			if (sequence != next)
+			{
+				for (auto& dataGroup : this->m_DataGroups)
+				{
+					for (TDataSourceHandle& dataSource : dataGroup.Value)
+					{
+						if (dataSource.IsValid() == true)
+							dataSource->Clear();
+					}
+				}
+			}
+
+			next = sequence + 1;
+
+			this->m_SamplingPlan.Apply(block + sizeof(FSampleRecord), ((const FSampleRecord*)block)->Sequence);
+		});
+	}
+
+	void FTracerDataRepository::WriteSamples()
+	{
+		SCOPE_CYCLE_COUNTER(STAT_WriteSamples);
+
+		const uint64 dropped = this->m_WriteCursor.Dropped;
+
+		this->m_PublishedSamples.Consume(this->m_WriteCursor, [this](uint64, const uint8* block)
+		{
+			WriteSample(*(const FSampleRecord*)block, block + sizeof(FSampleRecord));
+		});
+
+		if (this->m_WriteCursor.Dropped != dropped)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Tracer data-repository '%s' lost %llu samples before they could be written."), *this->m_RepositoryName, this->m_WriteCursor.Dropped - dropped);
+		}
+	}
+
+	void FTracerDataRepository::WriteSample(const FSampleRecord& record, const uint8* row)
+	{
+		if (this->ShouldStreamToCsv() && this->m_CSVStream != nullptr)
+		{
+			this->m_SamplingPlan.StreamRow(row, *this->m_CSVStream);
+
+			// line break	
+			(*this->m_CSVStream) << CSVStream::endl;
+		}
+
+		if (this->m_TraceStream.IsValid() == true)
+		{
+			this->m_TraceStream->WriteRow(record.Frame, record.ElapsedTime, row);
+		}
+
+		if (this->m_HistoryArchive.IsValid() == true)
+		{
+			StageArchiveSample(record, row);
+
+			// seal the chunk completed by this sample
+			const uint32 chunkLength = this->m_HistoryArchive->GetChunkLength();
+
+			if (((record.Sequence + 1) & (chunkLength - 1)) == 0)
+				AppendStagedChunk(chunkLength);
+		}
+	}
+
+	void FTracerDataRepository::StageArchiveSample(const FSampleRecord& record, const uint8* row)
+	{
+		const FHistoryArchive& archive = *this->m_HistoryArchive;
+		const uint32 index = (uint32)(record.Sequence & (archive.GetChunkLength() - 1));
+
+		uint8* data = this->m_ArchiveStaging.GetData();
+
+		((uint64*)(data + archive.GetFramesOffset()))[index] = record.Frame;
+		((double*)(data + archive.GetElapsedTimesOffset()))[index] = record.ElapsedTime;
+
+		for (int32 column = 0; column < this->m_ArchivedSources.Num(); ++column)
+		{
+			const uint32 sampleSize = this->m_ArchivedSources[column]->GetSampleSize();
+
+			FMemory::Memcpy(data + archive.GetColumnOffset(column) + index * sampleSize, row + this->m_ArchiveSnapshotOffsets[column], sampleSize);
+		}
+	}
+
+	void FTracerDataRepository::AppendStagedChunk(uint32 numRows)
+	{
+		const uint8* data = this->m_ArchiveStaging.GetData();
+
+		const uint64* frames = (const uint64*)(data + this->m_HistoryArchive->GetFramesOffset());
+		this->m_HistoryArchive->AppendChunk(data, numRows, frames[0], frames[numRows - 1]);
+	}
+
+	void FTracerDataRepository::OpenHistoryArchive(const FString& sessionDirectory)
+	{
+		// chunks are sealed long before the ring overwrites their entries
+		const uint32 chunkLength = FMath::Min<uint32>(SAMPLE_CHUNK_SIZE, this->m_Timeline.GetWindowSize() / 2);
+
+		TArray<FHistoryArchive::FColumn> columns;
+
+		for (auto& dataGroup : this->m_DataGroups)
+		{
+			for (const TDataSourceHandle& dataSource : dataGroup.Value)
+			{
+				if (dataSource.IsValid() == false)
+					continue;
+
+				dataSource->BindArchiveColumn(columns.Num());
+				columns.Add({ (uint32)dataSource->GetDataSourceType(), dataSource->GetSampleSize() });
+
+				this->m_ArchivedSources.Add(dataSource.Get());
+				this->m_ArchiveSnapshotOffsets.Add((uint32)FMath::Max<int32>(0, this->m_SamplingPlan.FindSnapshotOffset(dataSource.Get())));
+			}
+		}
+
+		this->m_HistoryArchive = MakeUnique<FHistoryArchive>(
+			FPaths::Combine(UStatsTracerEditorSettings::GetInstance()->CsvOutputDir.Path, sessionDirectory), 
+			FString::Printf(TEXT("%s-%u"), *this->m_RepositoryName, this->m_RepositoryId), 
+			chunkLength, 
+			columns);
+
+		if (this->m_HistoryArchive->IsValid() == false)
+		{
+			for (IDataSource* dataSource : this->m_ArchivedSources)
+				dataSource->BindArchiveColumn(INDEX_NONE);
+
+			this->m_ArchivedSources.Empty();
+			this->m_ArchiveSnapshotOffsets.Empty();
+			this->m_HistoryArchive.Reset();
+			return;
+		}
+
+		// published samples are staged one by one
+		if (this->m_WritesAsynchronously == true)
+			this->m_ArchiveStaging.SetNumZeroed(this->m_HistoryArchive->GetChunkSize());
+
+		this->m_Timeline.BindHistoryArchive(this->m_HistoryArchive.Get());
+	}
+
+	void FTracerDataRepository::ArchiveHistoryChunk(uint64 firstSequence, uint32 numRows)
+	{
+		FHistoryArchive& archive = *this->m_HistoryArchive;
+
+		this->m_ArchiveStaging.SetNumUninitialized(archive.GetChunkSize(), false);
+		uint8* data = this->m_ArchiveStaging.GetData();
+
+		uint64* frames = (uint64*)(data + archive.GetFramesOffset());
+		double* elapsedTimes = (double*)(data + archive.GetElapsedTimesOffset());
+
+		for (uint32 i = 0; i < numRows; ++i)
+		{
+			frames[i] = this->m_Timeline.GetFrameNumber(firstSequence + i);
+			elapsedTimes[i] = this->m_Timeline.GetElapsedTime(firstSequence + i);
+		}
+
+		for (int32 column = 0; column < this->m_ArchivedSources.Num(); ++column)
+			this->m_ArchivedSources[column]->ArchiveSamples(firstSequence, numRows, data + archive.GetColumnOffset(column));
+
+		archive.AppendChunk(data, numRows, frames[0], frames[numRows - 1]);
+	}
+
+	void FTracerDataRepository::Start(const FDateTime& sessionStart)
+	{
+		// the writer task reads the sampling plan
+		if (this->m_Session.IsValid() == true)
+			this->m_Session.Pin()->WaitForPendingSamples();
+
+		this->m_State = TRACING;
+
+		// sources sampling slower than the repository keep every n-th sample only
+		ResolveSampleStrides();
+		this->m_NextSampleTime = 0.0;
+
+		// freeze data sources into a flat sampling plan
+		this->m_SamplingPlan.Compile(this->m_DataGroups);
+
+		// publish samples for the writer task, iff enabled
+		{
+			const UStatsTracerEditorSettings* settings = UStatsTracerEditorSettings::GetInstance();
+
+			this->m_WritesAsynchronously = settings->SampleAsynchronously == true && settings->UseCompiledSamplingPlan == true && this->m_SamplingPlan.Num() > 0;
+
+			if (this->m_WritesAsynchronously == true)
+			{
+				this->m_PublishedSamples.Initialize(Align(sizeof(FSampleRecord) + this->m_SamplingPlan.GetSnapshotSize(), alignof(FSampleRecord)), PUBLISHED_SAMPLES_CAPACITY);
+				this->m_WriteCursor = FSampleBlockRing::FCursor();
+				this->m_ViewCursor = FSampleBlockRing::FCursor();
+			}
+		}
+
+		const FString sessionAllias = GetSessionDirectoryName(sessionStart);
+
+		// open history archive, iff enabled
+		if (this->m_DataGroups.Num() > 0 && UStatsTracerEditorSettings::GetInstance()->ArchiveHistoryToDisk == true)
+		{
+			OpenHistoryArchive(sessionAllias);
+		}
+
+		// open csv file or binary trace stream if used and there are data sources to be sampled from
+		this->m_CSVStream = nullptr;
+
+		if (this->m_DataGroups.Num() > 0 && this->m_StreamToCsv == true)
+		{
+			const FString fileName = FString::Printf(TEXT("%s-%u"), *this->m_RepositoryName, this->m_RepositoryId);
+
+			// stream into the session's container file, iff enabled; falls back to a file of our own
+			FSessionContainerHandle container;
+			if (UStatsTracerEditorSettings::GetInstance()->WriteSessionContainer == true && this->m_Session.IsValid() == true)
+				container = this->m_Session.Pin()->GetOutputContainer();
+
+			if (UStatsTracerEditorSettings::GetInstance()->TraceFileFormat == ETraceFileFormat::Binary)
+			{
+				TArray<FTraceStream::FColumn> columns;
+				GetTraceColumns(this->m_SamplingPlan, columns);
+
+				if (container.IsValid() == true)
+					this->m_TraceStream = MakeUnique<FTraceStream>(container, fileName, columns);
+				else
+					this->m_TraceStream = MakeUnique<FTraceStream>(sessionAllias, fileName, columns);
+
+				this->m_TraceRow.SetNumZeroed(this->m_SamplingPlan.GetSnapshotSize());
+			}
+			else
+			{
+				if (container.IsValid() == true)
+					this->m_CSVStream = new CSVStream(container, fileName);
+				else
+					this->m_CSVStream = new CSVStream(sessionAllias, fileName);
+			}
+		}
+
+		// write csv header
+		if (this->m_CSVStream != nullptr)
+		{
+			WriteCsvHeader();
+		}
+
+		// the writer task was waited for above, the published samples are accounted right away
+		SyncMemoryUsage();
+	}
+
+	void FTracerDataRepository::WriteCsvHeader()
+	{
+		CSVStream& stream = *this->m_CSVStream;
+
+		TArray<FString> names;
+
+		// the plan's csv columns are in the order rows are streamed in
+		for (const FDataSourceSamplingPlan::FSnapshotColumn& column : this->m_SamplingPlan.GetCsvColumns())
+		{
+			names.Reset();
+			GetCsvColumnNames(*column.DataSource, names);
+
+			for (const FString& name : names)
+				stream << name;
+		}
+
+		stream << CSVStream::endl;
+	}
+
+	void FTracerDataRepository::Pause()
+	{
+		if (this->m_State >= PAUSED)
+			return;
+
+		this->m_State = PAUSED;
+	}
+
+	void FTracerDataRepository::Resume()
+	{
+		if (this->m_State != PAUSED)
+			return;
+
+		this->m_State = TRACING;
+	}
+
+	void FTracerDataRepository::Stop()
+	{
+		if (this->m_State >= STOPPED)
+			return;
+
+		const bool wroteAsynchronously = this->m_WritesAsynchronously;
+
+		// write what is still published before the streams close
+		if (this->m_WritesAsynchronously == true)
+		{
+			if (this->m_Session.IsValid() == true)
+				this->m_Session.Pin()->WaitForPendingSamples();
+
+			WriteSamples();
+			ApplyPublishedSamples();
+
+			this->m_WritesAsynchronously = false;
+			this->m_PublishedSamples.Reset();
+			this->m_WriteCursor = FSampleBlockRing::FCursor();
+			this->m_ViewCursor = FSampleBlockRing::FCursor();
+		}
+
+		this->m_TracedActor = nullptr;
+
+		// close csv stream, iff open
+		if (this->m_CSVStream != nullptr && this->m_CSVStream->IsValid() == true)
+		{
+			this->m_CSVStream->Close();
+		}
+
+		// write the last chunk and the trailer of the binary trace, iff open
+		if (this->m_TraceStream.IsValid() == true)
+		{
+			this->m_TraceStream->Close();
+			this->m_TraceRow.Empty();
+		}
+
+		// seal the samples taken since the last full chunk, then write the chunk index; the archive is paged in through a file mapping from now on
+		if (this->m_HistoryArchive.IsValid() == true)
+		{
+			const uint64 sequence = this->m_Timeline.GetSequence();
+			const uint32 numRows = (uint32)(sequence & (this->m_HistoryArchive->GetChunkLength() - 1));
+
+			if (numRows > 0)
+			{
+				if (wroteAsynchronously == true)
+					AppendStagedChunk(numRows);
+				else
+					ArchiveHistoryChunk(sequence - numRows, numRows);
+			}
+
+			this->m_HistoryArchive->Close();
+			this->m_ArchiveStaging.Empty();
+		}
+
+		this->m_State = STOPPED;
+
+		// the published samples and staging buffers are gone
+		SyncMemoryUsage();
+	}
+
+	void FTracerDataRepository::Complete()
+	{
+		if (this->m_State == COMPLETE)
+			return;
+
+		this->m_TracedActor = nullptr;
+
+#if WITH_EDITOR									
+
+		/*
+			This is kind of a hack to retrieve the actor we just traced from the editor. The original traced
+			actor pointer belongs to the PIE world instance which got cloned from the editor's.
+		*/
+		{
+			UWorld* editorWorld = GEditor->GetEditorWorldContext().World();
+			if (editorWorld != nullptr)
+			{
+				for (TActorIterator<AActor> It(editorWorld); It; ++It)
+				{
+					if (m_TracedActorFName.IsEqual(It->GetFName()) == true)
+					{
+						this->m_TracedActor = *It;
+						break;
+					}
+				}
+			}
+
+			// the editor's actor may be deleted while the session is still shown
+			if (this->m_TracedActor.IsValid() == true && TDRM != nullptr)
+				TDRM->TrackActorLifetime(this->m_TracedActor.Get());
+		}
+#endif
+		this->m_State = COMPLETE;
+	}
+	
+	void FTracerDataRepository::SetHistoryPage(int32 chunk)
+	{
+		// an imported repository has no buffered samples, its latest samples are the last page of the trace
+		if (chunk == INDEX_NONE && this->m_IsImported == true)
+			chunk = FMath::Max<int32>(0, GetNumArchivedChunks() - this->m_Timeline.GetChunksPerPage());
+
+		this->m_Timeline.SetHistoryPage(chunk);
+
+		// the previous page's buffers are released
+		RequestMemorySync();
+	}
+
+	bool FTracerDataRepository::HasTracedActor() const 
+	{ 
+		return this->m_TracedActor.IsValid(); 
+	}
+
+	void FTracerDataRepository::SelectTracedActor()
+	{
+#if WITH_EDITOR
+		AActor* tracedActor = this->m_TracedActor.Get();
+		if (tracedActor != nullptr)
+		{
+			GEditor->SelectNone(false, false, false);
+			GEditor->SelectActor(tracedActor, true, true, true, true);
+			GEditor->MoveViewportCamerasToActor({ tracedActor }, true);
+		}
+#endif
+	}
+
+	void FTracerDataRepository::ReleaseTracedActor()
+	{
+		// writes what is still pending, nothing is sampled from the actor anymore
+		Stop();
 
 		this->m_TracedActor = nullptr;
+	}
+
+	FColor FTracerDataRepository::GetNextDefaultDataSourceColor()
+	{
+		return GetNextLabelColor(this->m_NextColorStartHue, &(this->m_NextColorStartHue)).ToFColor(true);
+	}
+
+	uint64 FTracerDataRepository::MeasurePhysicalMemorySize()
+	{
+		uint64 result = this->m_Timeline.GetPhysicalMemorySize() + this->m_ArchiveStaging.GetAllocatedSize();
+
+		result += this->m_PublishedSamples.GetPhysicalMemorySize() + this->m_WriteCursor.Block.GetAllocatedSize() + this->m_ViewCursor.Block.GetAllocatedSize();
+
+		for (const auto& kvp : this->m_DataGroups)
+		{
+			for (const auto& it : kvp.Value)
+			{
+				if (it.IsValid() == true)
+				{
+					result += it->GetDataSourcePhysicalMemorySize();
+				}
+			}
+		}
 
-		// close csv stream, iff open
-		if (this->m_CSVStream != nullptr && this->m_CSVStream->IsValid() == true)
+		return result;
+	}
+
+	uint64 FTracerDataRepository::MeasureUncompressedMemorySize()
+	{
+		uint64 result = this->m_Timeline.GetUncompressedMemorySize();
+
+		for (auto& kvp : this->m_DataGroups)
 		{
-			this->m_CSVStream->Close();
+			for (auto& it : kvp.Value)
+			{
+				if (it.IsValid() == true)
+				{
+					result += it->GetDataSourceUncompressedMemorySize();
+				}
+			}
+		}
+
+		return result;
+	}
+
+	void FTracerDataRepository::SyncMemoryUsage()
+	{
+		SCOPE_CYCLE_COUNTER(STAT_SyncMemoryUsage);
+
+		this->m_MemoryAccount.Set(MeasurePhysicalMemorySize(), MeasureUncompressedMemorySize());
+		this->m_MemoryChanged = false;
+	}
+
+	void FTracerDataRepository::RequestMemorySync()
+	{
+		// no writer task touches a repository that writes synchronously
+		if (this->m_WritesAsynchronously == false)
+		{
+			SyncMemoryUsage();
+			return;
+		}
+
+		this->m_MemoryChanged = true;
+	}
+
+	void FTracerDataRepository::HandOffStreams()
+	{
+		if (this->m_CSVStream != nullptr)
+			this->m_CSVStream->HandOffIfDue();
+
+		if (this->m_TraceStream.IsValid() == true)
+			this->m_TraceStream->HandOffIfDue();
+	}
+
+	void FTracerDataRepository::EncodeHistory()
+	{
+		this->m_Timeline.EncodeHistory();
+
+		for (auto& kvp : this->m_DataGroups)
+		{
+			for (auto& it : kvp.Value)
+			{
+				if (it.IsValid() == true)
+				{
+					it->EncodeHistory();
+				}
+			}
+		}
+	}
+
+	void FTracerDataRepository::ApplyEncodedHistory()
+	{
+		this->m_Timeline.ApplyEncodedHistory();
+
+		for (auto& kvp : this->m_DataGroups)
+		{
+			for (auto& it : kvp.Value)
+			{
+				if (it.IsValid() == true)
+				{
+					it->ApplyEncodedHistory();
+				}
+			}
+		}
+
+		RequestMemorySync();
+	}
+
+	void FTracerDataRepository::ReleaseDecodedHistory()
+	{
+		this->m_Timeline.ReleaseDecodedHistory();
+
+		for (auto& kvp : this->m_DataGroups)
+		{
+			for (auto& it : kvp.Value)
+			{
+				if (it.IsValid() == true)
+				{
+					it->ReleaseDecodedHistory();
+				}
+			}
+		}
+
+		RequestMemorySync();
+	}
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	FTracerSession
+	///-------------------------------------------------------------------------------------------------
+
+	uint32 FTracerSession::m_NextSessionId { 0 };
+
+	FTracerSession::FTracerSession(FMemoryAccount* parentAccount) :
+		m_Id(m_NextSessionId++),
+		m_SampleFrequency(UStatsTracerEditorSettings::GetInstance()->UpdateFrequency),
+		m_State(TRACING),
+		m_SessionStart(FDateTime::UtcNow()),
+		m_LastAccessTime(FPlatformTime::Seconds()),
+		m_Repositories(new TTracerDataRepositoryStore()),
+		m_FrameCounter(0),
+		m_ElapsedTime(0.0),
+		m_IsCompressionApplied(false),
+		m_MemoryAccount(parentAccount),
+		m_SampleArena(MakeShared<FSampleArena, ESPMode::ThreadSafe>())
+	{
+		// the arena's pages are charged to the session rather than the sizes of the rings carved from them
+		this->m_SampleArena->BindMemoryAccount(&this->m_MemoryAccount);
+
+		this->m_AlliasName = FString::Printf(TEXT("Session #%u"), this->m_Id);
+	}
+
+	FTracerSession::~FTracerSession()
+	{
+		// the sampling and compression tasks still access the repositories
+		WaitForPendingSamples();
+		WaitForCompression();
+
+		// editor views may keep a repository alive for a moment, it must not report to this account anymore
+		for (TTracerDataRepositoryHandle& repository : *this->m_Repositories)
+		{
+			if (repository.IsValid() == true)
+			{
+				repository->GetMemoryAccount().Detach();
+			}
+		}
+
+		this->m_Repositories->Empty();
+
+		// sources kept alive by editor views keep the arena alive too
+		this->m_SampleArena->BindMemoryAccount(nullptr);
+
+		CloseOutputContainer();
+	}
+
+	TTracerDataRepositoryHandle FTracerSession::CreateTracerRepository(const FString& repositoryName, const FString& repositoryDescription, AActor* tracedActor, const bool streamToCsv, const bool autostart)
+	{
+		TTracerDataRepositoryHandle* repoHandle = this->m_Repositories->FindByKey(tracedActor->GetUniqueID());
+		if (repoHandle != nullptr)
+			return *repoHandle;
+		
+		TTracerDataRepositoryHandle repository(new FTracerDataRepository(repositoryName, repositoryDescription, tracedActor, this->AsShared(), streamToCsv, autostart));
+		this->m_Repositories->Add(tracedActor->GetUniqueID(), repository);
+
+		return repository;
+	}
+
+	void FTracerSession::DeleteTracerRepository(const uint32 repositoryId)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_RemoveRepository);
+
+		const FDenseHandle repoHandle = this->m_Repositories->GetHandle(repositoryId);
+
+		if (this->m_Repositories->IsValid(repoHandle) == true)
+		{
+			WaitForPendingSamples();
+			WaitForCompression();
+
+			// swaps the last repository into the gap, the update order of repositories is not significant
+			// the repository's account releases its memory when the repository is destroyed
+			this->m_Repositories->Remove(repoHandle);
+		}
+	}
+
+	void FTracerSession::ReleaseTracedActor(const AActor* actor)
+	{
+		if (actor == nullptr || this->m_Repositories.IsValid() == false)
+			return;
+
+		// repositories are keyed by the unique id of the actor they were created for, ids are reused so the actor is compared as well
+		TTracerDataRepositoryHandle* repository = this->m_Repositories->FindByKey(actor->GetUniqueID());
+		if (repository != nullptr && repository->IsValid() == true && (*repository)->GetTracedActor() == actor)
+		{
+			(*repository)->ReleaseTracedActor();
+			return;
+		}
+
+		// completed repositories refer to the editor's copy of their actor, which has a different id
+		if (this->m_State == COMPLETE)
+		{
+			for (TTracerDataRepositoryHandle& other : *this->m_Repositories)
+			{
+				if (other.IsValid() == true && other->GetTracedActor() == actor)
+					other->ReleaseTracedActor();
+			}
+		}
+	}
+
+	void FTracerSession::ReleaseTracedActors(const UWorld* world, const ULevel* level)
+	{
+		if (this->m_Repositories.IsValid() == false)
+			return;
+
+		for (TTracerDataRepositoryHandle& repository : *this->m_Repositories)
+		{
+			if (repository.IsValid() == false)
+				continue;
+
+			const AActor* actor = repository->GetTracedActor();
+			if (actor != nullptr && (level != nullptr ? actor->GetLevel() == level : actor->GetWorld() == world))
+				repository->ReleaseTracedActor();
+		}
+	}
+
+	void FTracerSession::StartSession()
+	{
+		this->m_SessionStart = FDateTime::UtcNow();
+
+		if (this->m_Repositories.IsValid() == true)
+		{
+			for (TTracerDataRepositoryHandle& repository : *this->m_Repositories)
+			{
+				if (repository.IsValid() == true)
+				{
+					if(repository->ShouldAutostartOnBeginPlay() == true)
+						repository->Start(this->m_SessionStart);
+				}
+			}
+		}
+	}
+
+	void FTracerSession::PauseSession()
+	{
+		if (this->m_State >= PAUSED)
+			return;
+
+		this->m_State = PAUSED;
+	}
+
+	void FTracerSession::ResumeSession()
+	{
+		if (this->m_State != PAUSED)
+			return;
+
+		this->m_State = TRACING;
+	}
+
+	void FTracerSession::UpdateSession(float DeltaTime, bool forceUpdate)
+	{
+		if (this->m_Repositories.IsValid() == true)
+		{
+			// increase elpased session time
+			this->m_ElapsedTime += DeltaTime;
+
+			SCOPE_CYCLE_COUNTER(STAT_UpdateSession);
+
+			// read on the game thread, the workers must not touch UObjects
+			const UStatsTracerEditorSettings* settings = UStatsTracerEditorSettings::GetInstance();
+			const bool useCompiledPlan = settings->UseCompiledSamplingPlan;
+
+			// each repository decides whether a sample is due at its own rate
+			this->m_DueRepositories.Reset();
+
+			for (TTracerDataRepositoryHandle& repository : *this->m_Repositories)
+			{
+				if (repository.IsValid() == true && repository->BeginUpdate(this->m_FrameCounter, this->m_ElapsedTime, this->m_State == TRACING, forceUpdate) == true)
+				{
+					this->m_DueRepositories.Add(repository.Get());
+				}
+			}
+
+			/*
+				Repositories share nothing but the output container and the file writer, both of which
+				are thread safe and keep the blocks of each stream in order. Every repository samples and
+				streams its rows on one worker, so its rows are written in the same order as before.
+			*/
+			const int32 numDue = this->m_DueRepositories.Num();
+			const int32 batchSize = FMath::Max(1, settings->ParallelUpdateBatchSize);
+			const int32 numBatches = FMath::DivideAndRoundUp(numDue, batchSize);
+
+			ParallelFor(numBatches, [this, numDue, batchSize, useCompiledPlan](int32 batch)
+			{
+				const int32 last = FMath::Min(numDue, (batch + 1) * batchSize);
+
+				for (int32 i = batch * batchSize; i < last; ++i)
+					this->m_DueRepositories[i]->SampleUpdate(this->m_FrameCounter, this->m_ElapsedTime, useCompiledPlan);
+			},
+			settings->UpdateTracersInParallel == false || numBatches < 2);
+
+			DispatchSampling();
+
+			// increase frame counter
+			this->m_FrameCounter++;
+		}
+	}
+
+	void FTracerSession::StopSession()
+	{
+		if (this->m_State >= STOPPED)
+			return;
+
+		this->m_SessionEnd = FDateTime::UtcNow();
+		MarkAccessed();
+
+		FlushPendingSamples();
+
+		if (this->m_Repositories.IsValid() == true)
+		{
+			for (TTracerDataRepositoryHandle& repository : *this->m_Repositories)
+			{
+				if (repository.IsValid() == true)
+				{
+					repository->Stop();
+				}
+			}
 		}
 
+		// all repositories wrote their last block
+		CloseOutputContainer();
+
 		this->m_State = STOPPED;
 	}
 
-	void FTracerDataRepository::Complete()
+	FSessionContainerHandle FTracerSession::GetOutputContainer()
+	{
+		if (this->m_State >= STOPPED)
+			return nullptr;
+
+		if (this->m_OutputContainer.IsValid() == false)
+			this->m_OutputContainer = MakeShareable(new FSessionContainer(GetSessionDirectoryName(this->m_SessionStart)));
+
+		return this->m_OutputContainer->IsValid() == true ? this->m_OutputContainer : nullptr;
+	}
+
+	void FTracerSession::CloseOutputContainer()
+	{
+		if (this->m_OutputContainer.IsValid() == true)
+		{
+			this->m_OutputContainer->Close();
+			this->m_OutputContainer.Reset();
+		}
+	}
+
+	bool FTracerSession::Import(const FString& path)
+	{
+		if (this->m_State != TRACING || this->m_Repositories->Num() > 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Traces can only be imported into a new session."));
+			return false;
+		}
+
+		IFileManager& FileManager = IFileManager::Get();
+
+		FString sessionPath = path;
+		FPaths::NormalizeDirectoryName(sessionPath);
+
+		TArray<FString> traceFiles;
+		if (FileManager.DirectoryExists(*sessionPath) == true)
+		{
+			TArray<FString> fileNames;
+			FileManager.FindFiles(fileNames, *FPaths::Combine(sessionPath, TEXT("*.trace")), true, false);
+			FileManager.FindFiles(fileNames, *FPaths::Combine(sessionPath, FString(TEXT("*.trace")) + FTraceFileWriter::COMPRESSED_EXTENSION), true, false);
+
+			for (const FString& fileName : fileNames)
+			{
+				// skip copies decompressed by an earlier import, the compressed trace is imported instead
+				if (fileNames.Contains(fileName + FTraceFileWriter::COMPRESSED_EXTENSION) == true)
+					continue;
+
+				traceFiles.Add(FPaths::Combine(sessionPath, fileName));
+			}
+		}
+		else
+		{
+			traceFiles.Add(sessionPath);
+		}
+
+		FDateTime recorded(0);
+		double duration = 0.0;
+
+		for (const FString& traceFile : traceFiles)
+		{
+			TArray<FTraceStream::FColumn> columns;
+
+			TUniquePtr<FHistoryArchive> trace = FHistoryArchive::OpenTrace(traceFile, columns);
+			if (trace.IsValid() == false)
+				continue;
+
+			// '<repository name>-<repository id>.trace', see FTracerDataRepository::Start
+			FString name = FPaths::GetBaseFilename(FTraceFileWriter::GetUncompressedFileName(traceFile));
+			uint32 id = 0;
+
+			FString left, right;
+			if (name.Split(TEXT("-"), &left, &right, ESearchCase::IgnoreCase, ESearchDir::FromEnd) == true && right.IsNumeric() == true)
+			{
+				name = left;
+				id = (uint32)FCString::Strtoui64(*right, nullptr, 10);
+			}
+
+			// traces of different actors may share an id once renamed
+			while (this->m_Repositories->Contains(id) == true)
+				id++;
+
+			TTracerDataRepositoryHandle repository(new FTracerDataRepository(name, id, this->AsShared(), MoveTemp(trace), columns));
+			this->m_Repositories->Add(id, repository);
+
+			// the repository shows the last page, its last entry is the end of the trace
+			const FTracerTimeline& timeline = repository->GetTimeline();
+			if (timeline.IsPaged() == true)
+				duration = FMath::Max(duration, timeline.GetPagedElapsedTime(timeline.GetPagedCount() - 1));
+
+			const FDateTime timeStamp = FileManager.GetTimeStamp(*traceFile);
+			if (timeStamp > recorded)
+				recorded = timeStamp;
+		}
+
+		if (this->m_Repositories->Num() == 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("No trace could be imported from '%s'!"), *path);
+			return false;
+		}
+
+		this->m_SessionEnd = recorded;
+		this->m_SessionStart = recorded - FTimespan::FromSeconds(duration);
+		this->m_ElapsedTime = duration;
+
+		this->m_AlliasName = FString::Printf(TEXT("Imported %s"), *FPaths::GetCleanFilename(sessionPath));
+		this->m_State = COMPLETE;
+
+		return true;
+	}
+
+	void FTracerSession::EndSession()
 	{
 		if (this->m_State == COMPLETE)
 			return;
 
-		this->m_TracedActor = nullptr;
-
-#if WITH_EDITOR									
+		StopSession();
+	
 
-		/*
-			This is kind of a hack to retrieve the actor we just traced from the editor. The original traced
-			actor pointer belongs to the PIE world instance which got cloned from the editor's.
-		*/
+		if (this->m_Repositories.IsValid() == true)
 		{
-			UWorld* editorWorld = GEditor->GetEditorWorldContext().World();
-			if (editorWorld != nullptr)
+			for (TTracerDataRepositoryHandle& repository : *this->m_Repositories)
 			{
-				for (TActorIterator<AActor> It(editorWorld); It; ++It)
+				if (repository.IsValid() == true)
 				{
-					if (m_TracedActorFName.IsEqual(It->GetFName()) == true)
-					{
-						this->m_TracedActor = *It;
-						break;
-					}
+					repository->Complete();
 				}
 			}
 		}
-#endif
-		this->m_State = COMPLETE;
-	}
-	
-	bool FTracerDataRepository::HasTracedActor() const 
-	{ 
-		return (this->m_TracedActor != nullptr && this->m_TracedActor->IsValidLowLevel()); 
-	}
 
-	void FTracerDataRepository::SelectTracedActor()
-	{
-#if WITH_EDITOR
-		if (this->m_TracedActor != nullptr && this->m_TracedActor->IsValidLowLevel() == true)
-		{
-			GEditor->SelectNone(false, false, false);
-			GEditor->SelectActor(this->m_TracedActor, true, true, true, true);
-			GEditor->MoveViewportCamerasToActor({ this->m_TracedActor }, true);
-		}
-#endif
-	}
+		this->m_State = COMPLETE;
 
-	FColor FTracerDataRepository::GetNextDefaultDataSourceColor()
-	{
-		return GetNextLabelColor(this->m_NextColorStartHue, &(this->m_NextColorStartHue)).ToFColor(true);
+		if (UStatsTracerEditorSettings::GetInstance()->CompressCompletedSessions == true)
+			CompressSession();
 	}
 
-	uint64 FTracerDataRepository::GetRepositoryPhysicalMemorySize()
+	void FTracerSession::CompressSession()
 	{
-		uint64 result = 0;
+		if (this->m_CompressionTask.IsValid() == true || this->m_Repositories.IsValid() == false)
+			return;
 
-		for (auto kvp : this->m_DataGroups)
+		/*
+			Repositories are captured by raw pointer, they are kept alive by the session, which waits 
+			for the task before deleting any of them. Completed repositories are not sampled anymore, 
+			so the worker only reads while the editor views keep reading the raw samples, too.
+		*/
+		TArray<FTracerDataRepository*> repositories;
+		for (TTracerDataRepositoryHandle& repository : *this->m_Repositories)
 		{
-			for (auto it : kvp.Value)
+			if (repository.IsValid() == true)
 			{
-				if (it.IsValid() == true)
-				{
-					result += it->GetDataSourcePhysicalMemorySize();
-				}
+				repositories.Add(repository.Get());
 			}
 		}
 
-		return result;
-	}
-
-	///-------------------------------------------------------------------------------------------------
-	/// Class:	FTracerSession
-	///-------------------------------------------------------------------------------------------------
+		if (repositories.Num() == 0)
+			return;
 
-	uint32 FTracerSession::m_NextSessionId { 0 };
+		this->m_CompressionTask = FFunctionGraphTask::CreateAndDispatchWhenReady([repositories]()
+		{
+			SCOPE_CYCLE_COUNTER(STAT_CompressSession);
 
-	FTracerSession::FTracerSession() :
-		m_Id(m_NextSessionId++),
-		m_SampleFrequency(UStatsTracerEditorSettings::GetInstance()->UpdateFrequency),
-		m_State(TRACING),
-		m_SessionStart(FDateTime::UtcNow()),
-		m_RepositoryMap(new TTracerDataRepositoryMap()),
-		m_FrameCounter(0),
-		m_ElapsedTime(0.0f)
-	{
-		this->m_AlliasName = FString::Printf(TEXT("Session #%u"), this->m_Id);
-	}
+			for (FTracerDataRepository* repository : repositories)
+				repository->EncodeHistory();
+		},
+		TStatId(), nullptr, ENamedThreads::AnyBackgroundThreadNormalTask);
 
-	FTracerSession::~FTracerSession()
-	{
-		this->m_RepositoryMap->Empty();
+		// swap in the compressed history on the game thread, the session might be gone by then
+		const uint32 sessionId = this->m_Id;
+		FFunctionGraphTask::CreateAndDispatchWhenReady([sessionId]()
+		{
+			if (StatsTracer::TDRM != nullptr)
+				StatsTracer::TDRM->ApplyCompressedSessionHistory(sessionId);
+		},
+		TStatId(), this->m_CompressionTask, ENamedThreads::GameThread);
 	}
 
-	TTracerDataRepositoryHandle FTracerSession::CreateTracerRepository(const FString& repositoryName, const FString& repositoryDescription, AActor* tracedActor, const bool streamToCsv, const bool autostart)
+	void FTracerSession::ApplyCompressedHistory()
 	{
-		TTracerDataRepositoryHandle* repoHandle = this->m_RepositoryMap->Find(tracedActor->GetUniqueID());
-		if (repoHandle != nullptr)
-			return *repoHandle;
-		
-		return this->m_RepositoryMap->Add(tracedActor->GetUniqueID(), TTracerDataRepositoryHandle(new FTracerDataRepository(repositoryName, repositoryDescription, tracedActor, this->AsShared(), streamToCsv, autostart)));
-	}
+		if (this->m_CompressionTask.IsValid() == false || this->m_IsCompressionApplied == true || this->m_Repositories.IsValid() == false)
+			return;
 
-	void FTracerSession::DeleteTracerRepository(const uint32 repositoryId)
-	{
-		SCOPE_CYCLE_COUNTER(STAT_RemoveRepository);
+		WaitForCompression();
 
-		TTracerDataRepositoryHandle* repoHandle = this->m_RepositoryMap->Find(repositoryId);
+		this->m_IsCompressionApplied = true;
 
-		if (repoHandle != nullptr)
+		for (TTracerDataRepositoryHandle& repository : *this->m_Repositories)
 		{
-			this->m_RepositoryMap->Remove(repositoryId);
-
-			StatsTracer::TDRM->UpdatePhysicalMemoryUsage();
+			if (repository.IsValid() == true)
+			{
+				repository->ApplyEncodedHistory();
+			}
 		}
 	}
 
-	void FTracerSession::StartSession()
+	void FTracerSession::WaitForCompression()
 	{
-		this->m_SessionStart = FDateTime::UtcNow();
-
-		if (this->m_RepositoryMap.IsValid() == true)
+		if (this->m_CompressionTask.IsValid() == true && this->m_CompressionTask->IsComplete() == false)
 		{
-			for (auto& KVP : *this->m_RepositoryMap)
-			{
-				if (KVP.Value.IsValid() == true)
-				{
-					if(KVP.Value->ShouldAutostartOnBeginPlay() == true)
-						KVP.Value->Start(this->m_SessionStart);
-				}
-			}
+			FTaskGraphInterface::Get().WaitUntilTaskCompletes(this->m_CompressionTask);
 		}
 	}
 
-	void FTracerSession::PauseSession()
+	void FTracerSession::DispatchSampling()
 	{
-		if (this->m_State >= PAUSED)
+		// still busy, the samples stay published until the next frame
+		if (this->m_SamplingTask.IsValid() == true && this->m_SamplingTask->IsComplete() == false)
 			return;
 
-		this->m_State = PAUSED;
-	}
+		/*
+			Repositories are captured by raw pointer, the session waits for the task before any of 
+			them gets deleted or stopped.
+		*/
+		TArray<FTracerDataRepository*> repositories;
+		for (TTracerDataRepositoryHandle& repository : *this->m_Repositories)
+		{
+			if (repository.IsValid() == false)
+				continue;
 
-	void FTracerSession::ResumeSession()
-	{
-		if (this->m_State != PAUSED)
+			// the writer is idle, flagged memory changes can be measured now
+			if (repository->IsMemorySyncPending() == true)
+				repository->SyncMemoryUsage();
+
+			// so are the streams, rows staged longer than the flush interval go to the file writer
+			repository->HandOffStreams();
+
+			if (repository->HasPendingWrites() == true)
+				repositories.Add(repository.Get());
+		}
+
+		if (repositories.Num() == 0)
 			return;
 
-		this->m_State = TRACING;
+		this->m_SamplingTask = FFunctionGraphTask::CreateAndDispatchWhenReady([repositories]()
+		{
+			for (FTracerDataRepository* repository : repositories)
+				repository->WriteSamples();
+		},
+		TStatId(), nullptr, ENamedThreads::AnyHiPriThreadNormalTask);
 	}
 
-	void FTracerSession::UpdateSession(float DeltaTime, bool forceUpdate)
+	void FTracerSession::WaitForPendingSamples()
 	{
-		if (this->m_RepositoryMap.IsValid() == true)
+		if (this->m_SamplingTask.IsValid() == true && this->m_SamplingTask->IsComplete() == false)
 		{
-			// increase elpased session time
-			this->m_ElapsedTime += DeltaTime;
-
-			if ((this->m_FrameCounter % this->m_SampleFrequency) == 0)
-			{
-				for (auto& KVP : *this->m_RepositoryMap)
-				{
-					if (KVP.Value.IsValid() == true)
-					{
-						KVP.Value->Update(this->m_FrameCounter, this->m_ElapsedTime, forceUpdate);
-					}
-				}
-			}
-
-			// increase frame counter
-			this->m_FrameCounter++;
+			FTaskGraphInterface::Get().WaitUntilTaskCompletes(this->m_SamplingTask);
 		}
 	}
 
-	void FTracerSession::StopSession()
+	void FTracerSession::FlushPendingSamples()
 	{
-		if (this->m_State >= STOPPED)
-			return;
+		WaitForPendingSamples();
 
-		this->m_SessionEnd = FDateTime::UtcNow();
+		if (this->m_Repositories.IsValid() == false)
+			return;
 
-		if (this->m_RepositoryMap.IsValid() == true)
+		for (TTracerDataRepositoryHandle& repository : *this->m_Repositories)
 		{
-			for (auto& KVP : *this->m_RepositoryMap)
+			if (repository.IsValid() == true && repository->HasPendingWrites() == true)
 			{
-				if (KVP.Value.IsValid() == true)
-				{
-					KVP.Value->Stop();
-				}
+				repository->WriteSamples();
 			}
 		}
-
-		this->m_State = STOPPED;
 	}
 
-	void FTracerSession::EndSession()
+	void FTracerSession::ReleaseDecodedHistory()
 	{
-		if (this->m_State == COMPLETE)
+		if (this->m_Repositories.IsValid() == false)
 			return;
 
-		StopSession();
-	
-
-		if (this->m_RepositoryMap.IsValid() == true)
+		for (TTracerDataRepositoryHandle& repository : *this->m_Repositories)
 		{
-			for (auto& KVP : *this->m_RepositoryMap)
+			if (repository.IsValid() == true)
 			{
-				if (KVP.Value.IsValid() == true)
-				{
-					KVP.Value->Complete();
-				}
+				repository->ReleaseDecodedHistory();
 			}
 		}
-
-		this->m_State = COMPLETE;
 	}
 
-	uint64 FTracerSession::GetSessionPhysicalMemorySize()
+	void FTracerSession::AddDeferredDataSources()
 	{
-		uint64 result = 0;
+		if (this->m_Repositories.IsValid() == false)
+			return;
 
-		if (this->m_RepositoryMap.IsValid())
+		for (TTracerDataRepositoryHandle& repository : *this->m_Repositories)
 		{
-			for (auto& KVP : *this->m_RepositoryMap)
+			if (repository.IsValid() == true)
 			{
-				if (KVP.Value.IsValid())
-				{
-					result += KVP.Value->GetRepositoryPhysicalMemorySize();
-				}
+				repository->AddDeferredDataSources();
 			}
 		}
-
-		return result;
 	}
 
 
@@ -551,9 +2136,7 @@ namespace StatsTracer {
 	///-------------------------------------------------------------------------------------------------
 
 	FTracerDataRepositoryManager::FTracerDataRepositoryManager() :
-		m_TotalPhysicalMemorySize(0),
-		m_RatioTotalLimit(0.0f),
-		m_AvailalbeMemory(0)
+		m_ActorListener(nullptr)
 	{
 		RegisterEditorDelegates();
 	}
@@ -562,6 +2145,8 @@ namespace StatsTracer {
 	FTracerDataRepositoryManager::~FTracerDataRepositoryManager()
 	{
 		UnregisterEditorDelegates();
+		UnregisterWorldDelegates();
+		UnregisterSessionTick();
 
 		// clear all sessions
 		this->m_Sessions.Empty();
@@ -571,9 +2156,7 @@ namespace StatsTracer {
 	{
 		SCOPE_CYCLE_COUNTER(STAT_CreateSession);
 
-		UpdatePhysicalMemoryUsage();
-
-		this->m_Sessions.Add(TTracerSessionHandle(new FTracerSession()));
+		this->m_Sessions.Add(TTracerSessionHandle(new FTracerSession(&this->m_MemoryAccount)));
 	}
 
 	void FTracerDataRepositoryManager::StartActiveTracerSession()
@@ -658,7 +2241,40 @@ namespace StatsTracer {
 		if (sessionHandle->IsActiveSession() == false)
 			return nullptr;
 
-		return sessionHandle->CreateTracerRepository(repositoryName, repositoryDescription, tracedActor, streamToCsv, autostart);
+		TTracerDataRepositoryHandle repository = sessionHandle->CreateTracerRepository(repositoryName, repositoryDescription, tracedActor, streamToCsv, autostart);
+
+		if (repository.IsValid() == true)
+			TrackActorLifetime(tracedActor);
+
+		return repository;
+	}
+
+	void FTracerDataRepositoryManager::TrackActorLifetime(AActor* actor)
+	{
+		if (actor == nullptr)
+			return;
+
+		// created lazily, the manager itself is constructed before the UObject system is up
+		if (this->m_ActorListener == nullptr)
+		{
+			this->m_ActorListener = NewObject<UTracedActorListener>(GetTransientPackage());
+			this->m_ActorListener->AddToRoot();
+
+			// actors that go away with their world or a streamed out level are not necessarily destroyed one by one
+			this->m_WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &FTracerDataRepositoryManager::HandleWorldCleanup);
+			this->m_LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FTracerDataRepositoryManager::HandleLevelRemovedFromWorld);
+		}
+
+		this->m_ActorListener->Listen(actor);
+	}
+
+	void FTracerDataRepositoryManager::ReleaseTracedActor(const AActor* actor)
+	{
+		for (TTracerSessionHandle& session : this->m_Sessions)
+		{
+			if (session.IsValid() == true)
+				session->ReleaseTracedActor(actor);
+		}
 	}
 
 	void FTracerDataRepositoryManager::RemoveSession(const uint32 sessionId)
@@ -678,21 +2294,67 @@ namespace StatsTracer {
 
 		if (found == true)
 		{
+			// the session's account releases all its memory when the session is destroyed
 			this->m_Sessions[i].Reset();
 			this->m_Sessions.RemoveAt(i);
-
-			UpdatePhysicalMemoryUsage();
 		}
 	}
 	
-	void FTracerDataRepositoryManager::ConsumePhysicalMemory(uint64 memorySize)
-	{ 
-		const uint64 LIMIT_BYTES = (uint64)UStatsTracerEditorSettings::GetInstance()->PhysicalMemoryLimit * 1048576; // convert Mbytes to bytes
+	TWeakTracerSessionHandle FTracerDataRepositoryManager::ImportSession(const FString& path)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ImportSession);
+
+		TTracerSessionHandle session(new FTracerSession(&this->m_MemoryAccount));
+		if (session->Import(path) == false)
+			return TWeakTracerSessionHandle();
+
+		// the latest session is the active one, an imported session must not take its place
+		if (this->m_Sessions.Num() > 0 && this->m_Sessions.Last().IsValid() == true && this->m_Sessions.Last()->IsActiveSession() == true)
+			this->m_Sessions.Insert(session, this->m_Sessions.Num() - 1);
+		else
+			this->m_Sessions.Add(session);
 
-		this->m_TotalPhysicalMemorySize += memorySize; 
+		return session;
+	}
+
+	void FTracerDataRepositoryManager::ApplyCompressedSessionHistory(const uint32 sessionId)
+	{
+		const bool reclaiming = this->m_ReclaimingSessions.Remove(sessionId) > 0;
+
+		for (auto& S : this->m_Sessions)
+		{
+			if (S.IsValid() == true && S->GetSessionId() == sessionId)
+			{
+				const uint64 before = GetTotalPhysicalMemory();
+
+				S->ApplyCompressedHistory();
+
+				if (reclaiming == true)
+					ReportReclaim(FMemoryReclaimEvent::CompressedSession, S->GetAllias(), before);
+
+				break;
+			}
+		}
+
+		// the memory freed (or the session removed meanwhile) may make room for the deferred sources,
+		// iterates a copy as admitting a source may evict sessions
+		Sessions sessions = this->m_Sessions;
+		for (auto& S : sessions)
+		{
+			if (S.IsValid() == true)
+				S->AddDeferredDataSources();
+		}
+	}
 
-		this->m_AvailalbeMemory = LIMIT_BYTES - this->m_TotalPhysicalMemorySize;		
-		this->m_RatioTotalLimit = FMath::Clamp((float)this->m_TotalPhysicalMemorySize / FMath::Max<float>(1.0f, (float)LIMIT_BYTES), 0.0f, 1.0f);
+	void FTracerDataRepositoryManager::ReleaseDecodedHistory()
+	{
+		for (auto& S : this->m_Sessions)
+		{
+			if (S.IsValid() == true)
+			{
+				S->ReleaseDecodedHistory();
+			}
+		}
 	}
 
 	TArray<TWeakTracerSessionHandle> FTracerDataRepositoryManager::GetSessionArray()
@@ -703,27 +2365,117 @@ namespace StatsTracer {
 		return weakSessionArray;
 	}
 
-	void FTracerDataRepositoryManager::UpdatePhysicalMemoryUsage()
-	{	
+	uint64 FTracerDataRepositoryManager::GetAvailablePhysicalMemory() const
+	{
+		const uint64 LIMIT_BYTES = (uint64)UStatsTracerEditorSettings::GetInstance()->PhysicalMemoryLimit * 1048576; // convert Mbytes to bytes
+		const uint64 total = GetTotalPhysicalMemory();
+
+		return total < LIMIT_BYTES ? LIMIT_BYTES - total : 0;
+	}
+
+	float FTracerDataRepositoryManager::GetTotalLimitRatio() const
+	{
 		const uint64 LIMIT_BYTES = (uint64)UStatsTracerEditorSettings::GetInstance()->PhysicalMemoryLimit * 1048576; // convert Mbytes to bytes
 
-		SCOPE_CYCLE_COUNTER(STAT_UpdatePhysicalMemoryUsage);
+		return FMath::Clamp((float)GetTotalPhysicalMemory() / FMath::Max<float>(1.0f, (float)LIMIT_BYTES), 0.0f, 1.0f);
+	}
+
+	FTracerDataRepositoryManager::EReclaimResult FTracerDataRepositoryManager::ReclaimPhysicalMemory(uint64 requiredBytes)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ReclaimMemory);
+
+		if (GetAvailablePhysicalMemory() >= requiredBytes)
+			return Reclaimed;
 
-		this->m_TotalPhysicalMemorySize		= 0;
-		this->m_AvailalbeMemory				= LIMIT_BYTES;
+		if (UStatsTracerEditorSettings::GetInstance()->ReclaimMemory == false)
+			return ReclaimExhausted;
 
-		// loop over all stored sessions
+		// completed sessions, least recently used first
+		TArray<TTracerSessionHandle> candidates;
 		for (auto& S : this->m_Sessions)
 		{
-			// make sure session is valid
-			if (S.IsValid() == true)
+			if (S.IsValid() == true && S->IsActiveSession() == false)
+				candidates.Add(S);
+		}
+
+		candidates.StableSort([](const TTracerSessionHandle& lhs, const TTracerSessionHandle& rhs) { return lhs->GetLastAccessTime() < rhs->GetLastAccessTime(); });
+
+		// 1. decoded samples are decoded again when they are shown
+		{
+			const uint64 before = GetTotalPhysicalMemory();
+
+			for (TTracerSessionHandle& S : candidates)
+				S->ReleaseDecodedHistory();
+
+			ReportReclaim(FMemoryReclaimEvent::ReleasedDecodedHistory, FString(), before);
+
+			if (GetAvailablePhysicalMemory() >= requiredBytes)
+				return Reclaimed;
+		}
+
+		/*
+			2. compressed sessions keep all their samples. Compression runs on a worker thread, the caller
+			must not block on it (it might be an actor's BeginPlay). Only one session is compressed at a
+			time, its gain is known once the history is applied and the next one is started from there if
+			it was not enough. Nothing is evicted while a compression might still make room.
+		*/
+		for (TTracerSessionHandle& S : candidates)
+		{
+			if (S->IsCompressionPending() == true)
+				return ReclaimPending;
+		}
+
+		for (TTracerSessionHandle& S : candidates)
+		{
+			if (S->HasCompressionStarted() == true)
+				continue;
+
+			S->CompressSession();
+
+			if (S->IsCompressionPending() == true)
 			{
-				this->m_TotalPhysicalMemorySize += S->GetSessionPhysicalMemorySize();
+				this->m_ReclaimingSessions.AddUnique(S->GetSessionId());
+				return ReclaimPending;
 			}
 		}
-		
-		this->m_AvailalbeMemory = LIMIT_BYTES - this->m_TotalPhysicalMemorySize;
-		this->m_RatioTotalLimit = FMath::Clamp((float)this->m_TotalPhysicalMemorySize / FMath::Max<float>(1.0f, (float)LIMIT_BYTES), 0.0f, 1.0f);
+
+		// 3. evict, the session's account releases its memory as soon as the last reference is gone
+		for (TTracerSessionHandle& S : candidates)
+		{
+			const uint64 before = GetTotalPhysicalMemory();
+			const FString sessionName = S->GetAllias();
+			const uint32 sessionId = S->GetSessionId();
+
+			S.Reset();
+			RemoveSession(sessionId);
+
+			ReportReclaim(FMemoryReclaimEvent::EvictedSession, sessionName, before);
+
+			if (GetAvailablePhysicalMemory() >= requiredBytes)
+				return Reclaimed;
+		}
+
+		return ReclaimExhausted;
+	}
+
+	void FTracerDataRepositoryManager::ReportReclaim(FMemoryReclaimEvent::EAction action, const FString& sessionName, uint64 physicalBefore)
+	{
+		const uint64 after = GetTotalPhysicalMemory();
+
+		// evictions are always reported, the other steps only if they freed anything
+		if (action != FMemoryReclaimEvent::EvictedSession && after >= physicalBefore)
+			return;
+
+		FMemoryReclaimEvent reclaimEvent;
+		reclaimEvent.Action = action;
+		reclaimEvent.SessionName = sessionName;
+		reclaimEvent.FreedBytes = physicalBefore > after ? physicalBefore - after : 0;
+
+		UE_LOG(LogTemp, Log, TEXT("StatsTracer plugin reached memory limitation, freed %llu bytes (%s%s)."), reclaimEvent.FreedBytes,
+			action == FMemoryReclaimEvent::ReleasedDecodedHistory ? TEXT("released decoded history") : (action == FMemoryReclaimEvent::CompressedSession ? TEXT("compressed ") : TEXT("evicted ")),
+			*sessionName);
+
+		this->m_OnMemoryReclaimed.Broadcast(reclaimEvent);
 	}
 
 	/** Register Editor delegates. */
@@ -749,6 +2501,55 @@ namespace StatsTracer {
 		FEditorDelegates::SingleStepPIE.RemoveAll(this);
 	}
 
+	/** Unregister world delegates and release the actor listener. */
+	void FTracerDataRepositoryManager::UnregisterWorldDelegates()
+	{
+		FWorldDelegates::OnWorldCleanup.Remove(this->m_WorldCleanupHandle);
+		FWorldDelegates::LevelRemovedFromWorld.Remove(this->m_LevelRemovedHandle);
+
+		if (this->m_ActorListener != nullptr && UObjectInitialized() == true)
+			this->m_ActorListener->RemoveFromRoot();
+
+		this->m_ActorListener = nullptr;
+	}
+
+	void FTracerDataRepositoryManager::RegisterSessionTick(UWorld* world)
+	{
+		if (this->m_SessionTickFunction.IsValid() == false)
+			this->m_SessionTickFunction = MakeUnique<FTracerSessionTickFunction>();
+
+		this->m_SessionTickFunction->Register(world, UStatsTracerEditorSettings::GetInstance()->SamplingPhase);
+	}
+
+	void FTracerDataRepositoryManager::UnregisterSessionTick()
+	{
+		if (this->m_SessionTickFunction.IsValid() == true)
+			this->m_SessionTickFunction->Unregister();
+	}
+
+	void FTracerDataRepositoryManager::HandleWorldCleanup(UWorld* world, bool sessionEnded, bool cleanupResources)
+	{
+		// the tick function must not outlive the level it is registered with
+		if (this->m_SessionTickFunction.IsValid() == true && this->m_SessionTickFunction->GetWorld() == world)
+			UnregisterSessionTick();
+
+		for (TTracerSessionHandle& session : this->m_Sessions)
+		{
+			if (session.IsValid() == true)
+				session->ReleaseTracedActors(world, nullptr);
+		}
+	}
+
+	void FTracerDataRepositoryManager::HandleLevelRemovedFromWorld(ULevel* level, UWorld* world)
+	{
+		// no level means all levels of the world
+		for (TTracerSessionHandle& session : this->m_Sessions)
+		{
+			if (session.IsValid() == true)
+				session->ReleaseTracedActors(world, level);
+		}
+	}
+
 	void FTracerDataRepositoryManager::HandleEditorPreBeginPIE(bool bIsSimulating)
 	{
 		// create a new session
@@ -767,11 +2568,8 @@ namespace StatsTracer {
 	{
 		if (GEditor->GetPIEWorldContext() != nullptr && GEditor->GetPIEWorldContext()->World() != nullptr)
 		{
-			FActorSpawnParameters ASP;
-			ASP.ObjectFlags = EObjectFlags::RF_Standalone | EObjectFlags::RF_Transient;
-
-			// create stats tracer session runner
-			GEditor->GetPIEWorldContext()->World()->SpawnActor<AStatsTracerSessionRunner>(ASP);
+			// sample the active session in every frame of the PIE world
+			RegisterSessionTick(GEditor->GetPIEWorldContext()->World());
 		}
 		else
 		{
@@ -785,6 +2583,8 @@ namespace StatsTracer {
 
 	void FTracerDataRepositoryManager::HandleEditorEndPIE(bool bIsSimulating)
 	{
+		UnregisterSessionTick();
+
 		EndActiveTracerSession();
 	}
 
@@ -808,14 +2608,6 @@ namespace StatsTracer {
 	/// explicit template instantiation
 	///-------------------------------------------------------------------------------------------------
  
-	template class FDataSample<bool>;
-	template class FDataSample<int32>;
-	template class FDataSample<float>;
-	template class FDataSample<uint8>;
-	template class FDataSample<FVector>;
-	template class FDataSample<FRotator>;
-	template class FDataSample<FTransform>;
-
 	template class FDataSource<bool>;
 	template class FDataSource<int32>;
 	template class FDataSource<float>;
@@ -22,8 +22,18 @@ UStatsTracerEditorSettings::UStatsTracerEditorSettings(const FObjectInitializer&
 	// general
 	this->SampleWindowSize = 1024;
 	this->UpdateFrequency = 1;
+	this->SampleClock = ETracerSampleClock::Frames;
+	this->SamplingPhase = ETracerSamplingPhase::EndOfFrame;
+	this->SampleRate = 60.0f;
 	this->SessionCapacity = 10;
 	this->PhysicalMemoryLimit = 128; // 128 Mbyte
+	this->ReclaimMemory = true;
+	this->UseCompiledSamplingPlan = true;
+	this->SampleAsynchronously = true;
+	this->UpdateTracersInParallel = true;
+	this->ParallelUpdateBatchSize = 32;
+	this->CompressCompletedSessions = true;
+	this->ArchiveHistoryToDisk = false;
 
 	// visual appearance
 	this->ChartShowGrid = true;
@@ -36,6 +46,11 @@ UStatsTracerEditorSettings::UStatsTracerEditorSettings(const FObjectInitializer&
 
 	// csv settings
 	this->CsvOutputDir.Path = FString::Printf(TEXT("%s/%s"), *FDesktopPlatformModule::Get()->GetUserTempPath(), TEXT("StatsTracerPlugin"));
+	this->TraceFileFormat = ETraceFileFormat::Csv;
+	this->WriteSessionContainer = false;
+	this->TraceCompression = ETraceCompression::None;
+	this->TraceWriterBlockSize = 256; // 256 Kbyte
+	this->TraceWriterFlushInterval = 1.0f;
 
 	// 'Tracer' component
 	this->GlobalStatsFilter =
@@ -78,6 +93,7 @@ UStatsTracerEditorSettings::UStatsTracerEditorSettings(const FObjectInitializer&
 #if WITH_EDITOR
 void UStatsTracerEditorSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
-	this->SampleWindowSize = FMath::RoundUpToPowerOfTwo(this->SampleWindowSize);
+	// show the size that is actually used
+	this->SampleWindowSize = (int32)GetSampleWindowSize();
 }
 #endif
\ No newline at end of file
@@ -42,7 +42,8 @@ namespace StatsTracer {
 
 #include "Tracer.h"
 #include "TracerComponent.h"
-#include "StatsTracerSessionRunner.h"
+#include "TracerSessionTickFunction.h"
+#include "TracedActorListener.h"
 
 #include "StatsTracerBPLibrary.h"
 
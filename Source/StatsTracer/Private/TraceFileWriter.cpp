@@ -0,0 +1,523 @@
+///-------------------------------------------------------------------------------------------------
+/// File:	StatsTracer\Private\TraceFileWriter.cpp
+///
+/// Summary:	Implements the background trace file writer.
+///-------------------------------------------------------------------------------------------------
+
+#include "TraceFileWriter.h"
+#include "StatsTracerPCH.h"
+
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/RunnableThread.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+
+namespace StatsTracer {
+
+	/*
+		Compressed file layout:
+
+			header		COMPRESSED_MAGIC, COMPRESSED_VERSION, format name length, format name (ANSI)
+			frames		uncompressed size, stored size, data; one frame per block, each compressed on its
+						own. A frame whose sizes are equal is stored uncompressed.
+	*/
+
+	FTraceFileWriter* FTraceFileWriter::Instance = nullptr;
+
+	const TCHAR* FTraceFileWriter::COMPRESSED_EXTENSION = TEXT(".stz");
+
+	// upper bound of a frame, anything larger is taken for a corrupt file
+	static const uint32 MAX_FRAME_SIZE = 256 * 1024 * 1024;
+
+	/// Summary:	The compression format chosen in the settings, none if disabled or not available.
+	static FName GetCompressionFormat()
+	{
+		FName format = NAME_None;
+
+		switch (UStatsTracerEditorSettings::GetInstance()->TraceCompression)
+		{
+			case ETraceCompression::Zlib:	format = NAME_Zlib; break;
+			case ETraceCompression::Gzip:	format = NAME_Gzip; break;
+			case ETraceCompression::LZ4:	format = NAME_LZ4; break;
+			case ETraceCompression::Oodle:	format = FName(TEXT("Oodle")); break;
+			default:						return NAME_None;
+		}
+
+		if (FCompression::IsFormatValid(format) == false)
+		{
+			static bool WARNED = false;
+			if (WARNED == false)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Compression format '%s' is not available, trace files are written uncompressed."), *format.ToString());
+				WARNED = true;
+			}
+
+			return NAME_None;
+		}
+
+		return format;
+	}
+
+	/// Summary:	Reads the header of a compressed file. Returns false if the file was not written with compression.
+	static bool ReadCompressedHeader(IFileHandle& file, FName& outFormat)
+	{
+		uint32 header[3];
+		if (file.Read((uint8*)header, sizeof(header)) == false || header[0] != FTraceFileWriter::COMPRESSED_MAGIC || header[1] != FTraceFileWriter::COMPRESSED_VERSION || header[2] > 64)
+			return false;
+
+		ANSICHAR name[65] = {};
+		if (file.Read((uint8*)name, header[2]) == false)
+			return false;
+
+		outFormat = FName(ANSI_TO_TCHAR(name));
+		return FCompression::IsFormatValid(outFormat);
+	}
+
+	///-------------------------------------------------------------------------------------------------
+	/// Fn:	static void ReadCompressedFrames(IFileHandle& file, const FString& fileName, FName format, TFunctionRef<bool(const uint8*, int32)> consume)
+	///
+	/// Summary:	Decompresses the frames of a compressed file one after another and passes them to
+	/// consume. Stops at the first incomplete or corrupt frame, or if consume returns false.
+	///
+	/// Returns:	False, if consume failed.
+	///-------------------------------------------------------------------------------------------------
+
+	static bool ReadCompressedFrames(IFileHandle& file, const FString& fileName, FName format, TFunctionRef<bool(const uint8*, int32)> consume)
+	{
+		TArray<uint8> stored;
+		TArray<uint8> uncompressed;
+
+		const int64 fileSize = file.Size();
+
+		while (file.Tell() < fileSize)
+		{
+			uint32 frame[2];
+			if (file.Read((uint8*)frame, sizeof(frame)) == false || frame[0] > MAX_FRAME_SIZE || (int64)frame[1] > fileSize - file.Tell())
+			{
+				UE_LOG(LogTemp, Warning, TEXT("'%s' is incomplete, decompressed up to its last complete block."), *fileName);
+				return true;
+			}
+
+			stored.SetNumUninitialized(frame[1], false);
+			if (file.Read(stored.GetData(), frame[1]) == false)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("'%s' is incomplete, decompressed up to its last complete block."), *fileName);
+				return true;
+			}
+
+			if (frame[0] == frame[1])
+			{
+				if (consume(stored.GetData(), frame[1]) == false)
+					return false;
+
+				continue;
+			}
+
+			uncompressed.SetNumUninitialized(frame[0], false);
+			if (FCompression::UncompressMemory(format, uncompressed.GetData(), frame[0], stored.GetData(), frame[1]) == false)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("'%s' has a corrupt block, decompressed what was read before."), *fileName);
+				return true;
+			}
+
+			if (consume(uncompressed.GetData(), frame[0]) == false)
+				return false;
+		}
+
+		return true;
+	}
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	FTraceFileWriter::FFile
+	///-------------------------------------------------------------------------------------------------
+
+	FTraceFileWriter::FFile::FFile(const FString& fileName, IFileHandle* handle, int32 blockSize, FName compression) :
+		m_FileName(fileName),
+		m_BlockSize(blockSize),
+		m_Compression(compression),
+		m_Handle(handle),
+		m_Failed(0)
+	{
+		this->m_Block.Reserve(this->m_BlockSize);
+	}
+
+	FTraceFileWriter::FFile::~FFile()
+	{
+		if (this->m_Handle != nullptr)
+		{
+			delete this->m_Handle;
+			this->m_Handle = nullptr;
+		}
+	}
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	FTraceFileWriter
+	///-------------------------------------------------------------------------------------------------
+
+	FTraceFileWriter::FTraceFileWriter() :
+		m_Thread(nullptr),
+		m_WakeUp(FPlatformProcess::GetSynchEventFromPool(false)),
+		m_FlushInterval(1.0),
+		m_NextFlushTime(0.0)
+	{}
+
+	FTraceFileWriter::~FTraceFileWriter()
+	{
+		if (this->m_Thread != nullptr)
+		{
+			Stop();
+
+			this->m_Thread->WaitForCompletion();
+
+			delete this->m_Thread;
+			this->m_Thread = nullptr;
+		}
+
+		// the writer is gone, write what is left on this thread
+		TArray<FFileHandle> files;
+		{
+			FScopeLock lock(&this->m_FilesLock);
+			files = this->m_Files;
+		}
+
+		for (const FFileHandle& file : files)
+			Close(file);
+
+		FPlatformProcess::ReturnSynchEventToPool(this->m_WakeUp);
+		this->m_WakeUp = nullptr;
+	}
+
+	FTraceFileWriter& FTraceFileWriter::Get()
+	{
+		static FCriticalSection MUTEX;
+		FScopeLock LOCK_GUARD(&MUTEX);
+
+		if (Instance == nullptr)
+			Instance = new FTraceFileWriter();
+
+		return *Instance;
+	}
+
+	void FTraceFileWriter::Shutdown()
+	{
+		if (Instance != nullptr)
+		{
+			delete Instance;
+			Instance = nullptr;
+		}
+	}
+
+	FTraceFileWriter::FFileHandle FTraceFileWriter::Open(const FString& fileName)
+	{
+		const FName compression = GetCompressionFormat();
+		const FString actualFileName = compression.IsNone() == true ? fileName : fileName + COMPRESSED_EXTENSION;
+
+		IFileHandle* handle = FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*actualFileName);
+		if (handle == nullptr)
+			return nullptr;
+
+		// the header is written before the writer thread knows about the file
+		if (compression.IsNone() == false)
+		{
+			const FString formatName = compression.ToString();
+
+			const uint32 header[] { COMPRESSED_MAGIC, COMPRESSED_VERSION, (uint32)formatName.Len() };
+			handle->Write((const uint8*)header, sizeof(header));
+			handle->Write((const uint8*)TCHAR_TO_ANSI(*formatName), formatName.Len());
+		}
+
+		// the writer thread never reads the settings, they are copied whenever a file is opened
+		const UStatsTracerEditorSettings* settings = UStatsTracerEditorSettings::GetInstance();
+
+		const int32 blockSize = FMath::Max(1, settings->TraceWriterBlockSize) * 1024;
+		const double flushInterval = FMath::Max(0.01f, settings->TraceWriterFlushInterval);
+
+		FFileHandle file = MakeShareable(new FFile(actualFileName, handle, blockSize, compression));
+		{
+			FScopeLock lock(&this->m_FilesLock);
+			this->m_Files.Add(file);
+			this->m_FlushInterval = flushInterval;
+
+			// start the writer with the first file
+			if (this->m_Thread == nullptr)
+			{
+				this->m_NextFlushTime = FPlatformTime::Seconds() + flushInterval;
+				this->m_Thread = FRunnableThread::Create(this, TEXT("StatsTracerFileWriter"), 0, TPri_BelowNormal);
+			}
+		}
+
+		return file;
+	}
+
+	void FTraceFileWriter::Write(FFile& file, const void* data, int64 size)
+	{
+		if (file.IsValid() == false)
+			return;
+
+		bool handedOff = false;
+		{
+			FScopeLock lock(&file.m_Lock);
+
+			file.m_Block.Append((const uint8*)data, size);
+
+			if (file.m_Block.Num() >= file.m_BlockSize)
+			{
+				file.m_FilledBlocks.Add(MoveTemp(file.m_Block));
+				file.m_Block.Reserve(file.m_BlockSize);
+
+				handedOff = true;
+			}
+		}
+
+		if (handedOff == true)
+			this->m_WakeUp->Trigger();
+	}
+
+	void FTraceFileWriter::HandOff(FFile& file)
+	{
+		if (file.IsValid() == false)
+			return;
+
+		{
+			FScopeLock lock(&file.m_Lock);
+
+			if (file.m_Block.Num() == 0)
+				return;
+
+			file.m_FilledBlocks.Add(MoveTemp(file.m_Block));
+			file.m_Block.Reserve(file.m_BlockSize);
+		}
+
+		this->m_WakeUp->Trigger();
+	}
+
+	bool FTraceFileWriter::WriteBlocks(FFile& file, bool includePartialBlock)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_TraceWriterWriteBlocks);
+
+		FScopeLock writeLock(&file.m_WriteLock);
+
+		TArray<TArray<uint8>> blocks;
+		{
+			FScopeLock lock(&file.m_Lock);
+
+			blocks = MoveTemp(file.m_FilledBlocks);
+
+			if (includePartialBlock == true && file.m_Block.Num() > 0)
+			{
+				blocks.Add(MoveTemp(file.m_Block));
+				file.m_Block.Reserve(file.m_BlockSize);
+			}
+		}
+
+		if (blocks.Num() == 0 || file.m_Handle == nullptr)
+			return false;
+
+		WriteTakenBlocks(file, blocks);
+		return true;
+	}
+
+	void FTraceFileWriter::WriteTakenBlocks(FFile& file, const TArray<TArray<uint8>>& blocks)
+	{
+		for (const TArray<uint8>& block : blocks)
+		{
+			const bool written = file.m_Compression.IsNone() == true ? file.m_Handle->Write(block.GetData(), block.Num()) : WriteCompressedBlock(file, block);
+
+			if (written == false)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Failed to write '%s', no more data will be written to this file."), *file.m_FileName);
+
+				FPlatformAtomics::InterlockedExchange(&file.m_Failed, 1);
+
+				delete file.m_Handle;
+				file.m_Handle = nullptr;
+				return;
+			}
+		}
+
+		// one flush per batch rather than per row
+		file.m_Handle->Flush();
+	}
+
+	bool FTraceFileWriter::WriteCompressedBlock(FFile& file, const TArray<uint8>& block)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_TraceWriterCompressBlock);
+
+		int32 compressedSize = FCompression::CompressMemoryBound(file.m_Compression, block.Num());
+		file.m_Compressed.SetNumUninitialized(compressedSize, false);
+
+		// blocks that do not shrink are stored as they are
+		if (FCompression::CompressMemory(file.m_Compression, file.m_Compressed.GetData(), compressedSize, block.GetData(), block.Num()) == false || compressedSize >= block.Num())
+		{
+			const uint32 frame[] { (uint32)block.Num(), (uint32)block.Num() };
+			return file.m_Handle->Write((const uint8*)frame, sizeof(frame)) == true && file.m_Handle->Write(block.GetData(), block.Num()) == true;
+		}
+
+		const uint32 frame[] { (uint32)block.Num(), (uint32)compressedSize };
+		return file.m_Handle->Write((const uint8*)frame, sizeof(frame)) == true && file.m_Handle->Write(file.m_Compressed.GetData(), compressedSize) == true;
+	}
+
+	void FTraceFileWriter::Close(const FFileHandle& file)
+	{
+		if (file.IsValid() == false)
+			return;
+
+		{
+			FScopeLock lock(&this->m_FilesLock);
+			this->m_Files.Remove(file);
+		}
+
+		WriteBlocks(*file, true);
+
+		FScopeLock writeLock(&file->m_WriteLock);
+
+		if (file->m_Handle != nullptr)
+		{
+			delete file->m_Handle;
+			file->m_Handle = nullptr;
+		}
+	}
+
+	void FTraceFileWriter::Flush()
+	{
+		if (Instance == nullptr)
+			return;
+
+		// called from a crash handler, any lock may be held by the crashed thread, so nothing is waited for
+		if (Instance->m_FilesLock.TryLock() == false)
+			return;
+
+		TArray<FFileHandle> files = Instance->m_Files;
+		Instance->m_FilesLock.Unlock();
+
+		for (const FFileHandle& file : files)
+		{
+			// the writer thread is writing this file right now
+			if (file->m_WriteLock.TryLock() == false)
+				continue;
+
+			// the partial block is still being appended to, only blocks already handed off are written
+			TArray<TArray<uint8>> blocks;
+			if (file->m_Lock.TryLock() == true)
+			{
+				blocks = MoveTemp(file->m_FilledBlocks);
+				file->m_Lock.Unlock();
+			}
+
+			if (blocks.Num() > 0 && file->m_Handle != nullptr)
+				WriteTakenBlocks(*file, blocks);
+
+			file->m_WriteLock.Unlock();
+		}
+	}
+
+	bool FTraceFileWriter::IsCompressedFile(const FString& fileName)
+	{
+		TUniquePtr<IFileHandle> file(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*fileName));
+		if (file.IsValid() == false)
+			return false;
+
+		FName format;
+		return ReadCompressedHeader(*file, format);
+	}
+
+	bool FTraceFileWriter::DecompressFile(const FString& compressedFileName, const FString& fileName)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+		TUniquePtr<IFileHandle> file(PlatformFile.OpenRead(*compressedFileName));
+
+		FName format;
+		if (file.IsValid() == false || ReadCompressedHeader(*file, format) == false)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("'%s' is not a compressed trace file or its compression format is not available!"), *compressedFileName);
+			return false;
+		}
+
+		const FString outputFileName = fileName.IsEmpty() == true ? GetUncompressedFileName(compressedFileName) : fileName;
+
+		TUniquePtr<IFileHandle> output(PlatformFile.OpenWrite(*outputFileName));
+		if (output.IsValid() == false)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to open '%s'!"), *outputFileName);
+			return false;
+		}
+
+		return ReadCompressedFrames(*file, compressedFileName, format, [&output](const uint8* data, int32 size)
+		{
+			return output->Write(data, size);
+		});
+	}
+
+	bool FTraceFileWriter::LoadFile(const FString& fileName, TArray<uint8>& outData)
+	{
+		{
+			TUniquePtr<IFileHandle> file(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*fileName));
+			if (file.IsValid() == false)
+				return false;
+
+			FName format;
+			if (ReadCompressedHeader(*file, format) == true)
+			{
+				outData.Reset();
+
+				return ReadCompressedFrames(*file, fileName, format, [&outData](const uint8* data, int32 size)
+				{
+					outData.Append(data, size);
+					return true;
+				});
+			}
+		}
+
+		return FFileHelper::LoadFileToArray(outData, *fileName);
+	}
+
+	FString FTraceFileWriter::GetUncompressedFileName(const FString& fileName)
+	{
+		if (fileName.EndsWith(COMPRESSED_EXTENSION) == true)
+			return fileName.LeftChop(FCString::Strlen(COMPRESSED_EXTENSION));
+
+		return fileName;
+	}
+
+	uint32 FTraceFileWriter::Run()
+	{
+		while (this->m_StopRequested.GetValue() == 0)
+		{
+			double flushInterval = 0.0;
+			{
+				FScopeLock lock(&this->m_FilesLock);
+				flushInterval = this->m_FlushInterval;
+			}
+
+			// woken up early whenever a block is handed off
+			this->m_WakeUp->Wait((uint32)(flushInterval * 1000.0));
+
+			// partially filled blocks are written once per flush interval
+			const double now = FPlatformTime::Seconds();
+			const bool flushPartialBlocks = now >= this->m_NextFlushTime;
+
+			if (flushPartialBlocks == true)
+				this->m_NextFlushTime = now + flushInterval;
+
+			TArray<FFileHandle> files;
+			{
+				FScopeLock lock(&this->m_FilesLock);
+				files = this->m_Files;
+			}
+
+			for (const FFileHandle& file : files)
+				WriteBlocks(*file, flushPartialBlocks);
+		}
+
+		return 0;
+	}
+
+	void FTraceFileWriter::Stop()
+	{
+		this->m_StopRequested.Set(1);
+		this->m_WakeUp->Trigger();
+	}
+
+} // namespace StatsTracer
@@ -0,0 +1,806 @@
+///-------------------------------------------------------------------------------------------------
+/// File:	StatsTracer\Private\TraceStream.cpp
+///
+/// Summary:	Implements the binary columnar trace stream class.
+///-------------------------------------------------------------------------------------------------
+
+#include "TraceStream.h"
+#include "StatsTracerPCH.h"
+
+#include "HAL/PlatformFilemanager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace StatsTracer {
+
+	/*
+		File layout:
+
+			header		MAGIC, VERSION, chunk length, number of columns,
+						per column { type, number of components, { name length, UTF-8 name } per component }
+			records		record magic, payload size, CRC32 of the payload, payload
+			  chunk		CHUNK_MAGIC; number of rows, first and last frame (uint64), frames, elapsed times,
+						one column per traced stat, footer { min } per component, { max } per component (doubles)
+			  schema	SCHEMA_MAGIC; first frame (uint64), number of added columns, per column as in the
+						header. Chunks after it hold the added columns after the earlier ones
+			trailer		MAGIC, number of chunks, written by Close()
+
+		A column is rows * width bytes, each row holds its components back to back. bool and uint8
+		components are one byte wide, int32 and float components four bytes.
+
+		Version 1 and 2 records have neither payload size nor checksum: chunks are CHUNK_MAGIC, number of
+		rows, body; schema records (version 2) are SCHEMA_MAGIC, payload.
+	*/
+
+	// number of rows, first and last frame, the part of a chunk's payload in front of its body
+	static const uint32 CHUNK_RANGE_SIZE = sizeof(uint32) + 2 * sizeof(uint64);
+
+	static_assert(PLATFORM_LITTLE_ENDIAN, "Trace files are written in the platform's byte order, which is expected to be little-endian.");
+
+	/// Summary:	Writes floats to an unaligned column slot, returns the values as doubles for the min/max index.
+	static FORCEINLINE void WriteFloats(uint8* dest, const float* values, uint32 count, double* outValues)
+	{
+		FMemory::Memcpy(dest, values, count * sizeof(float));
+
+		for (uint32 i = 0; i < count; ++i)
+			outValues[i] = values[i];
+	}
+
+	FTraceStream::FTraceStream(const TArray<FColumn>& columns) :
+		m_Columns(columns),
+		m_NumRows(0),
+		m_NumChunks(0)
+	{
+		Layout();
+	}
+
+	void FTraceStream::Layout()
+	{
+		check(this->m_NumRows == 0);
+
+		this->m_ColumnOffsets.Reset();
+		this->m_ComponentOffsets.Reset();
+
+		// timeline columns first, then one column per traced stat
+		uint32 chunkSize = (sizeof(uint64) + sizeof(double)) * CHUNK_LENGTH;
+		uint32 numComponents = 0;
+
+		for (const FColumn& column : this->m_Columns)
+		{
+			check((uint32)column.ComponentNames.Num() == GetNumComponents(column.Type));
+
+			this->m_ColumnOffsets.Add(chunkSize);
+			this->m_ComponentOffsets.Add(numComponents);
+
+			chunkSize += GetNumComponents(column.Type) * GetComponentSize(column.Type) * CHUNK_LENGTH;
+			numComponents += GetNumComponents(column.Type);
+		}
+
+		this->m_Chunk.Reset();
+		this->m_Chunk.SetNumZeroed(chunkSize);
+		this->m_Min.Init(MAX_dbl, numComponents);
+		this->m_Max.Init(-MAX_dbl, numComponents);
+	}
+
+	FTraceStream::FTraceStream(const FString& sessionName, const FString& tracerName, const TArray<FColumn>& columns) :
+		FTraceStream(columns)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+		const FString fileDir = FPaths::Combine(UStatsTracerEditorSettings::GetInstance()->CsvOutputDir.Path, sessionName);
+
+		if (PlatformFile.CreateDirectoryTree(*fileDir) == false)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Unable to access trace output directory '%s'!"), *fileDir);
+			return;
+		}
+
+		this->m_FileName = FPaths::Combine(fileDir, FString::Printf(TEXT("%s.trace"), *tracerName));
+
+		// if there is already a file with the same name add an suffix to name
+		int32 suffix = 1;
+		while (PlatformFile.FileExists(*this->m_FileName) == true || PlatformFile.FileExists(*(this->m_FileName + FTraceFileWriter::COMPRESSED_EXTENSION)) == true)
+		{
+			this->m_FileName = FPaths::Combine(fileDir, FString::Printf(TEXT("%s-%d.trace"), *tracerName, suffix++));
+		}
+
+		if (this->m_Output.OpenFile(this->m_FileName) == false)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to open trace file '%s'!"), *this->m_FileName);
+			return;
+		}
+
+		// compression appends its extension
+		this->m_FileName = this->m_Output.GetName();
+
+		WriteHeader();
+	}
+
+	FTraceStream::FTraceStream(const FSessionContainerHandle& container, const FString& tracerName, const TArray<FColumn>& columns) :
+		FTraceStream(columns)
+	{
+		this->m_FileName = FString::Printf(TEXT("%s.trace"), *tracerName);
+
+		if (this->m_Output.OpenStream(container, this->m_FileName) == false)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to add trace stream '%s' to the session container!"), *this->m_FileName);
+			return;
+		}
+
+		WriteHeader();
+	}
+
+	void FTraceStream::WriteHeader()
+	{
+		TArray<uint8> header;
+		FMemoryWriter writer(header);
+
+		uint32 magic = MAGIC, version = VERSION, chunkLength = CHUNK_LENGTH, numColumns = (uint32)this->m_Columns.Num();
+		writer << magic << version << chunkLength << numColumns;
+
+		WriteColumns(writer, 0);
+
+		this->m_Output.Write(header.GetData(), header.Num());
+	}
+
+	void FTraceStream::WriteColumns(FArchive& writer, int32 firstColumn)
+	{
+		for (int32 i = firstColumn; i < this->m_Columns.Num(); ++i)
+		{
+			const FColumn& column = this->m_Columns[i];
+
+			uint32 type = column.Type, components = (uint32)column.ComponentNames.Num();
+			writer << type << components;
+
+			for (const FString& name : column.ComponentNames)
+			{
+				FTCHARToUTF8 utf8(*name);
+
+				uint32 length = (uint32)utf8.Length();
+				writer << length;
+				writer.Serialize((void*)utf8.Get(), length);
+			}
+		}
+	}
+
+	FTraceStream::~FTraceStream()
+	{
+		if (this->m_Output.IsOpen() == true)
+			Close();
+	}
+
+	void FTraceStream::WriteRow(uint64 frame, double elapsedTime, const uint8* row)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_TraceStreamWriteRow);
+
+		if (IsValid() == false)
+			return;
+
+		const uint32 index = this->m_NumRows;
+		uint8* chunk = this->m_Chunk.GetData();
+
+		((uint64*)chunk)[index] = frame;
+		((double*)(chunk + sizeof(uint64) * CHUNK_LENGTH))[index] = elapsedTime;
+
+		double values[9];
+
+		for (int32 i = 0; i < this->m_Columns.Num(); ++i)
+		{
+			const FColumn& column = this->m_Columns[i];
+			const uint8* data = row + column.SnapshotOffset;
+
+			const uint32 numComponents = GetNumComponents(column.Type);
+			uint8* dest = chunk + this->m_ColumnOffsets[i] + index * numComponents * GetComponentSize(column.Type);
+
+			switch ((EDataSourceType)column.Type)
+			{
+				case Bool:
+				{
+					*dest = *((const bool*)data) == true ? 1 : 0;
+					values[0] = *dest;
+					break;
+				}
+
+				case Byte:
+				{
+					*dest = *data;
+					values[0] = *dest;
+					break;
+				}
+
+				case Int:
+				{
+					int32 value;
+					FMemory::Memcpy(&value, data, sizeof(int32));
+					FMemory::Memcpy(dest, &value, sizeof(int32));
+					values[0] = value;
+					break;
+				}
+
+				case Float:
+				{
+					WriteFloats(dest, (const float*)data, 1, values);
+					break;
+				}
+
+				case Vector:
+				{
+					const FVector& value = *((const FVector*)data);
+					const float components[] { value.X, value.Y, value.Z };
+					WriteFloats(dest, components, 3, values);
+					break;
+				}
+
+				case Rotator:
+				{
+					const FRotator& value = *((const FRotator*)data);
+					const float components[] { value.Roll, value.Pitch, value.Yaw };
+					WriteFloats(dest, components, 3, values);
+					break;
+				}
+
+				case Transform:
+				{
+					const FTransform& value = *((const FTransform*)data);
+					const FVector location = value.GetLocation();
+					const FRotator rotation = value.GetRotation().Rotator();
+					const FVector scale = value.GetScale3D();
+
+					const float components[]
+					{
+						location.X, location.Y, location.Z,
+						rotation.Roll, rotation.Pitch, rotation.Yaw,
+						scale.X, scale.Y, scale.Z
+					};
+					WriteFloats(dest, components, 9, values);
+					break;
+				}
+
+				default:
+					continue;
+			}
+
+			// update the chunk's min/max index
+			const uint32 first = this->m_ComponentOffsets[i];
+			for (uint32 c = 0; c < numComponents; ++c)
+			{
+				this->m_Min[first + c] = FMath::Min(this->m_Min[first + c], values[c]);
+				this->m_Max[first + c] = FMath::Max(this->m_Max[first + c], values[c]);
+			}
+		}
+
+		if (++this->m_NumRows == CHUNK_LENGTH)
+			WriteChunk();
+	}
+
+	void FTraceStream::HandOffIfDue()
+	{
+		if (this->m_Output.IsHandOffDue() == false)
+			return;
+
+		WriteChunk();
+
+		this->m_Output.HandOff();
+	}
+
+	void FTraceStream::WriteChunk()
+	{
+		SCOPE_CYCLE_COUNTER(STAT_TraceStreamWriteChunk);
+
+		if (this->m_NumRows == 0)
+			return;
+
+		// the output failed, the staged rows have nowhere to go and are dropped
+		if (IsValid() == false)
+		{
+			ResetChunk();
+			return;
+		}
+
+		const uint32 numRows = this->m_NumRows;
+		const uint8* chunk = this->m_Chunk.GetData();
+
+		// the frame range lets readers skip chunks without reading their body
+		uint8 range[CHUNK_RANGE_SIZE];
+		FMemory::Memcpy(range, &numRows, sizeof(uint32));
+		FMemory::Memcpy(range + sizeof(uint32), chunk, sizeof(uint64));
+		FMemory::Memcpy(range + sizeof(uint32) + sizeof(uint64), chunk + sizeof(uint64) * (numRows - 1), sizeof(uint64));
+
+		FPayload payload;
+		payload.Emplace(range, CHUNK_RANGE_SIZE);
+		payload.Emplace(chunk, sizeof(uint64) * numRows);
+		payload.Emplace(chunk + sizeof(uint64) * CHUNK_LENGTH, sizeof(double) * numRows);
+
+		for (int32 i = 0; i < this->m_Columns.Num(); ++i)
+		{
+			const uint32 width = GetNumComponents(this->m_Columns[i].Type) * GetComponentSize(this->m_Columns[i].Type);
+			payload.Emplace(chunk + this->m_ColumnOffsets[i], width * numRows);
+		}
+
+		payload.Emplace(this->m_Min.GetData(), this->m_Min.Num() * sizeof(double));
+		payload.Emplace(this->m_Max.GetData(), this->m_Max.Num() * sizeof(double));
+
+		WriteRecord(CHUNK_MAGIC, payload);
+
+		this->m_NumChunks++;
+
+		ResetChunk();
+	}
+
+	void FTraceStream::ResetChunk()
+	{
+		this->m_NumRows = 0;
+
+		for (int32 i = 0; i < this->m_Min.Num(); ++i)
+		{
+			this->m_Min[i] = MAX_dbl;
+			this->m_Max[i] = -MAX_dbl;
+		}
+	}
+
+	void FTraceStream::WriteRecord(uint32 magic, const FPayload& payload)
+	{
+		uint32 size = 0;
+		uint32 checksum = 0;
+
+		for (const TPair<const void*, uint32>& piece : payload)
+		{
+			size += piece.Value;
+			checksum = FCrc::MemCrc32(piece.Key, (int32)piece.Value, checksum);
+		}
+
+		const uint32 header[] { magic, size, checksum };
+		this->m_Output.Write(header, sizeof(header));
+
+		for (const TPair<const void*, uint32>& piece : payload)
+			this->m_Output.Write(piece.Key, piece.Value);
+	}
+
+	void FTraceStream::ExtendColumns(uint64 frame, const TArray<FColumn>& columns)
+	{
+		check(columns.Num() >= this->m_Columns.Num());
+
+		const int32 numColumns = this->m_Columns.Num();
+
+		// the snapshot layout changes with every source added to the sampling plan
+		for (int32 i = 0; i < numColumns; ++i)
+			this->m_Columns[i].SnapshotOffset = columns[i].SnapshotOffset;
+
+		if (columns.Num() == numColumns)
+			return;
+
+		// rows staged so far are written with the old columns
+		WriteChunk();
+
+		for (int32 i = numColumns; i < columns.Num(); ++i)
+			this->m_Columns.Add(columns[i]);
+
+		Layout();
+
+		if (IsValid() == false)
+			return;
+
+		TArray<uint8> record;
+		FMemoryWriter writer(record);
+
+		uint32 numAdded = (uint32)(columns.Num() - numColumns);
+		writer << frame << numAdded;
+
+		WriteColumns(writer, numColumns);
+
+		FPayload payload;
+		payload.Emplace(record.GetData(), (uint32)record.Num());
+
+		WriteRecord(SCHEMA_MAGIC, payload);
+	}
+
+	void FTraceStream::Close()
+	{
+		if (this->m_Output.IsOpen() == false)
+			return;
+
+		WriteChunk();
+
+		const uint32 trailer[] { MAGIC, this->m_NumChunks };
+		this->m_Output.Write(trailer, sizeof(trailer));
+
+		this->m_Output.Close();
+	}
+
+	uint32 FTraceStream::GetNumComponents(uint32 type)
+	{
+		switch ((EDataSourceType)type)
+		{
+			case Vector:
+			case Rotator:	return 3;
+			case Transform:	return 9;
+			default:		return 1;
+		}
+	}
+
+	uint32 FTraceStream::GetComponentSize(uint32 type)
+	{
+		switch ((EDataSourceType)type)
+		{
+			case Bool:
+			case Byte:		return sizeof(uint8);
+			case Int:		return sizeof(int32);
+			default:		return sizeof(float);
+		}
+	}
+
+	///-------------------------------------------------------------------------------------------------
+	/// Fn:	static bool ReadColumns(const uint8*& cursor, const uint8* end, uint32 numColumns, TArray<FTraceStream::FColumn>& outColumns)
+	///
+	/// Summary:	Reads the schema of numColumns columns (see FTraceStream::WriteColumns) and
+	/// appends them to outColumns.
+	///
+	/// Returns:	False, if the schema is corrupt.
+	///-------------------------------------------------------------------------------------------------
+
+	static bool ReadColumns(const uint8*& cursor, const uint8* end, uint32 numColumns, TArray<FTraceStream::FColumn>& outColumns)
+	{
+		auto Read = [&cursor, end](void* dest, int64 size)
+		{
+			if (end - cursor < size)
+				return false;
+
+			FMemory::Memcpy(dest, cursor, size);
+			cursor += size;
+			return true;
+		};
+
+		for (uint32 i = 0; i < numColumns; ++i)
+		{
+			FTraceStream::FColumn& column = outColumns.AddDefaulted_GetRef();
+			column.SnapshotOffset = 0;
+
+			uint32 components = 0;
+			if (Read(&column.Type, sizeof(uint32)) == false || Read(&components, sizeof(uint32)) == false || components != FTraceStream::GetNumComponents(column.Type))
+				return false;
+
+			for (uint32 c = 0; c < components; ++c)
+			{
+				uint32 length = 0;
+				if (Read(&length, sizeof(uint32)) == false || end - cursor < (int64)length)
+					return false;
+
+				FUTF8ToTCHAR name((const ANSICHAR*)cursor, length);
+				column.ComponentNames.Add(FString(name.Length(), name.Get()));
+				cursor += length;
+			}
+		}
+
+		return true;
+	}
+
+	int64 FTraceStream::GetChunkSize(const TArray<FColumn>& columns, uint32 numRows)
+	{
+		// timeline, columns, footer
+		int64 chunkSize = (sizeof(uint64) + sizeof(double)) * (int64)numRows;
+
+		for (const FColumn& column : columns)
+		{
+			chunkSize += GetNumComponents(column.Type) * GetComponentSize(column.Type) * (int64)numRows;
+			chunkSize += 2 * sizeof(double) * (int64)GetNumComponents(column.Type);
+		}
+
+		return chunkSize;
+	}
+
+	bool FTraceStream::ConvertToCsv(const FString& traceFileName, const FString& csvFileName)
+	{
+		TArray<uint8> trace;
+		if (FTraceFileWriter::LoadFile(traceFileName, trace) == false)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to read trace file '%s'!"), *traceFileName);
+			return false;
+		}
+
+		FTraceReader reader(trace.GetData(), trace.Num());
+
+		if (reader.ReadHeader() == false)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("'%s' is not a trace file, has an unsupported version or a corrupt header!"), *traceFileName);
+			return false;
+		}
+
+		CSVStream stream(csvFileName.IsEmpty() == true ? FPaths::ChangeExtension(FTraceFileWriter::GetUncompressedFileName(traceFileName), TEXT("csv")) : csvFileName);
+		if (stream.IsValid() == false)
+			return false;
+
+		const TArray<FColumn>& columns = reader.GetColumns();
+
+		auto WriteCsvHeader = [&stream, &columns]()
+		{
+			for (const FColumn& column : columns)
+			{
+				for (const FString& name : column.ComponentNames)
+					stream << name;
+			}
+
+			stream << CSVStream::endl;
+		};
+
+		WriteCsvHeader();
+
+		TArray<const uint8*> columnData;
+
+		for (FTraceReader::ERecord record = reader.Next(); record != FTraceReader::End; record = reader.Next())
+		{
+			// columns added while recording, written the way the repository writes them to csv
+			if (record == FTraceReader::SchemaChange)
+			{
+				stream.WriteSchemaChange(reader.GetSchemaFrame());
+				WriteCsvHeader();
+				continue;
+			}
+
+			const FTraceReader::FChunk& chunk = reader.GetChunk();
+			const uint32 numRows = chunk.NumRows;
+
+			columnData.SetNum(columns.Num());
+
+			const uint8* data = chunk.Body + (sizeof(uint64) + sizeof(double)) * numRows;
+			for (int32 i = 0; i < columns.Num(); ++i)
+			{
+				columnData[i] = data;
+				data += GetNumComponents(columns[i].Type) * GetComponentSize(columns[i].Type) * numRows;
+			}
+
+			for (uint32 row = 0; row < numRows; ++row)
+			{
+				for (int32 i = 0; i < columns.Num(); ++i)
+				{
+					const uint32 type = columns[i].Type;
+					const uint32 components = GetNumComponents(type);
+					const uint8* value = columnData[i] + row * components * GetComponentSize(type);
+
+					switch ((EDataSourceType)type)
+					{
+						case Bool:	stream << (*value != 0); break;
+						case Byte:	stream << *value; break;
+
+						case Int:
+						{
+							int32 component;
+							FMemory::Memcpy(&component, value, sizeof(int32));
+							stream << component;
+							break;
+						}
+
+						default:
+						{
+							for (uint32 c = 0; c < components; ++c)
+							{
+								float component;
+								FMemory::Memcpy(&component, value + c * sizeof(float), sizeof(float));
+								stream << component;
+							}
+							break;
+						}
+					}
+				}
+
+				stream << CSVStream::endl;
+			}
+		}
+
+		if (reader.GetNumDamagedRecords() > 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Trace file '%s' is damaged, skipped %d damaged part(s) and converted all %d intact chunks."), *traceFileName, reader.GetNumDamagedRecords(), reader.GetNumChunks());
+		}
+		else if (reader.IsComplete() == false)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Trace file '%s' is incomplete, converted what was written."), *traceFileName);
+		}
+
+		stream.Close();
+		return true;
+	}
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	FTraceReader
+	///-------------------------------------------------------------------------------------------------
+
+	FTraceReader::FTraceReader(const uint8* data, int64 size, bool deferChunkChecks) :
+		m_Cursor(data),
+		m_End(data + size),
+		m_Version(0),
+		m_ChunkLength(0),
+		m_SchemaFrame(0),
+		m_FirstAddedColumn(INDEX_NONE),
+		m_NumChunks(0),
+		m_NumDamagedRecords(0),
+		m_IsComplete(false),
+		m_DeferChunkChecks(deferChunkChecks)
+	{
+		FMemory::Memzero(this->m_Chunk);
+	}
+
+	bool FTraceReader::ReadHeader()
+	{
+		uint32 header[4];
+		if (this->m_End - this->m_Cursor < (int64)sizeof(header))
+			return false;
+
+		FMemory::Memcpy(header, this->m_Cursor, sizeof(header));
+		this->m_Cursor += sizeof(header);
+
+		if (header[0] != FTraceStream::MAGIC || header[1] == 0 || header[1] > FTraceStream::VERSION || header[2] == 0)
+			return false;
+
+		this->m_Version = header[1];
+		this->m_ChunkLength = header[2];
+		this->m_Columns.Reset();
+
+		return ReadColumns(this->m_Cursor, this->m_End, header[3], this->m_Columns);
+	}
+
+	FTraceReader::ERecord FTraceReader::Next()
+	{
+		bool damaged = false;
+		ERecord result = End;
+
+		for (const uint8* record = this->m_Cursor; this->m_End - record >= (int64)sizeof(uint32); ++record)
+		{
+			uint32 marker;
+			FMemory::Memcpy(&marker, record, sizeof(uint32));
+
+			// the trailer ends a trace that was closed properly
+			if (marker == FTraceStream::MAGIC && this->m_End - record == 2 * (int64)sizeof(uint32))
+			{
+				this->m_IsComplete = true;
+				break;
+			}
+
+			// a candidate found by scanning past a damaged part is only trusted with a matching checksum
+			if (ReadRecord(record, result, this->m_DeferChunkChecks == false || record != this->m_Cursor) == true)
+				break;
+
+			result = End;
+			damaged = true;
+
+			// without checksums nothing after a damaged record can be trusted
+			if (this->m_Version < 3)
+				break;
+		}
+
+		if (damaged == true)
+			this->m_NumDamagedRecords++;
+
+		if (result == End)
+			this->m_Cursor = this->m_End;
+		else if (result == Chunk)
+			this->m_NumChunks++;
+
+		return result;
+	}
+
+	bool FTraceReader::IsIntact(const FChunk& chunk)
+	{
+		return chunk.PayloadSize == 0 || FCrc::MemCrc32(chunk.Payload, (int32)chunk.PayloadSize) == chunk.Checksum;
+	}
+
+	bool FTraceReader::ReadRecord(const uint8* record, ERecord& outRecord, bool checkChunk)
+	{
+		uint32 marker;
+		FMemory::Memcpy(&marker, record, sizeof(uint32));
+
+		if (marker != FTraceStream::CHUNK_MAGIC && marker != FTraceStream::SCHEMA_MAGIC)
+			return false;
+
+		const uint8* cursor = record + sizeof(uint32);
+		const uint8* end = this->m_End;
+
+		uint32 checksum = 0;
+
+		if (this->m_Version >= 3)
+		{
+			uint32 header[2]; // payload size, checksum
+			if (end - cursor < (int64)sizeof(header))
+				return false;
+
+			FMemory::Memcpy(header, cursor, sizeof(header));
+			cursor += sizeof(header);
+
+			if (header[0] > (uint32)MAX_int32 || end - cursor < (int64)header[0])
+				return false;
+
+			// schema records are small and always checked
+			if ((marker == FTraceStream::SCHEMA_MAGIC || checkChunk == true) && FCrc::MemCrc32(cursor, (int32)header[0]) != header[1])
+				return false;
+
+			end = cursor + header[0];
+
+			checksum = header[1];
+		}
+
+		if (marker == FTraceStream::SCHEMA_MAGIC)
+		{
+			if (ReadSchemaChange(cursor, end) == false || (this->m_Version >= 3 && cursor != end))
+				return false;
+
+			this->m_Cursor = cursor;
+			outRecord = SchemaChange;
+			return true;
+		}
+
+		FChunk chunk;
+
+		chunk.Payload = cursor;
+		chunk.PayloadSize = this->m_Version >= 3 ? (uint32)(end - cursor) : 0;
+		chunk.Checksum = checksum;
+
+		if (this->m_Version >= 3)
+		{
+			if (end - cursor < (int64)CHUNK_RANGE_SIZE)
+				return false;
+
+			FMemory::Memcpy(&chunk.NumRows, cursor, sizeof(uint32));
+			FMemory::Memcpy(&chunk.FirstFrame, cursor + sizeof(uint32), sizeof(uint64));
+			FMemory::Memcpy(&chunk.LastFrame, cursor + sizeof(uint32) + sizeof(uint64), sizeof(uint64));
+			cursor += CHUNK_RANGE_SIZE;
+		}
+		else
+		{
+			if (end - cursor < (int64)sizeof(uint32))
+				return false;
+
+			FMemory::Memcpy(&chunk.NumRows, cursor, sizeof(uint32));
+			cursor += sizeof(uint32);
+		}
+
+		if (chunk.NumRows == 0 || chunk.NumRows > this->m_ChunkLength)
+			return false;
+
+		const int64 chunkSize = FTraceStream::GetChunkSize(this->m_Columns, chunk.NumRows);
+
+		// a version 3 chunk fills its payload exactly, anything else was written with other columns
+		if (end - cursor < chunkSize || (this->m_Version >= 3 && end - cursor != chunkSize))
+			return false;
+
+		chunk.Body = cursor;
+
+		if (this->m_Version < 3)
+		{
+			FMemory::Memcpy(&chunk.FirstFrame, cursor, sizeof(uint64));
+			FMemory::Memcpy(&chunk.LastFrame, cursor + (chunk.NumRows - 1) * sizeof(uint64), sizeof(uint64));
+		}
+
+		this->m_Chunk = chunk;
+		this->m_Cursor = cursor + chunkSize;
+
+		outRecord = Chunk;
+		return true;
+	}
+
+	bool FTraceReader::ReadSchemaChange(const uint8*& cursor, const uint8* end)
+	{
+		uint32 numAdded = 0;
+		if (end - cursor < (int64)(sizeof(uint64) + sizeof(uint32)))
+			return false;
+
+		uint64 frame = 0;
+		FMemory::Memcpy(&frame, cursor, sizeof(uint64));
+		FMemory::Memcpy(&numAdded, cursor + sizeof(uint64), sizeof(uint32));
+
+		const uint8* columns = cursor + sizeof(uint64) + sizeof(uint32);
+		const int32 firstAdded = this->m_Columns.Num();
+
+		if (ReadColumns(columns, end, numAdded, this->m_Columns) == false)
+		{
+			this->m_Columns.SetNum(firstAdded);
+			return false;
+		}
+
+		cursor = columns;
+
+		this->m_SchemaFrame = frame;
+		this->m_FirstAddedColumn = firstAdded;
+		return true;
+	}
+
+} // namespace StatsTracer
@@ -0,0 +1,22 @@
+///-------------------------------------------------------------------------------------------------
+/// File:	StatsTracer\Private\TracedActorListener.cpp
+///
+/// Summary:	Implements the traced actor listener class.
+///-------------------------------------------------------------------------------------------------
+
+#include "TracedActorListener.h"
+#include "StatsTracerPCH.h"
+
+void UTracedActorListener::Listen(AActor* actor)
+{
+	if (actor == nullptr)
+		return;
+
+	actor->OnDestroyed.AddUniqueDynamic(this, &UTracedActorListener::HandleActorDestroyed);
+}
+
+void UTracedActorListener::HandleActorDestroyed(AActor* actor)
+{
+	if (StatsTracer::TDRM != nullptr)
+		StatsTracer::TDRM->ReleaseTracedActor(actor);
+}
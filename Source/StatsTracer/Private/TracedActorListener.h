@@ -0,0 +1,35 @@
+///-------------------------------------------------------------------------------------------------
+/// File:	StatsTracer\Private\TracedActorListener.h
+///
+/// Summary:	Declares the traced actor listener class.
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "TracedActorListener.generated.h"
+
+class AActor;
+
+///-------------------------------------------------------------------------------------------------
+/// Class:	UTracedActorListener
+///
+/// Summary:	Receives AActor::OnDestroyed of all traced actors and forwards it to the repository
+/// manager. The delegate is a dynamic one and needs a UObject to bind to, there is a single rooted
+/// listener owned by the manager.
+///-------------------------------------------------------------------------------------------------
+
+UCLASS(Transient)
+class UTracedActorListener : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/// Summary:	Binds the actor's OnDestroyed delegate, binding an actor twice has no effect.
+	void Listen(AActor* actor);
+
+	UFUNCTION()
+	void HandleActorDestroyed(AActor* actor);
+};
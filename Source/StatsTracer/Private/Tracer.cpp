@@ -56,13 +56,35 @@ void UTracer::StopTracer()
 		this->m_TracerDataRepository.Pin()->Stop();
 }
 
+void UTracer::SetSampleRate(const ETracerSampleClock clock, const float rate)
+{
+	if (this->m_TracerDataRepository.IsValid())
+		this->m_TracerDataRepository.Pin()->SetSampleRate(StatsTracer::FTracerSampleRate(clock, rate));
+}
+
+void UTracer::SetStatSampleRate(const FString& name, const ETracerSampleClock clock, const float rate)
+{
+	if (this->m_TracerDataRepository.IsValid())
+	{
+		StatsTracer::IDataSource* dataSource = this->m_TracerDataRepository.Pin()->FindDataSource(name);
+		if (dataSource == nullptr)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Tracer has no data source named '%s', sample rate will be ignored."), *name);
+			return;
+		}
+
+		dataSource->SetSampleRate(StatsTracer::FTracerSampleRate(clock, rate));
+	}
+}
+
 void UTracer::AddBoolStat(
 	UPARAM(ref) const bool& value,
 	const FString& name,
 	const FString& group,
 	const FString& description,
 	const FColor color,
-	const bool streamToCsv)
+	const bool streamToCsv,
+	const bool recordChangesOnly)
 {
 	if (this->m_TracerDataRepository.IsValid())
 	{
@@ -74,7 +96,8 @@ void UTracer::AddBoolStat(
 				group,
 				description,
 				color == FColor::Transparent ? pinned->GetNextDefaultDataSourceColor() : color,
-				streamToCsv));
+				streamToCsv,
+				recordChangesOnly));
 	}
 }
 
@@ -84,7 +107,8 @@ void UTracer::AddIntStat(
 	const FString& group,
 	const FString& description,
 	const FColor color,
-	const bool streamToCsv)
+	const bool streamToCsv,
+	const bool recordChangesOnly)
 {
 	if (this->m_TracerDataRepository.IsValid())
 	{
@@ -96,7 +120,8 @@ void UTracer::AddIntStat(
 				group,
 				description,
 				color == FColor::Transparent ? pinned->GetNextDefaultDataSourceColor() : color,
-				streamToCsv));
+				streamToCsv,
+				recordChangesOnly));
 	}
 }
 
@@ -128,7 +153,8 @@ void UTracer::AddByteStat(
 	const FString& group,
 	const FString& description,
 	const FColor color,
-	const bool streamToCsv)
+	const bool streamToCsv,
+	const bool recordChangesOnly)
 {
 	if (this->m_TracerDataRepository.IsValid())
 	{
@@ -140,7 +166,8 @@ void UTracer::AddByteStat(
 				group,
 				description,
 				color == FColor::Transparent ? pinned->GetNextDefaultDataSourceColor() : color,
-				streamToCsv));
+				streamToCsv,
+				recordChangesOnly));
 	}
 }
 
@@ -35,6 +35,8 @@ UTracerComponent::UTracerComponent()
 	
 	this->TracerDescription = TEXT("");
 	this->EnableStreamToCsv = false;
+	this->SampleClock = UStatsTracerEditorSettings::GetInstance()->SampleClock;
+	this->SampleRate = 0.0f;
 	this->NextColorStartHue = 0.0f;
 }
 
@@ -56,6 +58,11 @@ void UTracerComponent::BeginPlay()
 	if (tracer == nullptr)
 		return;
 
+	tracer->SetSampleRate(this->SampleClock, this->SampleRate);
+
+	// stat rates are given in the clock the tracer actually samples by
+	const ETracerSampleClock sampleClock = this->SampleRate > 0.0f ? this->SampleClock : UStatsTracerEditorSettings::GetInstance()->SampleClock;
+
 	TArray<UObject*> candidates;
 
 	// Get iterator to actors and its components perterties
@@ -99,13 +106,13 @@ void UTracerComponent::BeginPlay()
 					const FString name = (*stats)[i].AlliasName.IsEmpty() == false ? (*stats)[i].AlliasName : (*stats)[i].PropertyName;
 
 					if ((*stats)[i].PropertyType.Equals("bool"))
-						tracer->AddBoolStat(*((bool*)property->ContainerPtrToValuePtr<bool>(candidate)), name, (*stats)[i].Group, (*stats)[i].Description, (*stats)[i].Color.ToFColor(true), (*stats)[i].StreamToCsv);
+						tracer->AddBoolStat(*((bool*)property->ContainerPtrToValuePtr<bool>(candidate)), name, (*stats)[i].Group, (*stats)[i].Description, (*stats)[i].Color.ToFColor(true), (*stats)[i].StreamToCsv, (*stats)[i].RecordChangesOnly);
 					else if ((*stats)[i].PropertyType.Equals("int32"))
-						tracer->AddIntStat(*((int32*)property->ContainerPtrToValuePtr<int32>(candidate)), name, (*stats)[i].Group, (*stats)[i].Description, (*stats)[i].Color.ToFColor(true), (*stats)[i].StreamToCsv);
+						tracer->AddIntStat(*((int32*)property->ContainerPtrToValuePtr<int32>(candidate)), name, (*stats)[i].Group, (*stats)[i].Description, (*stats)[i].Color.ToFColor(true), (*stats)[i].StreamToCsv, (*stats)[i].RecordChangesOnly);
 					else if ((*stats)[i].PropertyType.Equals("float"))
 						tracer->AddFloatStat(*((float*)property->ContainerPtrToValuePtr<float>(candidate)), name, (*stats)[i].Group, (*stats)[i].Description, (*stats)[i].Color.ToFColor(true), (*stats)[i].StreamToCsv);
 					else if ((*stats)[i].PropertyType.Equals("uint8"))
-						tracer->AddByteStat(*((uint8*)property->ContainerPtrToValuePtr<uint8>(candidate)), name, (*stats)[i].Group, (*stats)[i].Description, (*stats)[i].Color.ToFColor(true), (*stats)[i].StreamToCsv);
+						tracer->AddByteStat(*((uint8*)property->ContainerPtrToValuePtr<uint8>(candidate)), name, (*stats)[i].Group, (*stats)[i].Description, (*stats)[i].Color.ToFColor(true), (*stats)[i].StreamToCsv, (*stats)[i].RecordChangesOnly);
 					else if ((*stats)[i].PropertyType.Equals("FVector"))
 						tracer->AddVectorStat(*((FVector*)property->ContainerPtrToValuePtr<FVector>(candidate)), name, (*stats)[i].Group, (*stats)[i].Description, (*stats)[i].Color.ToFColor(true), (*stats)[i].StreamToCsv);
 					else if ((*stats)[i].PropertyType.Equals("FRotator"))
@@ -113,6 +120,9 @@ void UTracerComponent::BeginPlay()
 					else if ((*stats)[i].PropertyType.Equals("FTransform"))
 						tracer->AddTransformStat(*((FTransform*)property->ContainerPtrToValuePtr<FTransform>(candidate)), name, (*stats)[i].Group, (*stats)[i].Description, (*stats)[i].Color.ToFColor(true), (*stats)[i].StreamToCsv);
 
+					if ((*stats)[i].SampleRate > 0.0f)
+						tracer->SetStatSampleRate(name, sampleClock, (*stats)[i].SampleRate);
+
 					// check next stat
 					break;
 				}
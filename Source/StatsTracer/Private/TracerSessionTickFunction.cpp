@@ -0,0 +1,70 @@
+///-------------------------------------------------------------------------------------------------
+/// File:	StatsTracer\Private\TracerSessionTickFunction.cpp
+///
+/// Summary:	Implements the tracer session tick function class.
+///-------------------------------------------------------------------------------------------------
+
+#include "TracerSessionTickFunction.h"
+#include "StatsTracerPCH.h"
+
+namespace StatsTracer {
+
+	static ETickingGroup GetSamplingTickGroup(ETracerSamplingPhase phase)
+	{
+		switch (phase)
+		{
+			case ETracerSamplingPhase::PrePhysics:		return TG_PrePhysics;
+			case ETracerSamplingPhase::PostPhysics:		return TG_PostPhysics;
+			default:									return TG_PostUpdateWork;
+		}
+	}
+
+	FTracerSessionTickFunction::FTracerSessionTickFunction() :
+		m_World(nullptr)
+	{
+		this->bCanEverTick = true;
+		this->bStartWithTickEnabled = true;
+
+		// samples are taken while the game runs only, single steps force an update themselves
+		this->bTickEvenWhenPaused = false;
+
+		// the session reads UObjects and dispatches its own worker tasks
+		this->bRunOnAnyThread = false;
+	}
+
+	void FTracerSessionTickFunction::Register(UWorld* world, ETracerSamplingPhase phase)
+	{
+		Unregister();
+
+		if (world == nullptr || world->PersistentLevel == nullptr)
+			return;
+
+		this->TickGroup = GetSamplingTickGroup(phase);
+		this->EndTickGroup = this->TickGroup;
+
+		this->m_World = world;
+		RegisterTickFunction(world->PersistentLevel);
+	}
+
+	void FTracerSessionTickFunction::Unregister()
+	{
+		if (IsTickFunctionRegistered() == true)
+			UnRegisterTickFunction();
+
+		this->m_World = nullptr;
+	}
+
+	void FTracerSessionTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+	{
+		if (TickType == LEVELTICK_ViewportsOnly || TDRM == nullptr)
+			return;
+
+		TDRM->UpdateActiveTracerSession(DeltaTime);
+	}
+
+	FString FTracerSessionTickFunction::DiagnosticMessage()
+	{
+		return TEXT("FTracerSessionTickFunction[StatsTracer]");
+	}
+
+} // namespace StatsTracer
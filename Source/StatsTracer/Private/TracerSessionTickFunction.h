@@ -0,0 +1,52 @@
+///-------------------------------------------------------------------------------------------------
+/// File:	StatsTracer\Private\TracerSessionTickFunction.h
+///
+/// Summary:	Declares the tracer session tick function class.
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "StatsTracerEditorSettings.h"
+
+namespace StatsTracer {
+
+	///-------------------------------------------------------------------------------------------------
+	/// Struct:	FTracerSessionTickFunction
+	///
+	/// Summary:	Updates the active tracer session once per frame of the world it is registered with.
+	/// It is a tick function of the world's persistent level in the tick group of the sampling phase,
+	/// so samples are taken at the same point of every frame without an actor in the world.
+	///-------------------------------------------------------------------------------------------------
+
+	struct FTracerSessionTickFunction : public FTickFunction
+	{
+	private:
+
+		UWorld*							m_World;
+
+	public:
+
+		FTracerSessionTickFunction();
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FTracerSessionTickFunction::Register(UWorld* world, ETracerSamplingPhase phase);
+		///
+		/// Summary:	Registers the tick function with the world, a previous registration is dropped.
+		///
+		/// Parameters:
+		/// world - 	The world to sample in.
+		/// phase - 	The point in the frame to sample at.
+		///-------------------------------------------------------------------------------------------------
+
+		void							Register(UWorld* world, ETracerSamplingPhase phase);
+		void							Unregister();
+
+		inline const UWorld*			GetWorld() const { return this->m_World; }
+
+		virtual void					ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+		virtual FString					DiagnosticMessage() override;
+	};
+
+} // namespace StatsTracer
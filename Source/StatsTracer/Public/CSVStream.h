@@ -14,6 +14,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "SessionContainer.h"
 
 
 
@@ -22,7 +23,10 @@ namespace StatsTracer {
 	///-------------------------------------------------------------------------------------------------
 	/// Class:	CSVStream
 	///
-	/// Summary:	A CSV stream.
+	/// Summary:	A CSV stream. Values are formatted straight into a UTF-8 row buffer, numbers without
+	/// any temporary strings, and rows are handed to the FTraceFileWriter, which does the actual file
+	/// I/O on its own thread. The rows go either to a csv file of their own or to a stream of the
+	/// session container.
 	///
 	/// Author:	Tobias Stein
 	///
@@ -31,7 +35,13 @@ namespace StatsTracer {
 
 	class CSVStream
 	{
-		static const TCHAR SEPERATOR { ',' };
+		static const ANSICHAR SEPERATOR { ',' };
+
+		// room reserved for a single formatted number, enough for '-1.17549435e-38'
+		static const int32 MAX_VALUE_LENGTH { 32 };
+
+		// initial row buffer size, the buffer keeps its allocation between rows
+		static const int32 INITIAL_BUFFER_SIZE { 4096 };
 
 	public:
 
@@ -42,20 +52,32 @@ namespace StatsTracer {
 
 	private:
 
-		IFileHandle*	m_FileHandle;
+		FTraceOutput					m_Output;
 
-		FString			m_Buffer;
+		TArray<ANSICHAR>				m_Buffer;
 
 	public:
 
 		CSVStream(const FString& sessionName, const FString& tracerName);
+
+		/// Summary:	Creates (or overwrites) the given csv file.
+		explicit CSVStream(const FString& fileName);
+
+		/// Summary:	Writes to the stream '<tracerName>.csv' of the session container.
+		CSVStream(const FSessionContainerHandle& container, const FString& tracerName);
 		~CSVStream();
 
 		void Flush();
 		void Close();
 
+		/// Summary:	Hands the rows written so far to the file writer once the flush interval passed, see FTraceOutput::HandOff.
+		void HandOffIfDue();
+
 		bool IsValid() const;
 
+		/// Summary:	Writes a comment line marking the frame from which on rows follow a new header.
+		void WriteSchemaChange(uint64 frame);
+
 		friend CSVStream& operator<<(CSVStream& stream, const CSVStream::Manipulator& mutator);
 
 		friend CSVStream& operator<<(CSVStream& stream, const FString& value);
@@ -70,6 +92,21 @@ namespace StatsTracer {
 	private:
 
 		void Write();
+
+		// returns room for one value at the end of the row buffer
+		FORCEINLINE ANSICHAR* BeginValue()
+		{
+			return this->m_Buffer.GetData() + this->m_Buffer.AddUninitialized(MAX_VALUE_LENGTH);
+		}
+
+		// trims the buffer to the value ending at 'end' and appends the separator
+		FORCEINLINE void EndValue(const ANSICHAR* end)
+		{
+			const int32 length = (int32)(end - this->m_Buffer.GetData());
+
+			this->m_Buffer.SetNum(length + 1, false);
+			this->m_Buffer[length] = SEPERATOR;
+		}
 	};
 
 } // namespace StatsTracer
\ No newline at end of file
@@ -0,0 +1,187 @@
+///-------------------------------------------------------------------------------------------------
+/// File:	StatsTracer\Public\DenseHandleArray.h
+///
+/// Summary:	Declares the dense handle array class.
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace StatsTracer {
+
+	///-------------------------------------------------------------------------------------------------
+	/// Struct:	FDenseHandle
+	///
+	/// Summary:	Stable handle of an element of a TDenseHandleArray. The slot it refers to is reused
+	/// once the element is removed, the generation tells a stale handle from the slot's new element.
+	///-------------------------------------------------------------------------------------------------
+
+	struct FDenseHandle
+	{
+		uint32							Slot;
+		uint32							Generation;
+
+		FDenseHandle() : Slot(MAX_uint32), Generation(0) {}
+		FDenseHandle(uint32 slot, uint32 generation) : Slot(slot), Generation(generation) {}
+
+		inline bool						IsSet() const { return this->Slot != MAX_uint32; }
+
+		inline bool						operator==(const FDenseHandle& other) const { return this->Slot == other.Slot && this->Generation == other.Generation; }
+		inline bool						operator!=(const FDenseHandle& other) const { return (*this == other) == false; }
+	};
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	TDenseHandleArray
+	///
+	/// Summary:	Elements stored back to back in no particular order, so iterating all of them walks
+	/// contiguous memory. Elements are addressed by generation checked handles, a slot table maps a
+	/// handle to the element's current index. Removing swaps the last element into the gap and fixes
+	/// up its slot, both in O(1). A sparse index maps each element's key (e.g. an actor's unique id)
+	/// to its handle. Elements must not be added or removed while iterating.
+	///-------------------------------------------------------------------------------------------------
+
+	template<class T>
+	class TDenseHandleArray
+	{
+		struct FSlot
+		{
+			// index of the element, INDEX_NONE while the slot is free
+			int32						Index;
+			uint32						Generation;
+		};
+
+		// dense, slot and key of each element are kept at the same index
+		TArray<T>						m_Elements;
+		TArray<uint32>					m_ElementSlots;
+		TArray<uint32>					m_ElementKeys;
+
+		TArray<FSlot>					m_Slots;
+		TArray<uint32>					m_FreeSlots;
+
+		TMap<uint32, FDenseHandle>		m_KeyIndex;
+
+	public:
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	FDenseHandle TDenseHandleArray::Add(uint32 key, const T& element)
+		///
+		/// Summary:	Appends an element, the key must not be in use yet.
+		///
+		/// Parameters:
+		/// key - 		The element's key.
+		/// element - 	The element.
+		///
+		/// Returns:	The element's handle.
+		///-------------------------------------------------------------------------------------------------
+
+		FDenseHandle Add(uint32 key, const T& element)
+		{
+			check(this->m_KeyIndex.Contains(key) == false);
+
+			uint32 slot;
+			if (this->m_FreeSlots.Num() > 0)
+			{
+				slot = this->m_FreeSlots.Pop(false);
+			}
+			else
+			{
+				slot = (uint32)this->m_Slots.Add({ INDEX_NONE, 0 });
+			}
+
+			this->m_Slots[slot].Index = this->m_Elements.Add(element);
+			this->m_ElementSlots.Add(slot);
+			this->m_ElementKeys.Add(key);
+
+			const FDenseHandle handle(slot, this->m_Slots[slot].Generation);
+			this->m_KeyIndex.Add(key, handle);
+
+			return handle;
+		}
+
+		/// Summary:	Removes the element in O(1), the last element takes its place. False if the handle is stale.
+		bool Remove(const FDenseHandle& handle)
+		{
+			if (IsValid(handle) == false)
+				return false;
+
+			FSlot& slot = this->m_Slots[handle.Slot];
+			const int32 index = slot.Index;
+
+			this->m_KeyIndex.Remove(this->m_ElementKeys[index]);
+
+			this->m_Elements.RemoveAtSwap(index, 1, false);
+			this->m_ElementSlots.RemoveAtSwap(index, 1, false);
+			this->m_ElementKeys.RemoveAtSwap(index, 1, false);
+
+			// the former last element moved into the gap
+			if (index < this->m_Elements.Num())
+				this->m_Slots[this->m_ElementSlots[index]].Index = index;
+
+			// outdates all handles of the slot
+			slot.Index = INDEX_NONE;
+			slot.Generation++;
+
+			this->m_FreeSlots.Add(handle.Slot);
+			return true;
+		}
+
+		inline bool RemoveByKey(uint32 key) { return Remove(GetHandle(key)); }
+
+		void Empty()
+		{
+			this->m_Elements.Empty();
+			this->m_ElementSlots.Empty();
+			this->m_ElementKeys.Empty();
+			this->m_Slots.Empty();
+			this->m_FreeSlots.Empty();
+			this->m_KeyIndex.Empty();
+		}
+
+		inline bool IsValid(const FDenseHandle& handle) const
+		{
+			return handle.Slot < (uint32)this->m_Slots.Num() && this->m_Slots[handle.Slot].Generation == handle.Generation && this->m_Slots[handle.Slot].Index != INDEX_NONE;
+		}
+
+		/// Summary:	The element of a handle, nullptr if the handle is stale.
+		inline T* Find(const FDenseHandle& handle)
+		{
+			return IsValid(handle) == true ? &this->m_Elements[this->m_Slots[handle.Slot].Index] : nullptr;
+		}
+
+		inline const T* Find(const FDenseHandle& handle) const
+		{
+			return IsValid(handle) == true ? &this->m_Elements[this->m_Slots[handle.Slot].Index] : nullptr;
+		}
+
+		inline T* FindByKey(uint32 key) { return Find(GetHandle(key)); }
+		inline const T* FindByKey(uint32 key) const { return Find(GetHandle(key)); }
+
+		/// Summary:	The handle of the element with the given key, an unset handle if there is none.
+		inline FDenseHandle GetHandle(uint32 key) const
+		{
+			const FDenseHandle* handle = this->m_KeyIndex.Find(key);
+			return handle != nullptr ? *handle : FDenseHandle();
+		}
+
+		inline bool Contains(uint32 key) const { return this->m_KeyIndex.Contains(key); }
+
+		inline int32 Num() const { return this->m_Elements.Num(); }
+
+		/// Summary:	All elements, back to back.
+		inline const TArray<T>& GetElements() const { return this->m_Elements; }
+
+		inline uint64 GetAllocatedSize() const
+		{
+			return this->m_Elements.GetAllocatedSize() + this->m_ElementSlots.GetAllocatedSize() + this->m_ElementKeys.GetAllocatedSize() +
+				this->m_Slots.GetAllocatedSize() + this->m_FreeSlots.GetAllocatedSize() + this->m_KeyIndex.GetAllocatedSize();
+		}
+
+		// ranged-for over the dense elements
+		inline T* begin() { return this->m_Elements.GetData(); }
+		inline T* end() { return this->m_Elements.GetData() + this->m_Elements.Num(); }
+		inline const T* begin() const { return this->m_Elements.GetData(); }
+		inline const T* end() const { return this->m_Elements.GetData() + this->m_Elements.Num(); }
+	};
+
+} // namespace StatsTracer
@@ -0,0 +1,202 @@
+///-------------------------------------------------------------------------------------------------
+/// File:	StatsTracer\Public\HistoryArchive.h
+///
+/// Summary:	Declares the disk backed history archive class.
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/MappedFileHandle.h"
+#include "TraceStream.h"
+
+class IFileHandle;
+
+namespace StatsTracer {
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	FHistoryArchive
+	///
+	/// Summary:	An append only, chunk indexed file holding the sealed history of a repository. Each
+	/// chunk stores ChunkLength timeline entries (frame numbers, elapsed times) followed by one
+	/// fixed size column per data source. Only the last chunk, sealed when recording stops, may hold
+	/// fewer rows, see GetChunkRows. Chunks are paged back in on demand, through a memory
+	/// mapping once the archive is closed, through a small read cache while it is still recording.
+	/// Chunks may be appended on a worker thread while the game thread pages in sealed chunks.
+	/// OpenTrace serves a recorded trace file the same way, read-only: the file is mapped and only
+	/// its chunk headers are read, a chunk's columns are decoded into the archive's layout when the
+	/// chunk is paged in.
+	///-------------------------------------------------------------------------------------------------
+
+	class STATSTRACER_API FHistoryArchive
+	{
+	public:
+
+		struct FColumn
+		{
+			uint32		Type;
+			uint32		SampleSize;
+		};
+
+		struct FChunkEntry
+		{
+			int64		Offset;
+			uint64		FirstFrame;
+			uint64		LastFrame;
+			uint32		NumRows;
+		};
+
+	private:
+
+		static const uint32				MAGIC { 0x41485453 }; // 'STHA'
+		static const uint32				VERSION { 2 };
+		static const int32				MAX_RESIDENT_PAGES { 4 };
+
+		struct FPage
+		{
+			int32						Chunk;
+			uint64						LastUse;
+			TArray<uint8>				Data;
+			TUniquePtr<IMappedFileRegion> Region;
+		};
+
+		FString							m_FileName;
+
+		const uint32					m_ChunkLength;
+		TArray<FColumn>					m_Columns;
+		TArray<int64>					m_ColumnOffsets; // byte offset of each column inside a chunk
+		int64							m_ChunkSize;
+
+		// byte offset of the first chunk, chunks are stored back to back
+		int64							m_DataOffset;
+
+		// written by the recording thread only, readers go through m_NumChunks
+		TArray<FChunkEntry>				m_ChunkIndex;
+		volatile int32					m_NumChunks;
+
+		IFileHandle*					m_Writer;
+
+		mutable IFileHandle*			m_Reader;
+		mutable TUniquePtr<IMappedFileHandle> m_MappedFile;
+		mutable TArray<FPage>			m_Pages;
+		mutable uint64					m_PageClock;
+
+		enum class ETraceChunkState : uint8
+		{
+			Unchecked,
+			Intact,
+			Damaged
+		};
+
+		struct FTraceChunk
+		{
+			uint32						NumColumns; // the number of columns the chunk was written with
+			int64						PayloadOffset;
+			uint32						PayloadSize;
+			uint32						Checksum;
+			ETraceChunkState			State;
+		};
+
+		/*
+			Trace mode, see OpenTrace. The whole trace is mapped (or loaded, if mapping is not supported),
+			m_ChunkIndex holds the offsets of the chunk bodies and their number of rows, a partial chunk
+			only decodes its rows, see GetChunkRows.
+			A chunk's checksum is only checked when it is paged in the first time, see PageIn.
+		*/
+		TArray<FTraceStream::FColumn>	m_TraceColumns;
+		mutable TArray<FTraceChunk>		m_TraceChunks;
+		TUniquePtr<IMappedFileRegion>	m_TraceRegion;
+		TArray<uint8>					m_TraceData;
+		const uint8*					m_Trace;
+
+		/// Summary:	Lays out the chunks, does not create any file.
+										FHistoryArchive(uint32 chunkLength, const TArray<FColumn>& columns);
+
+		void							DecodeTraceChunk(int32 chunk, uint8* dest) const;
+
+	public:
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	FHistoryArchive::FHistoryArchive(const FString& directory, const FString& name, uint32 chunkLength, const TArray<FColumn>& columns);
+		///
+		/// Summary:	Creates the archive file '<name>.history' in the given directory.
+		///
+		/// Parameters:
+		/// directory - 	The session directory.
+		/// name - 			The archive name.
+		/// chunkLength - 	The number of timeline entries per chunk.
+		/// columns - 		The data source columns.
+		///-------------------------------------------------------------------------------------------------
+
+										FHistoryArchive(const FString& directory, const FString& name, uint32 chunkLength, const TArray<FColumn>& columns);
+										~FHistoryArchive();
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FHistoryArchive::AppendChunk(const uint8* data, uint32 numRows, uint64 firstFrame, uint64 lastFrame);
+		///
+		/// Summary:	Seals a chunk, data must be GetChunkSize() bytes laid out as described by GetColumnOffset.
+		/// A partial chunk (numRows less than the chunk length) must be the last one, the archive is
+		/// to be closed right after.
+		///-------------------------------------------------------------------------------------------------
+
+		void							AppendChunk(const uint8* data, uint32 numRows, uint64 firstFrame, uint64 lastFrame);
+
+		/// Summary:	Stops recording, further page-ins are served through a memory mapping (if supported).
+		void							Close();
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	const uint8* FHistoryArchive::PageIn(int32 chunk) const;
+		///
+		/// Summary:	Returns the chunk's data. The pointer stays valid until MAX_RESIDENT_PAGES other
+		/// chunks have been paged in.
+		///
+		/// Returns:	Null if the chunk could not be read or, for a trace, does not match its checksum.
+		///-------------------------------------------------------------------------------------------------
+
+		const uint8*					PageIn(int32 chunk) const;
+
+		/// Summary:	Releases all resident pages.
+		void							ReleasePages() const;
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	static TUniquePtr<FHistoryArchive> FHistoryArchive::OpenTrace(const FString& traceFileName, TArray<FTraceStream::FColumn>& outColumns);
+		///
+		/// Summary:	Opens a trace file (see FTraceStream) as a read-only archive with one column per
+		/// traced stat. A compressed trace is decompressed next to the compressed file first. Stats
+		/// added while recording hold zero samples in the chunks written before they were added.
+		///
+		/// Parameters:
+		/// traceFileName - 	The trace file.
+		/// outColumns - 		[out] The traced stats, in archive column order.
+		///
+		/// Returns:	Null if the trace could not be read or holds no complete chunk.
+		///-------------------------------------------------------------------------------------------------
+
+		static TUniquePtr<FHistoryArchive> OpenTrace(const FString& traceFileName, TArray<FTraceStream::FColumn>& outColumns);
+
+		/// Summary:	In-memory size of a sample of the given EDataSourceType, the size of its archive column entries.
+		static uint32					GetSampleSize(uint32 type);
+
+		inline bool						IsValid() const { return this->m_Writer != nullptr || GetNumChunks() > 0; }
+		inline bool						IsRecording() const { return this->m_Writer != nullptr; }
+		inline bool						IsTrace() const { return this->m_Trace != nullptr; }
+
+		/// Summary:	Number of sealed chunks, safe to call while another thread appends chunks.
+		inline int32					GetNumChunks() const { return FPlatformAtomics::AtomicRead(&this->m_NumChunks); }
+		inline uint32					GetChunkLength() const { return this->m_ChunkLength; }
+		inline int64					GetChunkSize() const { return this->m_ChunkSize; }
+
+		/// Summary:	Number of rows of a sealed chunk. While recording every sealed chunk is full.
+		inline uint32					GetChunkRows(int32 chunk) const { return IsRecording() == true ? this->m_ChunkLength : this->m_ChunkIndex[chunk].NumRows; }
+
+		// the timeline columns come first
+		inline int64					GetFramesOffset() const { return 0; }
+		inline int64					GetElapsedTimesOffset() const { return sizeof(uint64) * this->m_ChunkLength; }
+		inline int64					GetColumnOffset(int32 column) const { return this->m_ColumnOffsets[column]; }
+
+		inline const FString&			GetFileName() const { return this->m_FileName; }
+
+		uint64							GetPhysicalMemorySize() const;
+	};
+
+} // namespace StatsTracer
@@ -0,0 +1,95 @@
+///-------------------------------------------------------------------------------------------------
+/// File:	StatsTracer\Public\MemoryAccount.h
+///
+/// Summary:	Declares the memory account class.
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace StatsTracer {
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	FMemoryAccount
+	///
+	/// Summary:	Physical and uncompressed memory of one owner (a repository, a session or the whole
+	/// plugin). Accounts form a tree, every change is added to all parent accounts as well, so any
+	/// level reads its total in O(1). Counters are atomic, accounts may be changed and read from any
+	/// thread. An account releases what it still holds when it is destroyed.
+	///-------------------------------------------------------------------------------------------------
+
+	class FMemoryAccount
+	{
+		FMemoryAccount*					m_Parent;
+
+		volatile int64					m_Physical;
+		volatile int64					m_Uncompressed;
+
+										FMemoryAccount(const FMemoryAccount&) = delete;
+										FMemoryAccount& operator=(const FMemoryAccount&) = delete;
+
+	public:
+
+		explicit FMemoryAccount(FMemoryAccount* parent = nullptr) :
+			m_Parent(parent),
+			m_Physical(0),
+			m_Uncompressed(0)
+		{}
+
+		~FMemoryAccount()
+		{
+			Detach();
+		}
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FMemoryAccount::Adjust(int64 physicalDelta, int64 uncompressedDelta)
+		///
+		/// Summary:	Adds the deltas to this account and all its parents.
+		///
+		/// Parameters:
+		/// physicalDelta - 		Bytes allocated (positive) or freed (negative).
+		/// uncompressedDelta - 	The same for the uncompressed size.
+		///-------------------------------------------------------------------------------------------------
+
+		void Adjust(int64 physicalDelta, int64 uncompressedDelta)
+		{
+			for (FMemoryAccount* account = this; account != nullptr; account = account->m_Parent)
+			{
+				FPlatformAtomics::InterlockedAdd(&account->m_Physical, physicalDelta);
+				FPlatformAtomics::InterlockedAdd(&account->m_Uncompressed, uncompressedDelta);
+			}
+		}
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FMemoryAccount::Set(uint64 physical, uint64 uncompressed)
+		///
+		/// Summary:	Replaces the sizes of this account, parents receive the difference only.
+		///
+		/// Parameters:
+		/// physical - 		The physical size in bytes.
+		/// uncompressed - 	The uncompressed size in bytes.
+		///-------------------------------------------------------------------------------------------------
+
+		void Set(uint64 physical, uint64 uncompressed)
+		{
+			const int64 physicalDelta = (int64)physical - FPlatformAtomics::InterlockedExchange(&this->m_Physical, (int64)physical);
+			const int64 uncompressedDelta = (int64)uncompressed - FPlatformAtomics::InterlockedExchange(&this->m_Uncompressed, (int64)uncompressed);
+
+			if (this->m_Parent != nullptr && (physicalDelta != 0 || uncompressedDelta != 0))
+				this->m_Parent->Adjust(physicalDelta, uncompressedDelta);
+		}
+
+		/// Summary:	Releases everything this account holds and unlinks it from its parent, e.g. before the parent is destroyed.
+		void Detach()
+		{
+			Set(0, 0);
+
+			this->m_Parent = nullptr;
+		}
+
+		inline uint64 GetPhysical() const { return (uint64)FMath::Max<int64>(0, FPlatformAtomics::AtomicRead(&this->m_Physical)); }
+		inline uint64 GetUncompressed() const { return (uint64)FMath::Max<int64>(0, FPlatformAtomics::AtomicRead(&this->m_Uncompressed)); }
+	};
+
+} // namespace StatsTracer
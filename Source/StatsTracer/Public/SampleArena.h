@@ -0,0 +1,192 @@
+///-------------------------------------------------------------------------------------------------
+/// File:	StatsTracer\Public\SampleArena.h
+///
+/// Summary:	Declares the sample arena and the arena backed array class.
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace StatsTracer {
+
+	class FMemoryAccount;
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	FSampleArena
+	///
+	/// Summary:	Page based bump allocator for the sample rings of one session. Every page counts its
+	/// live allocations and is freed as soon as the last of them is released (e.g. when a session is
+	/// compressed), destroying the arena frees all remaining pages at once. Large allocations get a
+	/// page of their own. The pages are charged to the bound memory account, see BindMemoryAccount.
+	/// Thread safe.
+	///-------------------------------------------------------------------------------------------------
+
+	class STATSTRACER_API FSampleArena
+	{
+	public:
+
+		static const uint32				PAGE_SIZE { 1024 * 1024 };
+
+		// allocations above this size do not share a page
+		static const uint32				MAX_SHARED_ALLOCATION { PAGE_SIZE / 4 };
+
+		// header of a page, its data follows in the same allocation
+		struct FPage
+		{
+			SIZE_T						Size;
+			SIZE_T						Used;
+			int32						NumLive;
+		};
+
+	private:
+
+		FCriticalSection				m_Lock;
+
+		TArray<FPage*>					m_Pages;
+
+		// the page allocations are bumped from, null until the first allocation
+		FPage*							m_CurrentPage;
+
+		uint64							m_AllocatedSize;
+
+		FMemoryAccount*					m_MemoryAccount;
+
+										FSampleArena(const FSampleArena&) = delete;
+										FSampleArena& operator=(const FSampleArena&) = delete;
+
+		FPage*							NewPage(SIZE_T dataSize);
+		void							FreePage(FPage* page);
+
+	public:
+
+										FSampleArena();
+										~FSampleArena();
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void* FSampleArena::Allocate(SIZE_T size, uint32 alignment, FPage*& outPage);
+		///
+		/// Summary:	Allocates uninitialized memory.
+		///
+		/// Parameters:
+		/// size - 			The size in bytes.
+		/// alignment - 	The alignment, at most 16.
+		/// outPage - 		[out] The page the memory belongs to, it has to be passed to Release.
+		///
+		/// Returns:	The memory.
+		///-------------------------------------------------------------------------------------------------
+
+		void*							Allocate(SIZE_T size, uint32 alignment, FPage*& outPage);
+		void							Release(FPage* page);
+
+		/// Summary:	Size of all pages, allocated or not.
+		uint64							GetAllocatedSize() const;
+
+		/// Summary:	Moves the pages' size to another account, which is charged for all further pages. May be null.
+		void							BindMemoryAccount(FMemoryAccount* account);
+	};
+
+	using FSampleArenaHandle = TSharedPtr<FSampleArena, ESPMode::ThreadSafe>;
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	TArenaArray
+	///
+	/// Summary:	Fixed size array of trivially copyable elements, allocated from a sample arena. It
+	/// keeps the arena alive while it holds memory of it. Without arena it falls back to the heap.
+	///
+	/// Typeparams:
+	/// T - 	The element type.
+	///-------------------------------------------------------------------------------------------------
+
+	template<class T>
+	class TArenaArray
+	{
+		static_assert(TIsTriviallyDestructible<T>::Value, "TArenaArray elements must be trivially destructible.");
+		static_assert(alignof(T) <= 16, "TArenaArray elements must not be aligned to more than 16 bytes.");
+
+		FSampleArenaHandle				m_Arena;
+		FSampleArena::FPage*			m_Page;
+
+		T*								m_Data;
+		int32							m_Num;
+
+										TArenaArray(const TArenaArray&) = delete;
+										TArenaArray& operator=(const TArenaArray&) = delete;
+
+		void Allocate(int32 num)
+		{
+			Empty();
+
+			if (num <= 0)
+				return;
+
+			if (this->m_Arena.IsValid() == true)
+				this->m_Data = (T*)this->m_Arena->Allocate(sizeof(T) * num, alignof(T), this->m_Page);
+			else
+				this->m_Data = (T*)FMemory::Malloc(sizeof(T) * num, alignof(T));
+
+			this->m_Num = num;
+		}
+
+	public:
+
+		TArenaArray() :
+			m_Page(nullptr),
+			m_Data(nullptr),
+			m_Num(0)
+		{}
+
+		~TArenaArray()
+		{
+			Empty();
+		}
+
+		/// Summary:	The arena of all further allocations, memory allocated already stays where it is.
+		inline void BindArena(const FSampleArenaHandle& arena) { this->m_Arena = arena; }
+
+		void Init(const T& value, int32 num)
+		{
+			Allocate(num);
+
+			for (int32 i = 0; i < num; ++i)
+				new (this->m_Data + i) T(value);
+		}
+
+		void SetNumZeroed(int32 num)
+		{
+			Allocate(num);
+
+			if (num > 0)
+				FMemory::Memzero(this->m_Data, sizeof(T) * num);
+		}
+
+		void Empty()
+		{
+			if (this->m_Data == nullptr)
+				return;
+
+			if (this->m_Page != nullptr)
+				this->m_Arena->Release(this->m_Page);
+			else
+				FMemory::Free(this->m_Data);
+
+			this->m_Page = nullptr;
+			this->m_Data = nullptr;
+			this->m_Num = 0;
+		}
+
+		inline T& operator[](int32 index) { checkSlow(index >= 0 && index < this->m_Num); return this->m_Data[index]; }
+		inline const T& operator[](int32 index) const { checkSlow(index >= 0 && index < this->m_Num); return this->m_Data[index]; }
+
+		inline T* GetData() { return this->m_Data; }
+		inline const T* GetData() const { return this->m_Data; }
+
+		inline int32 Num() const { return this->m_Num; }
+
+		inline SIZE_T GetAllocatedSize() const { return sizeof(T) * this->m_Num; }
+
+		/// Summary:	The allocated size unless it was allocated from an arena, an arena accounts for its pages itself.
+		inline SIZE_T GetHeapAllocatedSize() const { return this->m_Page == nullptr ? GetAllocatedSize() : 0; }
+	};
+
+} // namespace StatsTracer
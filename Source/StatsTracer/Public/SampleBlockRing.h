@@ -0,0 +1,219 @@
+///-------------------------------------------------------------------------------------------------
+/// File:	StatsTracer\Public\SampleBlockRing.h
+///
+/// Summary:	Declares the lock-free sample block publication ring.
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace StatsTracer {
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	FSampleBlockRing
+	///
+	/// Summary:	A single producer, multi consumer ring of fixed size sample blocks. Every published
+	/// block gets a monotonic sequence number. Each slot carries a commit counter which is odd while
+	/// the producer writes the slot and 2 * (sequence + 1) once the block is committed, consumers
+	/// check it before and after copying a block out and so detect blocks which are not published
+	/// yet or got overwritten while being read. Neither side ever takes a lock, consumers that fall
+	/// more than the capacity behind lose blocks and are told so.
+	///-------------------------------------------------------------------------------------------------
+
+	class FSampleBlockRing
+	{
+	public:
+
+		enum EReadResult
+		{
+			Ok = 0,
+			NotPublished,
+			Overwritten
+		};
+
+		/// Summary:	Read position of one consumer, consumers never share a cursor.
+		struct FCursor
+		{
+			// sequence of the next block to read
+			uint64						Next;
+
+			// number of blocks lost since the cursor was created
+			uint64						Dropped;
+
+			// copy of the current block, valid while the consumer's callback runs
+			TArray<uint8>				Block;
+
+			FCursor() : Next(0), Dropped(0) {}
+		};
+
+	private:
+
+		TArray<uint8>					m_Blocks;
+		TArray<int64>					m_Commits;
+
+		uint32							m_BlockSize;
+		uint32							m_IndexMask;
+
+		// number of published blocks, also the sequence of the next block
+		volatile int64					m_Published;
+
+	public:
+
+		FSampleBlockRing() :
+			m_BlockSize(0),
+			m_IndexMask(0),
+			m_Published(0)
+		{}
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FSampleBlockRing::Initialize(uint32 blockSize, uint32 capacity)
+		///
+		/// Summary:	(Re-)allocates the ring. Must not be called while anyone publishes or consumes.
+		///
+		/// Parameters:
+		/// blockSize - 	Size of a block in bytes.
+		/// capacity - 		Number of blocks, rounded up to a power of two.
+		///-------------------------------------------------------------------------------------------------
+
+		void Initialize(uint32 blockSize, uint32 capacity)
+		{
+			capacity = FMath::RoundUpToPowerOfTwo(FMath::Max<uint32>(capacity, 2));
+
+			this->m_BlockSize = blockSize;
+			this->m_IndexMask = capacity - 1;
+
+			this->m_Blocks.SetNumZeroed(blockSize * capacity);
+			this->m_Commits.SetNumZeroed(capacity);
+
+			FPlatformAtomics::AtomicStore(&this->m_Published, (int64)0);
+		}
+
+		void Reset()
+		{
+			this->m_Blocks.Empty();
+			this->m_Commits.Empty();
+			this->m_BlockSize = 0;
+			this->m_IndexMask = 0;
+
+			FPlatformAtomics::AtomicStore(&this->m_Published, (int64)0);
+		}
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	uint8* FSampleBlockRing::BeginPublish()
+		///
+		/// Summary:	Producer only. Marks the next slot as being written and returns it, the block
+		/// becomes visible to consumers with EndPublish.
+		///-------------------------------------------------------------------------------------------------
+
+		FORCEINLINE uint8* BeginPublish()
+		{
+			const uint64 sequence = (uint64)this->m_Published;
+			const uint32 slot = (uint32)(sequence & this->m_IndexMask);
+
+			FPlatformAtomics::AtomicStore(&this->m_Commits[slot], (int64)(sequence * 2 + 1));
+			FPlatformMisc::MemoryBarrier();
+
+			return this->m_Blocks.GetData() + slot * this->m_BlockSize;
+		}
+
+		/// Summary:	Producer only. Commits the block returned by BeginPublish.
+		FORCEINLINE void EndPublish()
+		{
+			const uint64 sequence = (uint64)this->m_Published;
+			const uint32 slot = (uint32)(sequence & this->m_IndexMask);
+
+			FPlatformMisc::MemoryBarrier();
+			FPlatformAtomics::AtomicStore(&this->m_Commits[slot], (int64)((sequence + 1) * 2));
+			FPlatformAtomics::AtomicStore(&this->m_Published, (int64)(sequence + 1));
+		}
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	EReadResult FSampleBlockRing::Read(uint64 sequence, uint8* dest) const
+		///
+		/// Summary:	Copies a published block out of the ring. Safe to call from any thread.
+		///
+		/// Parameters:
+		/// sequence - 	The block's sequence number.
+		/// dest - 		[out] GetBlockSize() bytes, undefined unless Ok is returned.
+		///-------------------------------------------------------------------------------------------------
+
+		EReadResult Read(uint64 sequence, uint8* dest) const
+		{
+			const uint32 slot = (uint32)(sequence & this->m_IndexMask);
+			const int64 committed = (int64)((sequence + 1) * 2);
+
+			const int64 before = FPlatformAtomics::AtomicRead(&this->m_Commits[slot]);
+			if (before != committed)
+				return before < committed ? NotPublished : Overwritten;
+
+			FPlatformMisc::MemoryBarrier();
+			FMemory::Memcpy(dest, this->m_Blocks.GetData() + slot * this->m_BlockSize, this->m_BlockSize);
+			FPlatformMisc::MemoryBarrier();
+
+			// the producer lapped us while copying
+			if (FPlatformAtomics::AtomicRead(&this->m_Commits[slot]) != before)
+				return Overwritten;
+
+			return Ok;
+		}
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	template<class Func> int32 FSampleBlockRing::Consume(FCursor& cursor, Func&& func) const
+		///
+		/// Summary:	Hands all blocks published since the cursor's last call to func(sequence, block),
+		/// oldest first. Blocks the producer overwrote before they could be read are skipped and
+		/// counted in cursor.Dropped.
+		///
+		/// Returns:	The number of consumed blocks.
+		///-------------------------------------------------------------------------------------------------
+
+		template<class Func>
+		int32 Consume(FCursor& cursor, Func&& func) const
+		{
+			const uint64 published = GetPublishedCount();
+			const uint64 capacity = (uint64)this->m_IndexMask + 1;
+
+			cursor.Block.SetNumUninitialized(this->m_BlockSize, false);
+
+			int32 consumed = 0;
+			while (cursor.Next < published)
+			{
+				// skip what has been overwritten already
+				if (published - cursor.Next > capacity)
+				{
+					cursor.Dropped += published - capacity - cursor.Next;
+					cursor.Next = published - capacity;
+				}
+
+				const EReadResult result = Read(cursor.Next, cursor.Block.GetData());
+				if (result == NotPublished)
+					break;
+
+				if (result == Ok)
+				{
+					func(cursor.Next, (const uint8*)cursor.Block.GetData());
+					consumed++;
+				}
+				else
+				{
+					cursor.Dropped++;
+				}
+
+				cursor.Next++;
+			}
+
+			return consumed;
+		}
+
+		inline uint64					GetPublishedCount() const { return (uint64)FPlatformAtomics::AtomicRead(&this->m_Published); }
+		inline uint32					GetCapacity() const { return this->m_IndexMask + 1; }
+		inline uint32					GetBlockSize() const { return this->m_BlockSize; }
+
+		/// Summary:	Number of blocks a consumer at the given cursor has not read yet.
+		inline uint64					GetBacklog(const FCursor& cursor) const { return GetPublishedCount() - cursor.Next; }
+
+		inline uint64					GetPhysicalMemorySize() const { return this->m_Blocks.GetAllocatedSize() + this->m_Commits.GetAllocatedSize(); }
+	};
+
+} // namespace StatsTracer
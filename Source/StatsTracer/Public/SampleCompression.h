@@ -0,0 +1,523 @@
+///-------------------------------------------------------------------------------------------------
+/// File:	StatsTracer\Public\SampleCompression.h
+///
+/// Summary:	Declares the sample history compression (XOR floats, delta-of-delta frames).
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace StatsTracer {
+
+	/// Summary:	Number of samples per independently decodable chunk. Must be a power of two.
+	static const int32 SAMPLE_CHUNK_SIZE { 1024 };
+	static const int32 SAMPLE_CHUNK_SHIFT { 10 };
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	FSampleBitWriter
+	///
+	/// Summary:	Appends bit fields (lsb first) to an array of 64 bit words.
+	///-------------------------------------------------------------------------------------------------
+
+	class FSampleBitWriter
+	{
+	private:
+
+		TArray<uint64>&		m_Words;
+
+		// number of bits used in the last word, 64 means the next write starts a new word
+		uint32				m_BitOffset;
+
+	public:
+
+		FSampleBitWriter(TArray<uint64>& words) :
+			m_Words(words),
+			m_BitOffset(64)
+		{}
+
+		/// Summary:	Starts a new word, chunks always begin word aligned.
+		inline void Align() { this->m_BitOffset = 64; }
+
+		FORCEINLINE void Write(uint64 value, uint32 numBits)
+		{
+			while (numBits > 0)
+			{
+				if (this->m_BitOffset == 64)
+				{
+					this->m_Words.Add(0);
+					this->m_BitOffset = 0;
+				}
+
+				const uint32 n = FMath::Min<uint32>(64 - this->m_BitOffset, numBits);
+				const uint64 bits = n == 64 ? value : (value & ((1ull << n) - 1));
+
+				this->m_Words.Last() |= bits << this->m_BitOffset;
+
+				value = n == 64 ? 0 : (value >> n);
+				numBits -= n;
+				this->m_BitOffset += n;
+			}
+		}
+	};
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	FSampleBitReader
+	///
+	/// Summary:	Reads bit fields written by FSampleBitWriter.
+	///-------------------------------------------------------------------------------------------------
+
+	class FSampleBitReader
+	{
+	private:
+
+		const uint64*		m_Words;
+		uint64				m_BitPosition;
+
+	public:
+
+		FSampleBitReader(const uint64* words) :
+			m_Words(words),
+			m_BitPosition(0)
+		{}
+
+		FORCEINLINE uint64 Read(uint32 numBits)
+		{
+			uint64 result = 0;
+			uint32 shift = 0;
+
+			while (numBits > 0)
+			{
+				const uint32 offset = (uint32)(this->m_BitPosition & 63);
+				const uint32 n = FMath::Min<uint32>(64 - offset, numBits);
+
+				uint64 bits = this->m_Words[this->m_BitPosition >> 6] >> offset;
+				if (n < 64)
+					bits &= (1ull << n) - 1;
+
+				result |= bits << shift;
+
+				shift += n;
+				numBits -= n;
+				this->m_BitPosition += n;
+			}
+
+			return result;
+		}
+
+		FORCEINLINE bool ReadBit() { return Read(1) != 0; }
+	};
+
+	///-------------------------------------------------------------------------------------------------
+	/// Struct:	FXorCodec
+	///
+	/// Summary:	XOR value compression as described in Facebook's Gorilla paper. A value equal to
+	/// its predecessor costs a single bit, otherwise only the meaningful bits of the XOR are stored,
+	/// reusing the previous leading/trailing zero window if it still fits.
+	///-------------------------------------------------------------------------------------------------
+
+	struct FXorCodec
+	{
+		uint64				Previous { 0 };
+		uint32				Leading { MAX_uint32 };
+		uint32				Trailing { 0 };
+
+		FORCEINLINE void Encode(FSampleBitWriter& writer, uint64 value, uint32 width)
+		{
+			const uint64 delta = value ^ this->Previous;
+			this->Previous = value;
+
+			if (delta == 0)
+			{
+				writer.Write(0, 1);
+				return;
+			}
+
+			const uint32 leading = (uint32)FMath::CountLeadingZeros64(delta) - (64 - width);
+			const uint32 trailing = (uint32)FMath::CountTrailingZeros64(delta);
+
+			if (this->Leading != MAX_uint32 && leading >= this->Leading && trailing >= this->Trailing)
+			{
+				// '10' meaningful bits fit into the previous window
+				writer.Write(0x1, 2);
+				writer.Write(delta >> this->Trailing, width - this->Leading - this->Trailing);
+			}
+			else
+			{
+				// '11' new window: 6 bits leading zeros, 6 bits length - 1, meaningful bits
+				const uint32 length = width - leading - trailing;
+
+				writer.Write(0x3, 2);
+				writer.Write(leading, 6);
+				writer.Write(length - 1, 6);
+				writer.Write(delta >> trailing, length);
+
+				this->Leading = leading;
+				this->Trailing = trailing;
+			}
+		}
+
+		FORCEINLINE uint64 Decode(FSampleBitReader& reader, uint32 width)
+		{
+			if (reader.ReadBit() == false)
+				return this->Previous;
+
+			if (reader.ReadBit() == true)
+			{
+				this->Leading = (uint32)reader.Read(6);
+				const uint32 length = (uint32)reader.Read(6) + 1;
+				this->Trailing = width - this->Leading - length;
+			}
+
+			const uint64 delta = reader.Read(width - this->Leading - this->Trailing) << this->Trailing;
+
+			this->Previous ^= delta;
+			return this->Previous;
+		}
+	};
+
+	///-------------------------------------------------------------------------------------------------
+	/// Struct:	FDeltaOfDeltaCodec
+	///
+	/// Summary:	Delta-of-delta integer compression for monotonic series like frame numbers. A
+	/// constant stride costs a single bit per value, small jitter a few bits.
+	///-------------------------------------------------------------------------------------------------
+
+	struct FDeltaOfDeltaCodec
+	{
+		uint64				Previous { 0 };
+		int64				PreviousDelta { 0 };
+
+		FORCEINLINE void Encode(FSampleBitWriter& writer, uint64 value)
+		{
+			const int64 delta = (int64)(value - this->Previous);
+			const int64 deltaOfDelta = delta - this->PreviousDelta;
+
+			this->Previous = value;
+			this->PreviousDelta = delta;
+
+			// zig-zag, small negative and positive values map to small unsigned ones
+			const uint64 zz = ((uint64)deltaOfDelta << 1) ^ (uint64)(deltaOfDelta >> 63);
+
+			if (zz == 0)
+			{
+				writer.Write(0x0, 1);			// '0'
+			}
+			else if (zz < (1ull << 7))
+			{
+				writer.Write(0x1, 2);			// '10'
+				writer.Write(zz, 7);
+			}
+			else if (zz < (1ull << 9))
+			{
+				writer.Write(0x3, 3);			// '110'
+				writer.Write(zz, 9);
+			}
+			else if (zz < (1ull << 12))
+			{
+				writer.Write(0x7, 4);			// '1110'
+				writer.Write(zz, 12);
+			}
+			else
+			{
+				writer.Write(0xF, 4);			// '1111'
+				writer.Write(zz, 64);
+			}
+		}
+
+		FORCEINLINE uint64 Decode(FSampleBitReader& reader)
+		{
+			uint64 zz = 0;
+
+			if (reader.ReadBit() == true)
+			{
+				if (reader.ReadBit() == false)
+					zz = reader.Read(7);
+				else if (reader.ReadBit() == false)
+					zz = reader.Read(9);
+				else if (reader.ReadBit() == false)
+					zz = reader.Read(12);
+				else
+					zz = reader.Read(64);
+			}
+
+			const int64 deltaOfDelta = (int64)(zz >> 1) ^ -(int64)(zz & 1);
+
+			this->PreviousDelta += deltaOfDelta;
+			this->Previous += (uint64)this->PreviousDelta;
+
+			return this->Previous;
+		}
+	};
+
+	///-------------------------------------------------------------------------------------------------
+	/// Struct:	TSampleLanes
+	///
+	/// Summary:	Splits a sample into 32 bit lanes which are XOR compressed independently, e.g. a
+	/// FVector into its X, Y and Z float bits.
+	///
+	/// Typeparams:
+	/// T - 	Generic type parameter.
+	///-------------------------------------------------------------------------------------------------
+
+	static FORCEINLINE uint32 FloatToBits(float value) { uint32 bits; FMemory::Memcpy(&bits, &value, sizeof(float)); return bits; }
+	static FORCEINLINE float BitsToFloat(uint32 bits) { float value; FMemory::Memcpy(&value, &bits, sizeof(float)); return value; }
+
+	template<class T>
+	struct TSampleLanes;
+
+	template<>
+	struct TSampleLanes<bool>
+	{
+		enum { Num = 1 };
+		static FORCEINLINE void Split(const bool& value, uint32* lanes) { lanes[0] = value ? 1 : 0; }
+		static FORCEINLINE void Join(const uint32* lanes, bool& value) { value = lanes[0] != 0; }
+	};
+
+	template<>
+	struct TSampleLanes<int32>
+	{
+		enum { Num = 1 };
+		static FORCEINLINE void Split(const int32& value, uint32* lanes) { lanes[0] = (uint32)value; }
+		static FORCEINLINE void Join(const uint32* lanes, int32& value) { value = (int32)lanes[0]; }
+	};
+
+	template<>
+	struct TSampleLanes<float>
+	{
+		enum { Num = 1 };
+		static FORCEINLINE void Split(const float& value, uint32* lanes) { lanes[0] = FloatToBits(value); }
+		static FORCEINLINE void Join(const uint32* lanes, float& value) { value = BitsToFloat(lanes[0]); }
+	};
+
+	template<>
+	struct TSampleLanes<uint8>
+	{
+		enum { Num = 1 };
+		static FORCEINLINE void Split(const uint8& value, uint32* lanes) { lanes[0] = value; }
+		static FORCEINLINE void Join(const uint32* lanes, uint8& value) { value = (uint8)lanes[0]; }
+	};
+
+	template<>
+	struct TSampleLanes<FVector>
+	{
+		enum { Num = 3 };
+
+		static FORCEINLINE void Split(const FVector& value, uint32* lanes)
+		{
+			lanes[0] = FloatToBits(value.X);
+			lanes[1] = FloatToBits(value.Y);
+			lanes[2] = FloatToBits(value.Z);
+		}
+
+		static FORCEINLINE void Join(const uint32* lanes, FVector& value)
+		{
+			value.Set(BitsToFloat(lanes[0]), BitsToFloat(lanes[1]), BitsToFloat(lanes[2]));
+		}
+	};
+
+	template<>
+	struct TSampleLanes<FRotator>
+	{
+		enum { Num = 3 };
+
+		static FORCEINLINE void Split(const FRotator& value, uint32* lanes)
+		{
+			lanes[0] = FloatToBits(value.Pitch);
+			lanes[1] = FloatToBits(value.Yaw);
+			lanes[2] = FloatToBits(value.Roll);
+		}
+
+		static FORCEINLINE void Join(const uint32* lanes, FRotator& value)
+		{
+			value = FRotator(BitsToFloat(lanes[0]), BitsToFloat(lanes[1]), BitsToFloat(lanes[2]));
+		}
+	};
+
+	template<>
+	struct TSampleLanes<FTransform>
+	{
+		enum { Num = 10 };
+
+		static FORCEINLINE void Split(const FTransform& value, uint32* lanes)
+		{
+			const FQuat rotation = value.GetRotation();
+			const FVector translation = value.GetTranslation();
+			const FVector scale = value.GetScale3D();
+
+			lanes[0] = FloatToBits(rotation.X);
+			lanes[1] = FloatToBits(rotation.Y);
+			lanes[2] = FloatToBits(rotation.Z);
+			lanes[3] = FloatToBits(rotation.W);
+			TSampleLanes<FVector>::Split(translation, lanes + 4);
+			TSampleLanes<FVector>::Split(scale, lanes + 7);
+		}
+
+		static FORCEINLINE void Join(const uint32* lanes, FTransform& value)
+		{
+			FVector translation, scale;
+			TSampleLanes<FVector>::Join(lanes + 4, translation);
+			TSampleLanes<FVector>::Join(lanes + 7, scale);
+
+			value.SetComponents(FQuat(BitsToFloat(lanes[0]), BitsToFloat(lanes[1]), BitsToFloat(lanes[2]), BitsToFloat(lanes[3])), translation, scale);
+		}
+	};
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	TCompressedSampleColumn
+	///
+	/// Summary:	A XOR compressed, chunked copy of a data source's sample column (oldest sample
+	/// first). Each chunk of SAMPLE_CHUNK_SIZE samples starts word aligned with fresh codec state,
+	/// so readers can decode just the chunks they touch.
+	///
+	/// Typeparams:
+	/// T - 	Generic type parameter.
+	///-------------------------------------------------------------------------------------------------
+
+	template<class T>
+	class TCompressedSampleColumn
+	{
+		using Lanes = TSampleLanes<T>;
+
+	private:
+
+		TArray<uint64>		m_Words;
+		TArray<int32>		m_ChunkOffsets; // first word of each chunk
+
+		int32				m_NumSamples;
+
+	public:
+
+		///-------------------------------------------------------------------------------------------------
+		/// Class:	FEncoder
+		///
+		/// Summary:	Appends samples to a column. Samples must be added oldest first.
+		///-------------------------------------------------------------------------------------------------
+
+		class FEncoder
+		{
+		private:
+
+			TCompressedSampleColumn&	m_Column;
+			FSampleBitWriter			m_Writer;
+			FXorCodec					m_Codecs[Lanes::Num];
+
+		public:
+
+			FEncoder(TCompressedSampleColumn& column) :
+				m_Column(column),
+				m_Writer(column.m_Words)
+			{}
+
+			~FEncoder()
+			{
+				this->m_Column.m_Words.Shrink();
+				this->m_Column.m_ChunkOffsets.Shrink();
+			}
+
+			FORCEINLINE void Add(const T& value)
+			{
+				if ((this->m_Column.m_NumSamples & (SAMPLE_CHUNK_SIZE - 1)) == 0)
+				{
+					this->m_Writer.Align();
+					this->m_Column.m_ChunkOffsets.Add(this->m_Column.m_Words.Num());
+
+					for (FXorCodec& codec : this->m_Codecs)
+						codec = FXorCodec();
+				}
+
+				uint32 lanes[Lanes::Num];
+				Lanes::Split(value, lanes);
+
+				for (int32 i = 0; i < Lanes::Num; ++i)
+					this->m_Codecs[i].Encode(this->m_Writer, lanes[i], 32);
+
+				this->m_Column.m_NumSamples++;
+			}
+		};
+
+		TCompressedSampleColumn() :
+			m_NumSamples(0)
+		{}
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void DecodeChunk(int32 chunk, T* out) const
+		///
+		/// Summary:	Decodes all samples of a single chunk.
+		///
+		/// Parameters:
+		/// chunk - 	The chunk index.
+		/// out - 		[out] Receives GetChunkSampleCount(chunk) samples.
+		///-------------------------------------------------------------------------------------------------
+
+		void DecodeChunk(int32 chunk, T* out) const
+		{
+			FSampleBitReader reader(this->m_Words.GetData() + this->m_ChunkOffsets[chunk]);
+			FXorCodec codecs[Lanes::Num];
+
+			uint32 lanes[Lanes::Num];
+
+			const int32 count = GetChunkSampleCount(chunk);
+			for (int32 s = 0; s < count; ++s)
+			{
+				for (int32 i = 0; i < Lanes::Num; ++i)
+					lanes[i] = (uint32)codecs[i].Decode(reader, 32);
+
+				Lanes::Join(lanes, out[s]);
+			}
+		}
+
+		inline int32		GetNumSamples() const { return this->m_NumSamples; }
+		inline int32		GetNumChunks() const { return this->m_ChunkOffsets.Num(); }
+		inline int32		GetChunkSampleCount(int32 chunk) const { return FMath::Min<int32>(SAMPLE_CHUNK_SIZE, this->m_NumSamples - (chunk << SAMPLE_CHUNK_SHIFT)); }
+
+		inline uint64		GetPhysicalMemorySize() const { return this->m_Words.GetAllocatedSize() + this->m_ChunkOffsets.GetAllocatedSize(); }
+	};
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	FCompressedTimeline
+	///
+	/// Summary:	A chunked, compressed copy of a repository timeline. Frame numbers are delta-of-delta
+	/// encoded, elapsed times XOR encoded (64 bit).
+	///-------------------------------------------------------------------------------------------------
+
+	class STATSTRACER_API FCompressedTimeline
+	{
+	private:
+
+		TArray<uint64>		m_Words;
+		TArray<int32>		m_ChunkOffsets;
+
+		int32				m_NumEntries;
+
+	public:
+
+		class STATSTRACER_API FEncoder
+		{
+		private:
+
+			FCompressedTimeline&	m_Timeline;
+			FSampleBitWriter		m_Writer;
+			FDeltaOfDeltaCodec		m_FrameCodec;
+			FXorCodec				m_TimeCodec;
+
+		public:
+
+			FEncoder(FCompressedTimeline& timeline);
+			~FEncoder();
+
+			void Add(uint64 frame, double elapsedTime);
+		};
+
+		FCompressedTimeline();
+
+		void				DecodeChunk(int32 chunk, uint64* outFrames, double* outElapsedTimes) const;
+
+		inline int32		GetNumEntries() const { return this->m_NumEntries; }
+		inline int32		GetNumChunks() const { return this->m_ChunkOffsets.Num(); }
+		inline int32		GetChunkEntryCount(int32 chunk) const { return FMath::Min<int32>(SAMPLE_CHUNK_SIZE, this->m_NumEntries - (chunk << SAMPLE_CHUNK_SHIFT)); }
+
+		inline uint64		GetPhysicalMemorySize() const { return this->m_Words.GetAllocatedSize() + this->m_ChunkOffsets.GetAllocatedSize(); }
+	};
+
+} // namespace StatsTracer
@@ -0,0 +1,163 @@
+///-------------------------------------------------------------------------------------------------
+/// File:	StatsTracer\Public\SessionContainer.h
+///
+/// Summary:	Declares the session container file and the trace output class.
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TraceFileWriter.h"
+
+namespace StatsTracer {
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	FSessionContainer
+	///
+	/// Summary:	A single file holding the csv or trace output of all repositories of a session.
+	/// Every repository writes to its own named stream, the streams' data is interleaved as tagged
+	/// blocks. Close() appends an index of all blocks per stream, which Extract uses to write the
+	/// streams back into the files the repositories would have written on their own. A container
+	/// without index (e.g. after a crash) is still extracted by scanning its blocks.
+	///-------------------------------------------------------------------------------------------------
+
+	class STATSTRACER_API FSessionContainer
+	{
+	public:
+
+		static const uint32				MAGIC { 0x43535453 }; // 'STSC'
+		static const uint32				STREAM_MAGIC { 0x4E535453 }; // 'STSN'
+		static const uint32				BLOCK_MAGIC { 0x42535453 }; // 'STSB'
+		static const uint32				INDEX_MAGIC { 0x49535453 }; // 'STSI'
+		static const uint32				VERSION { 1 };
+
+		// data a stream stages before it is written as one block
+		static const int32				BLOCK_SIZE { 8 * 1024 };
+
+	private:
+
+		struct FBlock
+		{
+			// file offset of the block's data
+			uint64						Offset;
+			uint32						Size;
+		};
+
+		struct FStream
+		{
+			FString						Name;
+			TArray<FBlock>				Blocks;
+		};
+
+		FString							m_FileName;
+
+		// streams may be written from several threads, blocks must not interleave
+		FCriticalSection				m_Lock;
+
+		TArray<FStream>					m_Streams;
+		uint64							m_Offset;
+
+		FTraceFileWriter::FFileHandle	m_File;
+
+		void							Write(const void* data, uint32 size);
+
+	public:
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	FSessionContainer::FSessionContainer(const FString& sessionName);
+		///
+		/// Summary:	Creates 'Session.container' in the session's csv output directory.
+		///
+		/// Parameters:
+		/// sessionName - 	The session directory.
+		///-------------------------------------------------------------------------------------------------
+
+										FSessionContainer(const FString& sessionName);
+										~FSessionContainer();
+
+		/// Summary:	Declares a new stream, its name is the file name the stream is extracted to. Returns the stream id.
+		int32							AddStream(const FString& name);
+
+		/// Summary:	Writes one tagged block of the given stream. Thread safe.
+		void							WriteBlock(int32 streamId, const void* data, int32 size);
+
+		/// Summary:	Hands the blocks written so far to the file writer thread, see FTraceFileWriter::HandOff. Thread safe.
+		void							HandOff();
+
+		/// Summary:	Writes the block index and closes the file, blocks written afterwards are dropped.
+		void							Close();
+
+		inline bool						IsValid() const { return this->m_File.IsValid() == true && this->m_File->IsValid() == true; }
+		inline const FString&			GetFileName() const { return this->m_FileName; }
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	static bool FSessionContainer::Extract(const FString& containerFileName, const FString& outputDir, const FString& streamName);
+		///
+		/// Summary:	Writes the streams of a container back into separate files.
+		///
+		/// Parameters:
+		/// containerFileName - 	The container file.
+		/// outputDir - 			The directory to write to, next to the container if empty.
+		/// streamName - 			The stream to extract, e.g. 'MyTracer-1234.csv'. All streams if empty.
+		///
+		/// Returns:	False, if the container could not be read or a file could not be written.
+		///-------------------------------------------------------------------------------------------------
+
+		static bool						Extract(const FString& containerFileName, const FString& outputDir = FString(), const FString& streamName = FString());
+	};
+
+	using FSessionContainerHandle = TSharedPtr<FSessionContainer, ESPMode::ThreadSafe>;
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	FTraceOutput
+	///
+	/// Summary:	Where a csv or trace stream writes to, either a file of its own or a stream of the
+	/// session container. Container output is staged and written in blocks of
+	/// FSessionContainer::BLOCK_SIZE, the last partial block is written when the output is closed.
+	/// The stream hands off what it staged once the flush interval passed, see HandOff.
+	///-------------------------------------------------------------------------------------------------
+
+	class STATSTRACER_API FTraceOutput
+	{
+		FString							m_Name;
+
+		FTraceFileWriter::FFileHandle	m_File;
+
+		FSessionContainerHandle			m_Container;
+		int32							m_StreamId;
+		TArray<uint8>					m_Staged;
+
+		// copied from the settings when the output is opened
+		double							m_FlushInterval;
+		double							m_NextHandOffTime;
+
+		void							ScheduleHandOff();
+
+	public:
+
+										FTraceOutput();
+
+		/// Summary:	Creates (or overwrites) the given file. Returns false if it could not be opened.
+		bool							OpenFile(const FString& fileName);
+
+		/// Summary:	Adds a stream with the given name to the container. Returns false if the container is not valid.
+		bool							OpenStream(const FSessionContainerHandle& container, const FString& name);
+
+		void							Write(const void* data, int64 size);
+		void							Close();
+
+		/// Summary:	Writes the staged container block and hands the output's partially filled block to the file writer thread.
+		void							HandOff();
+
+		/// Summary:	True once the flush interval passed since the output was opened or last handed off.
+		inline bool						IsHandOffDue() const { return IsOpen() == true && FPlatformTime::Seconds() >= this->m_NextHandOffTime; }
+
+		/// Summary:	The file written to (see FTraceFileWriter::Open), or the name of the container stream.
+		inline const FString&			GetName() const { return this->m_Name; }
+
+		inline bool						IsOpen() const { return this->m_File.IsValid() == true || this->m_Container.IsValid() == true; }
+
+		bool							IsValid() const;
+	};
+
+} // namespace StatsTracer
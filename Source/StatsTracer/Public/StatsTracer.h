@@ -27,6 +27,11 @@ private:
 
 	void RegisterSettings();
 	void UnregisterSettings();
+
+	/** Writes the trace output already handed to the file writer when the process crashes. */
+	void OnSystemError();
+
+	FDelegateHandle SystemErrorHandle;
 };
 
 
@@ -40,4 +40,48 @@ class UStatsTracerBPLibrary : public UBlueprintFunctionLibrary
 		const FString& description,
 		const bool enableCsvStream = false,
 		const bool autostartOnBeginPlay = true);
+
+	/* Converts a binary trace file (see 'Trace file format' in the plugin settings) into a csv file. If no csv file name is given the csv file is written next to the trace file. Returns false if the trace could not be read or the csv file could not be written. */
+	UFUNCTION(
+		BlueprintCallable, 
+		Category = "StatsTracer", 
+		meta = (
+			DisplayName = "Convert Trace To Csv", 
+			Keywords = "StatsTracer convert trace csv"))
+	static bool ConvertTraceToCsv(
+		const FString& traceFileName,
+		const FString& csvFileName = "");
+
+	/* Extracts the files of a session container (see 'One file per session' in the plugin settings). If no output directory is given the files are written next to the container. If a stream name, e.g. 'MyTracer-1234.csv', is given only that file is extracted. Returns false if the container could not be read or a file could not be written. */
+	UFUNCTION(
+		BlueprintCallable, 
+		Category = "StatsTracer", 
+		meta = (
+			DisplayName = "Extract Session Container", 
+			Keywords = "StatsTracer extract session container"))
+	static bool ExtractSessionContainer(
+		const FString& containerFileName,
+		const FString& outputDir = "",
+		const FString& streamName = "");
+
+	/* Decompresses a file written with compression (see 'Compression' in the plugin settings). If no file name is given the file is written next to the compressed file, without its '.stz' extension. Returns false if the file is not compressed or could not be read or written. */
+	UFUNCTION(
+		BlueprintCallable, 
+		Category = "StatsTracer", 
+		meta = (
+			DisplayName = "Decompress Trace File", 
+			Keywords = "StatsTracer decompress trace csv file"))
+	static bool DecompressTraceFile(
+		const FString& compressedFileName,
+		const FString& fileName = "");
+
+	/* Loads recorded binary traces (see 'Trace file format' in the plugin settings) back into the editor as a completed session. Pass a session directory to import all its traces, or a single trace file. The traces are mapped, samples are only read as the data overview shows them. Returns false if no trace could be imported. */
+	UFUNCTION(
+		BlueprintCallable, 
+		Category = "StatsTracer", 
+		meta = (
+			DisplayName = "Import Tracer Session", 
+			Keywords = "StatsTracer import load session trace"))
+	static bool ImportTracerSession(
+		const FString& path);
 };
@@ -14,10 +14,19 @@
 #pragma once
 
 #include "Engine.h"
-#include "Containers/CircularBuffer.h"
+#include "Algo/BinarySearch.h"
 #include "CSVStream.h"
+#include "DenseHandleArray.h"
+#include "MemoryAccount.h"
+#include "SampleArena.h"
+#include "HistoryArchive.h"
+#include "SampleBlockRing.h"
+#include "SampleCompression.h"
+#include "TraceStream.h"
 #include "StatsTracerEditorSettings.h"
 
+class UTracedActorListener;
+
 namespace StatsTracer {
 
 	class CSVStream;
@@ -25,6 +34,7 @@ namespace StatsTracer {
 	class IDataSource;
 	class FTracerSession;
 	class FTracerDataRepository;
+	struct FTracerSessionTickFunction;
 
 	/// Summary:	A list of all possible tracable properties. This list contains the CppTypeNames.
 	static const FString TracablePropertiesCppTypeNames[] 
@@ -151,9 +161,10 @@ namespace StatsTracer {
 	using TTracerDataRepositoryHandle			= TSharedPtr<FTracerDataRepository>;
 	using TWeakTracerDataRepositoryHandle		= TWeakPtr<FTracerDataRepository>;
 
-	using TTracerDataRepositoryMap				= TMap<uint32, TTracerDataRepositoryHandle>;
-	using TTracerDataRepositoryMapHandle		= TSharedPtr<TTracerDataRepositoryMap>;
-	using TWeakTracerDataRepositoryMapHandle	= TWeakPtr<TTracerDataRepositoryMap>;
+	// a session's repositories, keyed by repository id (the traced actor's unique id)
+	using TTracerDataRepositoryStore			= TDenseHandleArray<TTracerDataRepositoryHandle>;
+	using TTracerDataRepositoryStoreHandle		= TSharedPtr<TTracerDataRepositoryStore>;
+	using TWeakTracerDataRepositoryStoreHandle	= TWeakPtr<TTracerDataRepositoryStore>;
 
 	///-------------------------------------------------------------------------------------------------
 	/// Struct:	ZeroSample
@@ -190,55 +201,269 @@ namespace StatsTracer {
 	struct ZeroSample<FTransform> { static const FTransform Value; };
 
 	///-------------------------------------------------------------------------------------------------
-	/// Class:	STATSTRACER_API
-	///
-	/// Summary:	Base sample class containing a frame and time when sampled.
-	///
-	/// Author:	Tobias Stein
+	/// Struct:	FTracerSampleRate
 	///
-	/// Date:	1/04/2018
+	/// Summary:	The rate a repository or a single data source samples at. With the frames clock the
+	/// value is the number of frames between two samples, with a time based clock it is the number
+	/// of samples per second. A value of zero means unset, that is, repositories fall back to the 
+	/// editor settings and data sources to their repository's rate.
 	///-------------------------------------------------------------------------------------------------
 
-	class STATSTRACER_API IDataSample
+	struct STATSTRACER_API FTracerSampleRate
 	{
-	public:
-		
-		uint64							Frame;
-		float							ElapsedTime; // in seconds
+		ETracerSampleClock				Clock;
+		float							Value;
+
+		FTracerSampleRate() : Clock(ETracerSampleClock::Frames), Value(0.0f) {}
+		FTracerSampleRate(ETracerSampleClock clock, float value) : Clock(clock), Value(value) {}
+
+		inline bool						IsSet() const { return this->Value > 0.0f; }
+		inline bool						IsTimeBased() const { return this->Clock != ETracerSampleClock::Frames; }
+
+		/// Summary:	Frames between two samples, frames clock only.
+		inline uint32					GetFrameInterval() const { return (uint32)FMath::Max(1, FMath::RoundToInt(this->Value)); }
+
+		/// Summary:	Seconds between two samples, time based clocks only.
+		inline double					GetPeriod() const { return 1.0 / (double)this->Value; }
+
+		/// Summary:	The rate configured in the editor settings.
+		static FTracerSampleRate		GetDefault();
 
-										IDataSample();
-		virtual							~IDataSample();
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	bool FTracerSampleRate::GetStride(const FTracerSampleRate& other, uint32& outStride) const;
+		///
+		/// Summary:	Expresses another (slower) rate as a multiple of this rate, e.g. a data source 
+		/// sampling at 10 Hz in a repository sampling at 60 Hz takes every 6th sample. Rates never
+		/// exceed this rate, an unset rate has stride 1.
+		///
+		/// Returns:	False, if the rates use different clocks.
+		///-------------------------------------------------------------------------------------------------
+
+		bool							GetStride(const FTracerSampleRate& other, uint32& outStride) const;
 	};
 
 	///-------------------------------------------------------------------------------------------------
-	/// Class:	STATSTRACER_API
+	/// Struct:	TSampleSpans
 	///
-	/// Summary:	A typed data sample holding data.
-	///
-	/// Author:	Tobias Stein
-	///
-	/// Date:	1/04/2018
+	/// Summary:	The buffered history of a data source as at most two contiguous segments, oldest 
+	/// sample first. Readers should iterate Head and then Tail (or use ForEach) instead of indexing
+	/// sample by sample, this keeps the ring's wrap-around logic out of their loops.
 	///
 	/// Typeparams:
 	/// T - 	Generic type parameter.
 	///-------------------------------------------------------------------------------------------------
 
 	template<class T>
-	class STATSTRACER_API FDataSample : public IDataSample
+	struct TSampleSpans
 	{
-	public:
+		// oldest samples up to the physical end of the ring
+		TArrayView<const T>				Head;
 
-		T								Value;		
+		// newest samples wrapped around to the physical start of the ring, empty if not wrapped yet
+		TArrayView<const T>				Tail;
 
-		FDataSample() :
-			Value(ZeroSample<T>::Value)
-		{}
+		inline int32					Num() const { return this->Head.Num() + this->Tail.Num(); }
 
-		virtual ~FDataSample()
-		{}
+		template<class Func>
+		FORCEINLINE void ForEach(Func&& func) const
+		{
+			for (const T& value : this->Head)
+				func(value);
+
+			for (const T& value : this->Tail)
+				func(value);
+		}
 	};
 
-	
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	FTracerTimeline
+	///
+	/// Summary:	A ring of frame numbers and high resolution (double precision) elapsed times. A 
+	/// repository owns one timeline which is shared by all of its data sources. Each recorded entry
+	/// is identified by a monotonic sequence number, data sources only remember the sequence of 
+	/// their samples and resolve frame and time through the timeline.
+	/// 
+	/// Once the owning session completed the timeline can be compressed, the rings are released and 
+	/// lookups decode the touched chunk on demand.
+	/// 
+	/// If the repository archives its history to disk the timeline also selects which part of the
+	/// history readers see: the hot ring (default) or a page of sealed chunks read back from the archive.
+	///-------------------------------------------------------------------------------------------------
+
+	class STATSTRACER_API FTracerTimeline
+	{
+	private:
+
+		TArenaArray<uint64>				m_Frames;
+		TArenaArray<double>				m_ElapsedTimes; // in seconds
+
+		const uint32					m_WindowSize;
+		const uint32					m_IndexMask;
+
+		// total number of entries ever recorded, also the sequence number of the next entry
+		uint64							m_Sequence;
+
+		// compressed history, built on a worker thread and swapped in by ApplyEncodedHistory
+		TUniquePtr<FCompressedTimeline>	m_Compressed;
+		bool							m_IsCompressed;
+
+		mutable int32					m_DecodedChunk;
+		mutable TArray<uint64>			m_DecodedFrames;
+		mutable TArray<double>			m_DecodedElapsedTimes;
+
+		// disk backed history of the owning repository, null if not archived
+		const FHistoryArchive*			m_HistoryArchive;
+
+		// first archived chunk shown to readers, INDEX_NONE shows the hot ring
+		int32							m_HistoryPage;
+
+		// number of chunks and rows of the selected page, fixed when the page is selected
+		int32							m_PagedChunkCount;
+		uint32							m_PagedCount;
+
+		// changes whenever another page is selected, readers reload their paged copy if it differs
+		uint32							m_PageGeneration;
+
+		mutable uint32					m_PagedGeneration;
+		mutable TArray<uint64>			m_PagedFrames;
+		mutable TArray<double>			m_PagedElapsedTimes;
+
+		/// Summary:	Logical index (0 = oldest buffered entry) of a buffered sequence.
+		inline int32					GetLogicalIndex(uint64 sequence) const { return (int32)(sequence - (this->m_Sequence - GetCount())); }
+
+		void							DecodeChunk(int32 chunk) const;
+		void							PageInHistory() const;
+
+	public:
+
+										FTracerTimeline(uint32 windowSize, const FSampleArenaHandle& arena = nullptr);
+										~FTracerTimeline();
+
+		inline uint64 Record(uint64 frame, double elapsedTime)
+		{
+			const uint32 index = (uint32)(this->m_Sequence & this->m_IndexMask);
+
+			this->m_Frames[index] = frame;
+			this->m_ElapsedTimes[index] = elapsedTime;
+
+			return this->m_Sequence++;
+		}
+
+		inline bool						IsBuffered(uint64 sequence) const { return sequence < this->m_Sequence && (this->m_Sequence - sequence) <= this->m_WindowSize; }
+
+		inline uint64 GetFrameNumber(uint64 sequence) const 
+		{ 
+			if (IsBuffered(sequence) == false)
+				return 0;
+
+			if (this->m_IsCompressed == true)
+			{
+				const int32 index = GetLogicalIndex(sequence);
+				DecodeChunk(index >> SAMPLE_CHUNK_SHIFT);
+				return this->m_DecodedFrames[index & (SAMPLE_CHUNK_SIZE - 1)];
+			}
+
+			return this->m_Frames[sequence & this->m_IndexMask];
+		}
+
+		inline double GetElapsedTime(uint64 sequence) const 
+		{ 
+			if (IsBuffered(sequence) == false)
+				return 0.0;
+
+			if (this->m_IsCompressed == true)
+			{
+				const int32 index = GetLogicalIndex(sequence);
+				DecodeChunk(index >> SAMPLE_CHUNK_SHIFT);
+				return this->m_DecodedElapsedTimes[index & (SAMPLE_CHUNK_SIZE - 1)];
+			}
+
+			return this->m_ElapsedTimes[sequence & this->m_IndexMask];
+		}
+
+		inline uint64					GetSequence() const { return this->m_Sequence; }
+		inline uint64					GetOldestSequence() const { return this->m_Sequence - GetCount(); }
+		inline uint32					GetCount() const { return (uint32)FMath::Min<uint64>(this->m_Sequence, this->m_WindowSize); }
+		inline uint32					GetWindowSize() const { return this->m_WindowSize; }
+
+		inline void						Clear() { this->m_Sequence = 0; }
+
+		/// Summary:	Builds the compressed copy of the buffered entries. Safe to run on a worker thread while readers access the ring.
+		void							EncodeHistory();
+
+		/// Summary:	Switches to the compressed copy and releases the rings. Must run on the game thread.
+		void							ApplyEncodedHistory();
+
+		/// Summary:	Drops the decoded chunk cache.
+		void							ReleaseDecodedHistory();
+
+		inline bool						IsCompressed() const { return this->m_IsCompressed; }
+
+		inline void						BindHistoryArchive(const FHistoryArchive* archive) { this->m_HistoryArchive = archive; SetHistoryPage(INDEX_NONE); }
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FTracerTimeline::SetHistoryPage(int32 chunk);
+		///
+		/// Summary:	Shows the archived chunks starting at the given chunk to all readers, at most a sample
+		/// window worth of entries. INDEX_NONE switches back to the hot ring.
+		///-------------------------------------------------------------------------------------------------
+
+		void							SetHistoryPage(int32 chunk);
+
+		inline int32					GetHistoryPage() const { return this->m_HistoryPage; }
+		inline bool						IsPaged() const { return this->m_HistoryPage != INDEX_NONE; }
+		inline uint32					GetPageGeneration() const { return this->m_PageGeneration; }
+
+		/// Summary:	Number of archived chunks making up one page.
+		inline int32					GetChunksPerPage() const { return this->m_HistoryArchive != nullptr ? FMath::Max<int32>(1, this->m_WindowSize / this->m_HistoryArchive->GetChunkLength()) : 0; }
+
+		inline int32					GetPagedChunkCount() const { return this->m_PagedChunkCount; }
+
+		/// Summary:	Number of entries of the selected page, the last chunk of an archive may be partial.
+		inline uint32					GetPagedCount() const { return this->m_PagedCount; }
+
+		inline uint64					GetPagedFrameNumber(uint32 index) const { PageInHistory(); return this->m_PagedFrames.IsValidIndex(index) ? this->m_PagedFrames[index] : 0; }
+		inline double					GetPagedElapsedTime(uint32 index) const { PageInHistory(); return this->m_PagedElapsedTimes.IsValidIndex(index) ? this->m_PagedElapsedTimes[index] : 0.0; }
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	template<class T> void FTracerTimeline::ReadPagedColumn(int32 column, TArray<T>& out) const
+		///
+		/// Summary:	Copies a data source column of the selected page out of the archive.
+		///
+		/// Parameters:
+		/// column - 	The data source's archive column.
+		/// out - 		[out] The paged samples, oldest first.
+		///-------------------------------------------------------------------------------------------------
+
+		template<class T>
+		void ReadPagedColumn(int32 column, TArray<T>& out) const
+		{
+			out.SetNumUninitialized(GetPagedCount(), false);
+
+			T* dest = out.GetData();
+
+			for (int32 i = 0; i < GetPagedChunkCount(); ++i)
+			{
+				const uint32 numRows = this->m_HistoryArchive->GetChunkRows(this->m_HistoryPage + i);
+
+				const uint8* chunk = this->m_HistoryArchive->PageIn(this->m_HistoryPage + i);
+				if (chunk == nullptr)
+				{
+					for (uint32 j = 0; j < numRows; ++j)
+						dest[j] = ZeroSample<T>::Value;
+				}
+				else
+				{
+					FMemory::Memcpy(dest, chunk + this->m_HistoryArchive->GetColumnOffset(column), sizeof(T) * numRows);
+				}
+
+				dest += numRows;
+			}
+		}
+
+		uint64							GetPhysicalMemorySize() const;
+		inline uint64					GetUncompressedMemorySize() const { return (sizeof(uint64) + sizeof(double)) * this->m_WindowSize; }
+	};
 
 	///-------------------------------------------------------------------------------------------------
 	/// Class:	IDataSource
@@ -263,22 +488,115 @@ namespace StatsTracer {
 
 		const bool						m_StreamToCsv;
 
+		// requested rate, resolved to a stride of the repository's rate when the repository starts
+		FTracerSampleRate				m_SampleRate;
+
+	protected:
+
+		// shared timeline of the owning repository
+		const FTracerTimeline*			m_Timeline;
+
+		// column of this source in the repository's history archive, INDEX_NONE if not archived
+		int32							m_ArchiveColumn;
+
+		// account of the owning repository, memory allocated by readers is added to it
+		FMemoryAccount*					m_MemoryAccount;
+
+		/// Summary:	True, if readers currently look at an archived page instead of the buffered samples.
+		inline bool						IsPaged() const { return this->m_ArchiveColumn != INDEX_NONE && this->m_Timeline != nullptr && this->m_Timeline->IsPaged(); }
+
 	public:
 
 										IDataSource(const FString& name, const FString& group, const FString& description, const FColor& color, const bool streamToCsv = true);
 
 		virtual							~IDataSource();
 
-		virtual void					SampleData(uint64 frame, float ElapsedTime, CSVStream* stream = nullptr) = 0;
+		virtual void					SampleData(uint64 sequence, CSVStream* stream = nullptr) = 0;
 		virtual inline uint32			GetSampleWindowSize() const = 0;
 		virtual inline uint32			GetSampleCount() const = 0;
 		virtual inline void				Clear() = 0;
 
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	virtual void IDataSource::SetSampleStride(uint32 stride) = 0;
+		///
+		/// Summary:	Only keeps every stride-th sample of the repository (by timeline sequence) and 
+		/// shrinks the sample window accordingly, so the source still covers the repository's window.
+		/// Drops all buffered samples and allocates the sample ring, must be called before sampling starts.
+		///-------------------------------------------------------------------------------------------------
+
+		virtual void					SetSampleStride(uint32 stride) = 0;
+		virtual inline uint32			GetSampleStride() const = 0;
+
 		virtual inline const void*		GetRawDataPtr() const = 0;
 		virtual inline uint64			GetFrameNumber(uint32 index) const = 0;
-		virtual inline float			GetElapsedTime(uint32 index) const = 0;
+		virtual inline double			GetElapsedTime(uint32 index) const = 0;
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	virtual uint32 IDataSource::GetTimelineIndex(uint32 index) const = 0;
+		///
+		/// Summary:	Maps a sample index to the index of the timeline entry it was taken at (0 = oldest
+		/// entry readers look at, see GetTimelineCount). Sources sampling at a stride only hold every 
+		/// stride-th entry, readers plotting several sources place their samples by this index.
+		///-------------------------------------------------------------------------------------------------
+
+		virtual uint32					GetTimelineIndex(uint32 index) const = 0;
+
+		/// Summary:	Index of the latest sample taken at or before the given timeline entry, clamped to the samples held. INDEX_NONE if there are none.
+		virtual int32					FindSampleIndex(uint32 timelineIndex) const = 0;
+
+		/// Summary:	Number of timeline entries readers look at, the buffered entries or the selected archived page.
+		inline uint32					GetTimelineCount() const 
+		{ 
+			if (this->m_Timeline == nullptr)
+				return GetSampleCount();
+
+			return IsPaged() == true ? this->m_Timeline->GetPagedCount() : this->m_Timeline->GetCount(); 
+		}
+
+		inline uint32					GetTimelineWindowSize() const { return this->m_Timeline != nullptr ? this->m_Timeline->GetWindowSize() : GetSampleWindowSize(); }
+
+		inline uint64 GetTimelineFrameNumber(uint32 timelineIndex) const
+		{
+			if (this->m_Timeline == nullptr)
+				return 0;
+
+			return IsPaged() == true ? this->m_Timeline->GetPagedFrameNumber(timelineIndex) : this->m_Timeline->GetFrameNumber(this->m_Timeline->GetOldestSequence() + timelineIndex);
+		}
+
+		inline double GetTimelineElapsedTime(uint32 timelineIndex) const
+		{
+			if (this->m_Timeline == nullptr)
+				return 0.0;
+
+			return IsPaged() == true ? this->m_Timeline->GetPagedElapsedTime(timelineIndex) : this->m_Timeline->GetElapsedTime(this->m_Timeline->GetOldestSequence() + timelineIndex);
+		}
 
 		virtual inline uint64			GetDataSourcePhysicalMemorySize() = 0;
+		virtual inline uint64			GetDataSourceUncompressedMemorySize() = 0;
+
+		/// Summary:	Builds a compressed copy of the buffered samples. Safe to run on a worker thread while readers access the samples.
+		virtual void					EncodeHistory() = 0;
+
+		/// Summary:	Switches to the compressed copy and releases the raw samples. Must run on the game thread.
+		virtual void					ApplyEncodedHistory() = 0;
+
+		/// Summary:	Drops samples decoded from the compressed copy, they are decoded again on the next read.
+		virtual void					ReleaseDecodedHistory() = 0;
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	virtual void IDataSource::ArchiveSamples(uint64 firstSequence, uint32 count, uint8* dest) const = 0;
+		///
+		/// Summary:	Writes the buffered samples of a range of timeline sequences as a dense column of 
+		/// sample values. Sequences without a sample are written as zero samples.
+		///
+		/// Parameters:
+		/// firstSequence - 	The first timeline sequence.
+		/// count - 			The number of sequences.
+		/// dest - 				[out] count * GetSampleSize() bytes.
+		///-------------------------------------------------------------------------------------------------
+
+		virtual void					ArchiveSamples(uint64 firstSequence, uint32 count, uint8* dest) const = 0;
+		virtual inline uint32			GetSampleSize() const = 0;
 
 		virtual inline EDataSourceType	GetDataSourceType() const = 0;
 
@@ -288,6 +606,16 @@ namespace StatsTracer {
 
 		inline const bool				ShouldStreamtoCsv() const { return this->m_StreamToCsv; }
 
+		inline void						SetSampleRate(const FTracerSampleRate& rate) { this->m_SampleRate = rate; }
+		inline const FTracerSampleRate&	GetSampleRate() const { return this->m_SampleRate; }
+
+		inline void						BindTimeline(const FTracerTimeline* timeline) { this->m_Timeline = timeline; }
+
+		/// Summary:	Binds the arena of the owning session, the sample ring is allocated from it once the stride is known, see SetSampleStride.
+		virtual void					BindSampleArena(const FSampleArenaHandle& arena) = 0;
+		inline void						BindArchiveColumn(int32 column) { this->m_ArchiveColumn = column; }
+		inline void						BindMemoryAccount(FMemoryAccount* account) { this->m_MemoryAccount = account; }
+
 		inline FColor&					GetColor() { return this->m_Color; }
 
 		template<class T>
@@ -315,12 +643,62 @@ namespace StatsTracer {
 
 		const T*						m_Source;
 
-		TCircularBuffer<FDataSample<T>>	m_Samples;
-		const uint32					m_SampleWindowSize;
+		/*
+			Samples are stored column-wise (structure-of-arrays). The value column is a dense ring of
+			plain T values, frame numbers and elapsed times are not stored per source but resolved 
+			through the repository's shared timeline. This avoids any per-sample overhead and lets 
+			min/max scans and plot loops stream through contiguous memory. The ring is carved from
+			the session's sample arena once the source is added to a repository.
+		*/
+		TArenaArray<T>					m_Values;
+
+		/*
+			Change-only (run-length) storage. If enabled, m_Values stays empty and a new run is only
+			recorded when the traced value changes. Runs that fall out of the sample window are dropped,
+			so memory grows with the number of changes rather than with the number of samples. Readers
+			walk the runs, they are never expanded into a dense copy.
+		*/
+		const bool						m_RunLengthEncoded;
+		TArray<T>						m_RunValues;
+		TArray<uint64>					m_RunStarts; // timeline sequence each run starts at
+		int32							m_FirstRun;
+
+		// runs reserved up front, the memory budget accounts for at least this many
+		static const int32				INITIAL_RUN_CAPACITY { 64 };
+
+
+		/*
+			Compressed history of a completed session. The column is built on a worker thread, the
+			raw samples are only released once ApplyEncodedHistory switched over on the game thread.
+		*/
+		TUniquePtr<TCompressedSampleColumn<T>>	m_CompressedValues;
+		bool							m_IsCompressed;
+		uint64							m_UncompressedMemorySize;
+
+		// chunks decoded for readers, a bounded cache which replaces the chunk decoded longest ago
+		static const int32				DECODED_CHUNK_CACHE_SIZE { 4 };
+
+		mutable TArray<T>				m_DecodedValues;
+		mutable int32					m_DecodedChunkIds[DECODED_CHUNK_CACHE_SIZE];
+		mutable int32					m_NextDecodedSlot;
+
+		// samples of the archived page selected on the timeline, read back from disk lazily
+		mutable TArray<T>				m_PagedValues;
+		mutable uint32					m_PagedGeneration;
+
+		// resized by SetSampleStride, the window of a source never exceeds the timeline's window
+		uint32							m_SampleWindowSize;
+		uint32							m_IndexMask;
+
+		// timeline sequences between two samples
+		uint32							m_SampleStride;
 
 		uint32							m_BufferIndex;
 		uint32							m_SampleCount;
 
+		// timeline sequence of the latest sample
+		uint64							m_LastSequence;
+
 	protected:
 
 		FDataSource(
@@ -329,74 +707,536 @@ namespace StatsTracer {
 			const FString& group,
 			const FString& description,
 			const FColor& color,
-			const bool streamToCsv) :
+			const bool streamToCsv,
+			const bool runLengthEncoded = false) :
 			IDataSource(name, group, description, color, streamToCsv),
 			m_Source(source),
-			m_Samples(UStatsTracerEditorSettings::GetInstance()->SampleWindowSize),
-			m_SampleWindowSize(UStatsTracerEditorSettings::GetInstance()->SampleWindowSize),
+			m_RunLengthEncoded(runLengthEncoded),
+			m_FirstRun(0),
+			m_IsCompressed(false),
+			m_UncompressedMemorySize(0),
+			m_NextDecodedSlot(0),
+			m_PagedGeneration(0),
+			m_SampleWindowSize(UStatsTracerEditorSettings::GetInstance()->GetSampleWindowSize()),
+			m_IndexMask(m_SampleWindowSize - 1),
+			m_SampleStride(1),
 			m_BufferIndex(0),
-			m_SampleCount(0)
-		{}
+			m_SampleCount(0),
+			m_LastSequence(0)
+		{
+			ResetDecodedChunks();
+		}
+
+		/// Summary:	Physical column index of the oldest buffered sample.
+		inline uint32 GetOldestIndex() const
+		{
+			return this->m_SampleCount < this->m_SampleWindowSize ? 0 : this->m_BufferIndex;
+		}
+
+		/// Summary:	Maps a logical sample index (0 = oldest buffered sample) to its physical column index.
+		inline uint32 GetPhysicalIndex(uint32 index) const
+		{
+			return (GetOldestIndex() + index) & this->m_IndexMask;
+		}
+
+		/// Summary:	Maps a logical sample index to the timeline sequence it was sampled at.
+		inline uint64 GetSequence(uint32 index) const
+		{
+			return this->m_LastSequence - (uint64)(this->m_SampleCount - 1 - index) * this->m_SampleStride;
+		}
+
+		/// Summary:	Bitwise sample comparison, used to detect value changes in run-length mode.
+		static FORCEINLINE bool IsSameSample(const T& lhs, const T& rhs)
+		{
+			return FMemory::Memcmp(&lhs, &rhs, sizeof(T)) == 0;
+		}
+
+		/// Summary:	Index of the run holding the sample taken at the given timeline sequence.
+		inline int32 FindRun(uint64 sequence) const
+		{
+			const TArrayView<const uint64> liveRuns(this->m_RunStarts.GetData() + this->m_FirstRun, this->m_RunStarts.Num() - this->m_FirstRun);
+
+			return this->m_FirstRun + FMath::Max<int32>(0, Algo::UpperBound(liveRuns, sequence) - 1);
+		}
+
+		inline void ReserveRuns()
+		{
+			this->m_RunValues.Reserve(INITIAL_RUN_CAPACITY);
+			this->m_RunStarts.Reserve(INITIAL_RUN_CAPACITY);
+		}
+
+		void PushRun(const T& value, uint64 sequence)
+		{
+			if (this->m_RunValues.Num() == 0 || IsSameSample(this->m_RunValues.Last(), value) == false)
+			{
+				this->m_RunValues.Add(value);
+				this->m_RunStarts.Add(sequence);
+			}
+
+			// drop runs which ended before the oldest sample in the window
+			const uint64 oldestSequence = GetSequence(0);
+			while (this->m_FirstRun + 1 < this->m_RunStarts.Num() && this->m_RunStarts[this->m_FirstRun + 1] <= oldestSequence)
+				this->m_FirstRun++;
+
+			// compact once the dead runs dominate the arrays
+			if (this->m_FirstRun >= 64 && this->m_FirstRun * 2 >= this->m_RunStarts.Num())
+			{
+				this->m_RunValues.RemoveAt(0, this->m_FirstRun, false);
+				this->m_RunStarts.RemoveAt(0, this->m_FirstRun, false);
+				this->m_FirstRun = 0;
+			}
+		}
+
+		/// Summary:	Visits the raw (not compressed) samples oldest first, without touching any cache.
+		template<class Func>
+		void ForEachRawSample(Func&& func) const
+		{
+			if (this->m_RunLengthEncoded == false)
+			{
+				const T* values = this->m_Values.GetData();
+				for (uint32 i = 0; i < this->m_SampleCount; ++i)
+					func(values[GetPhysicalIndex(i)]);
+
+				return;
+			}
+
+			if (this->m_SampleCount == 0)
+				return;
+
+			const uint64 firstSequence = GetSequence(0);
+			int32 run = FindRun(firstSequence);
+
+			for (uint32 i = 0; i < this->m_SampleCount; ++i)
+			{
+				while (run + 1 < this->m_RunStarts.Num() && this->m_RunStarts[run + 1] <= firstSequence + (uint64)i * this->m_SampleStride)
+					run++;
+
+				func(this->m_RunValues[run]);
+			}
+		}
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	const T* DecodeChunk(int32 chunk) const
+		///
+		/// Summary:	The samples of a chunk of the compressed history, decoded into the chunk cache iff
+		/// not cached. The pointer stays valid until DECODED_CHUNK_CACHE_SIZE other chunks were decoded.
+		///
+		/// Parameters:
+		/// chunk - 	The chunk.
+		///
+		/// Returns:	GetChunkSampleCount(chunk) samples.
+		///-------------------------------------------------------------------------------------------------
+
+		const T* DecodeChunk(int32 chunk) const
+		{
+			for (int32 slot = 0; slot < DECODED_CHUNK_CACHE_SIZE; ++slot)
+			{
+				if (this->m_DecodedChunkIds[slot] == chunk)
+					return this->m_DecodedValues.GetData() + (slot << SAMPLE_CHUNK_SHIFT);
+			}
+
+			// the cache is allocated by the first read, the repository's account learns about it right away
+			if (this->m_DecodedValues.Num() == 0)
+			{
+				this->m_DecodedValues.SetNumUninitialized(DECODED_CHUNK_CACHE_SIZE * SAMPLE_CHUNK_SIZE, false);
+
+				if (this->m_MemoryAccount != nullptr)
+					this->m_MemoryAccount->Adjust(this->m_DecodedValues.GetAllocatedSize(), 0);
+			}
+
+			const int32 slot = this->m_NextDecodedSlot;
+			this->m_NextDecodedSlot = (slot + 1) % DECODED_CHUNK_CACHE_SIZE;
+
+			T* decoded = this->m_DecodedValues.GetData() + (slot << SAMPLE_CHUNK_SHIFT);
+			this->m_CompressedValues->DecodeChunk(chunk, decoded);
+			this->m_DecodedChunkIds[slot] = chunk;
+
+			return decoded;
+		}
+
+		inline void ResetDecodedChunks() const
+		{
+			for (int32 slot = 0; slot < DECODED_CHUNK_CACHE_SIZE; ++slot)
+				this->m_DecodedChunkIds[slot] = INDEX_NONE;
+
+			this->m_NextDecodedSlot = 0;
+		}
+
+		/// Summary:	The samples of the selected archived page, paged in from disk iff the page changed.
+		inline const TArray<T>& GetPagedValues() const
+		{
+			if (this->m_PagedGeneration != this->m_Timeline->GetPageGeneration())
+			{
+				this->m_Timeline->ReadPagedColumn(this->m_ArchiveColumn, this->m_PagedValues);
+				this->m_PagedGeneration = this->m_Timeline->GetPageGeneration();
+			}
+
+			return this->m_PagedValues;
+		}
+
+		/// Summary:	Buffered sample at a logical index, regardless of the selected archive page.
+		const T& GetBufferedSample(uint32 i) const
+		{
+			if (this->m_IsCompressed == true)
+				return DecodeChunk(i >> SAMPLE_CHUNK_SHIFT)[i & (SAMPLE_CHUNK_SIZE - 1)];
+
+			if (this->m_RunLengthEncoded == true)
+				return this->m_RunValues[FindRun(GetSequence(i))];
+
+			return this->m_Values[GetPhysicalIndex(i)];
+		}
 
 	public:
 
-		virtual	~FDataSource()
+		virtual	~FDataSource()
+		{
+			this->m_Source = nullptr;
+		}
+
+		virtual inline EDataSourceType	GetDataSourceType() const = 0;
+
+		virtual void SampleData(uint64 sequence, CSVStream* stream = nullptr) override
+		{
+			//SCOPE_CYCLE_COUNTER(STAT_SampleDatasource);
+
+			Push(sequence);
+
+			// strema value to csv file
+			if (this->ShouldStreamtoCsv() == true && stream != nullptr)
+			{
+				StreamLatest(*stream);
+			}
+		}
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	FORCEINLINE void Push(uint64 sequence)
+		///
+		/// Summary:	Non-virtual sampling of the traced value. This is what the repository's compiled 
+		/// sampling plan calls in its per type gather loops.
+		///
+		/// Parameters:
+		/// sequence - 	The timeline sequence of this sample.
+		///-------------------------------------------------------------------------------------------------
+
+		FORCEINLINE void Push(uint64 sequence)
+		{
+			// check if source is still valid
+			if (this->m_Source == nullptr)
+				return;
+
+			PushValue(*this->m_Source, sequence);
+		}
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	FORCEINLINE void PushValue(const T& value, uint64 sequence)
+		///
+		/// Summary:	Stores a value that was read from the traced stat before, e.g. as part of a 
+		/// snapshot row of the repository's sampling plan.
+		///
+		/// Parameters:
+		/// value - 	The sample value.
+		/// sequence - 	The timeline sequence of this sample.
+		///-------------------------------------------------------------------------------------------------
+
+		FORCEINLINE void PushValue(const T& value, uint64 sequence)
+		{
+			// not due at this source's rate
+			if ((sequence % this->m_SampleStride) != 0)
+				return;
+
+			this->m_LastSequence = sequence;
+
+			// update sample count
+			this->m_SampleCount = FMath::Min<uint32>(this->m_SampleCount + 1, this->m_SampleWindowSize);
+
+			if (this->m_RunLengthEncoded == true)
+			{
+				PushRun(value, sequence);
+				return;
+			}
+
+			// update buffer
+			this->m_Values[this->m_BufferIndex] = value;
+
+			// update buffer index
+			this->m_BufferIndex = (this->m_BufferIndex + 1) & this->m_IndexMask;
+		}
+
+		/// Summary:	Copies the raw bytes of the traced stat into a snapshot row, ZeroSample if the source is gone.
+		FORCEINLINE void Capture(uint8* dest) const
+		{
+			FMemory::Memcpy(dest, this->m_Source != nullptr ? this->m_Source : &ZeroSample<T>::Value, sizeof(T));
+		}
+
+		/// Summary:	Streams the current value of the traced stat, or an empty cell if the source is gone.
+		FORCEINLINE void StreamLatest(CSVStream& stream) const
+		{
+			if (this->m_Source == nullptr)
+				stream << FString();
+			else
+				stream << (*this->m_Source);
+		}
+
+		const T& operator[](uint32 i) const
+		{
+			if (IsPaged() == true)
+				return GetPagedValues()[i];
+
+			return GetBufferedSample(i);
+		}
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	template<class Func> void ForEachSample(Func&& func) const
+		///
+		/// Summary:	Visits the samples readers currently look at (the buffered samples or the selected
+		/// archived page), oldest first. Works for every storage mode without building a dense copy,
+		/// readers should prefer it over GetSampleSpans.
+		///
+		/// Parameters:
+		/// func - 	Called with each sample.
+		///-------------------------------------------------------------------------------------------------
+
+		template<class Func>
+		void ForEachSample(Func&& func) const
+		{
+			if (IsPaged() == true || (this->m_IsCompressed == false && this->m_RunLengthEncoded == false))
+			{
+				GetSampleSpans().ForEach(func);
+				return;
+			}
+
+			// one chunk at a time through the chunk cache
+			if (this->m_IsCompressed == true)
+			{
+				for (int32 chunk = 0; chunk < this->m_CompressedValues->GetNumChunks(); ++chunk)
+				{
+					const T* values = DecodeChunk(chunk);
+					const int32 count = this->m_CompressedValues->GetChunkSampleCount(chunk);
+
+					for (int32 i = 0; i < count; ++i)
+						func(values[i]);
+				}
+
+				return;
+			}
+
+			ForEachRawSample(func);
+		}
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	TSampleSpans<T> GetSampleSpans() const
+		///
+		/// Summary:	Returns the buffered samples as (at most) two contiguous segments, oldest first.
+		/// Change-only and compressed sources have no contiguous samples and return no spans, see
+		/// ForEachSample.
+		///
+		/// Returns:	The sample spans.
+		///-------------------------------------------------------------------------------------------------
+
+		TSampleSpans<T> GetSampleSpans() const
+		{
+			TSampleSpans<T> spans;
+
+			// an archived page is one contiguous segment
+			if (IsPaged() == true)
+			{
+				spans.Head = TArrayView<const T>(GetPagedValues());
+				return spans;
+			}
+
+			if (this->m_IsCompressed == true || this->m_RunLengthEncoded == true)
+				return spans;
+
+			const T* values = this->m_Values.GetData();
+			const uint32 oldest = GetOldestIndex();
+			const uint32 headCount = FMath::Min<uint32>(this->m_SampleCount, this->m_SampleWindowSize - oldest);
+
+			spans.Head = TArrayView<const T>(values + oldest, headCount);
+			spans.Tail = TArrayView<const T>(values, this->m_SampleCount - headCount);
+
+			return spans;
+		}
+
+		virtual inline const void*		GetRawDataPtr() const override { return m_Source; }
+
+		virtual inline uint32			GetSampleCount() const override { return IsPaged() == true ? this->m_Timeline->GetPagedCount() : this->m_SampleCount; }
+
+		virtual inline uint64 GetFrameNumber(uint32 index) const override 
+		{ 
+			if (this->m_Timeline == nullptr)
+				return 0;
+
+			return IsPaged() == true ? this->m_Timeline->GetPagedFrameNumber(index) : this->m_Timeline->GetFrameNumber(GetSequence(index)); 
+		}
+
+		virtual inline double GetElapsedTime(uint32 index) const override 
+		{ 
+			if (this->m_Timeline == nullptr)
+				return 0.0;
+
+			return IsPaged() == true ? this->m_Timeline->GetPagedElapsedTime(index) : this->m_Timeline->GetElapsedTime(GetSequence(index)); 
+		}
+
+		virtual uint32 GetTimelineIndex(uint32 index) const override
+		{
+			// an archived page holds one sample per timeline entry
+			if (IsPaged() == true || this->m_Timeline == nullptr)
+				return index;
+
+			return (uint32)FMath::Max<int64>(0, (int64)GetSequence(index) - (int64)this->m_Timeline->GetOldestSequence());
+		}
+
+		virtual int32 FindSampleIndex(uint32 timelineIndex) const override
+		{
+			const int32 count = (int32)GetSampleCount();
+
+			if (count == 0)
+				return INDEX_NONE;
+
+			if (IsPaged() == true || this->m_Timeline == nullptr)
+				return FMath::Min<int32>((int32)timelineIndex, count - 1);
+
+			const int64 offset = (int64)(this->m_Timeline->GetOldestSequence() + timelineIndex) - (int64)GetSequence(0);
+
+			return FMath::Clamp<int32>((int32)(offset / (int64)this->m_SampleStride), 0, count - 1);
+		}
+
+		virtual inline uint32			GetSampleWindowSize() const override { return this->m_SampleWindowSize; }
+
+		virtual void					SetSampleStride(uint32 stride) override
+		{
+			const uint32 timelineWindowSize = this->m_Timeline != nullptr ? this->m_Timeline->GetWindowSize() : UStatsTracerEditorSettings::GetInstance()->GetSampleWindowSize();
+
+			this->m_SampleStride = FMath::Max<uint32>(stride, 1);
+
+			// largest power of two that does not reach back further than the timeline
+			this->m_SampleWindowSize = FMath::Max<uint32>(2, FMath::RoundUpToPowerOfTwo(timelineWindowSize / this->m_SampleStride + 1) / 2);
+			this->m_IndexMask = this->m_SampleWindowSize - 1;
+
+			Clear();
+
+			if (this->m_RunLengthEncoded == false)
+				this->m_Values.Init(ZeroSample<T>::Value, this->m_SampleWindowSize);
+			else
+				ReserveRuns();
+		}
+
+		virtual void					BindSampleArena(const FSampleArenaHandle& arena) override
+		{
+			this->m_Values.BindArena(arena);
+		}
+
+		virtual inline uint32			GetSampleStride() const override { return this->m_SampleStride; }
+
+		virtual inline void				Clear() override 
+		{ 
+			this->m_BufferIndex = 0; 
+			this->m_SampleCount = 0;
+			this->m_RunValues.Empty();
+			this->m_RunStarts.Empty();
+			this->m_FirstRun = 0;
+			this->m_DecodedValues.Empty();
+			ResetDecodedChunks();
+			this->m_PagedValues.Empty();
+			this->m_PagedGeneration = 0;
+		}
+
+		virtual inline uint64			GetDataSourcePhysicalMemorySize() override 
+		{ 
+			const uint64 pagedSize = this->m_PagedValues.GetAllocatedSize();
+
+			if (this->m_IsCompressed == true)
+				return this->m_CompressedValues->GetPhysicalMemorySize() + this->m_DecodedValues.GetAllocatedSize() + pagedSize;
+
+			if (this->m_RunLengthEncoded == true)
+				return (sizeof(T) + sizeof(uint64)) * this->m_RunStarts.Max() + pagedSize;
+
+			// a ring allocated from the session's arena is accounted by the arena
+			return this->m_Values.GetHeapAllocatedSize() + pagedSize; 
+		}
+
+		/// Summary:	Size of the raw samples once sampling, the budget a source is checked against before its ring is allocated.
+		virtual inline uint64			GetDataSourceUncompressedMemorySize() override
 		{
-			this->m_Source = nullptr;
-		}
+			if (this->m_IsCompressed == true)
+				return this->m_UncompressedMemorySize;
 
-		virtual inline EDataSourceType	GetDataSourceType() const = 0;
+			const uint64 pagedSize = this->m_PagedValues.GetAllocatedSize();
 
-		virtual void SampleData(uint64 frame, float ElapsedTime, CSVStream* stream = nullptr) override
-		{
-			//SCOPE_CYCLE_COUNTER(STAT_SampleDatasource);
+			if (this->m_RunLengthEncoded == true)
+				return (sizeof(T) + sizeof(uint64)) * FMath::Max<int32>(this->m_RunStarts.Max(), INITIAL_RUN_CAPACITY) + pagedSize;
 
-			// check if source is still valid
-			if (this->m_Source == nullptr)
-			{
-				if (this->ShouldStreamtoCsv())
-					(*stream) << "";
+			return sizeof(T) * this->m_SampleWindowSize + pagedSize;
+		}
 
+		virtual void EncodeHistory() override
+		{
+			if (this->m_IsCompressed == true || this->m_CompressedValues.IsValid() == true)
 				return;
-			}
 
-			// update buffer
+			TUniquePtr<TCompressedSampleColumn<T>> compressed = MakeUnique<TCompressedSampleColumn<T>>();
 			{
-				this->m_Samples[this->m_BufferIndex].Value = *this->m_Source;
-				this->m_Samples[this->m_BufferIndex].Frame = frame;
-				this->m_Samples[this->m_BufferIndex].ElapsedTime = ElapsedTime;
+				typename TCompressedSampleColumn<T>::FEncoder encoder(*compressed);
+				ForEachRawSample([&encoder](const T& value) { encoder.Add(value); });
 			}
 
-			// strema value to csv file
-			if (this->ShouldStreamtoCsv() == true && stream != nullptr)
-			{
-				(*stream) << (*this->m_Source);
-			}
+			this->m_CompressedValues = MoveTemp(compressed);
+		}
 
-			// update buffer index
-			this->m_BufferIndex = this->m_Samples.GetNextIndex(this->m_BufferIndex);
+		virtual void ApplyEncodedHistory() override
+		{
+			if (this->m_IsCompressed == true || this->m_CompressedValues.IsValid() == false)
+				return;
 
-			// update sample count
-			this->m_SampleCount = FMath::Min<uint32>(this->m_SampleCount + 1, this->m_SampleWindowSize);
+			this->m_UncompressedMemorySize = GetDataSourceUncompressedMemorySize();
+
+			this->m_Values.Empty();
+			this->m_RunValues.Empty();
+			this->m_RunStarts.Empty();
+			this->m_FirstRun = 0;
+			this->m_DecodedValues.Empty();
+			ResetDecodedChunks();
+
+			this->m_IsCompressed = true;
 		}
 
-		const FDataSample<T>& operator[](uint32 i) const
+		virtual void ReleaseDecodedHistory() override
 		{
-			return this->m_Samples[((this->m_SampleCount < this->m_SampleWindowSize - 1) ? 0 : this->m_BufferIndex) + i];
-		}
+			this->m_PagedValues.Empty();
+			this->m_PagedGeneration = 0;
 
-		virtual inline const void*		GetRawDataPtr() const override { return m_Source; }
+			if (this->m_IsCompressed == false)
+				return;
 
-		virtual inline uint32			GetSampleCount() const override { return this->m_SampleCount; }
+			this->m_DecodedValues.Empty();
+			ResetDecodedChunks();
+		}
 
-		virtual inline uint64			GetFrameNumber(uint32 index) const override { return this->m_Samples[((this->m_SampleCount < this->m_SampleWindowSize - 1) ? 0 : this->m_BufferIndex) + index].Frame; }
-		virtual inline float			GetElapsedTime(uint32 index) const override { return this->m_Samples[((this->m_SampleCount < this->m_SampleWindowSize - 1) ? 0 : this->m_BufferIndex) + index].ElapsedTime; }
+		virtual void ArchiveSamples(uint64 firstSequence, uint32 count, uint8* dest) const override
+		{
+			for (uint32 i = 0; i < count; ++i, dest += sizeof(T))
+			{
+				// sources sampling slower than the repository hold their last sample
+				const uint64 sequence = firstSequence + i;
+				const uint64 sampled = sequence - (sequence % this->m_SampleStride);
+
+				// not sampled (yet) or already dropped from the window
+				if (this->m_SampleCount == 0 || sampled > this->m_LastSequence || (this->m_LastSequence - sampled) / this->m_SampleStride >= this->m_SampleCount)
+				{
+					FMemory::Memcpy(dest, &ZeroSample<T>::Value, sizeof(T));
+					continue;
+				}
+
+				FMemory::Memcpy(dest, &GetBufferedSample(this->m_SampleCount - 1 - (uint32)((this->m_LastSequence - sampled) / this->m_SampleStride)), sizeof(T));
+			}
+		}
 
-		virtual inline uint32			GetSampleWindowSize() const override { return this->m_SampleWindowSize; }
+		virtual inline uint32			GetSampleSize() const override { return sizeof(T); }
 
-		virtual inline void				Clear() override { this->m_BufferIndex = 0; this->m_SampleCount = 0; }
+		inline bool						IsCompressed() const { return this->m_IsCompressed; }
 
-		virtual inline uint64			GetDataSourcePhysicalMemorySize() override { return sizeof(T) * this->m_SampleWindowSize; }
+		inline bool						IsRunLengthEncoded() const { return this->m_RunLengthEncoded; }
+		inline int32					GetRunCount() const { return this->m_RunStarts.Num() - this->m_FirstRun; }
 	};
 
 	///-------------------------------------------------------------------------------------------------
@@ -407,8 +1247,8 @@ namespace StatsTracer {
 	{ 
 	public: 
 		
-		FBoolDataSource(const bool* source, const FString& name, const FString& group = "", const FString& description = "", const FColor& color = FColor(0, 0, 0, 0), const bool streamToCsv = true) :
-			FDataSource(source, name, group, description, color, streamToCsv)
+		FBoolDataSource(const bool* source, const FString& name, const FString& group = "", const FString& description = "", const FColor& color = FColor(0, 0, 0, 0), const bool streamToCsv = true, const bool recordChangesOnly = false) :
+			FDataSource(source, name, group, description, color, streamToCsv, recordChangesOnly)
 		{}
 		
 		virtual ~FBoolDataSource()
@@ -421,8 +1261,8 @@ namespace StatsTracer {
 	{ 
 	public:
 
-		FIntDataSource(const int32* source, const FString& name, const FString& group = "", const FString& description = "", const FColor& color = FColor(0, 0, 0, 0), const bool streamToCsv = true) :
-			FDataSource(source, name, group, description, color, streamToCsv)
+		FIntDataSource(const int32* source, const FString& name, const FString& group = "", const FString& description = "", const FColor& color = FColor(0, 0, 0, 0), const bool streamToCsv = true, const bool recordChangesOnly = false) :
+			FDataSource(source, name, group, description, color, streamToCsv, recordChangesOnly)
 		{}
 
 		virtual ~FIntDataSource()
@@ -449,8 +1289,8 @@ namespace StatsTracer {
 	{ 
 	public: 
 
-		FByteDataSource(const uint8* source, const FString& name, const FString& group = "", const FString& description = "", const FColor& color = FColor(0, 0, 0, 0), const bool streamToCsv = true) :
-			FDataSource(source, name, group, description, color, streamToCsv)
+		FByteDataSource(const uint8* source, const FString& name, const FString& group = "", const FString& description = "", const FColor& color = FColor(0, 0, 0, 0), const bool streamToCsv = true, const bool recordChangesOnly = false) :
+			FDataSource(source, name, group, description, color, streamToCsv, recordChangesOnly)
 		{}
 
 		virtual ~FByteDataSource()
@@ -501,6 +1341,125 @@ namespace StatsTracer {
 		virtual inline EDataSourceType GetDataSourceType() const override { return EDataSourceType::Transform; }
 	};
 
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	FDataSourceSamplingPlan
+	///
+	/// Summary:	A flat, type bucketed list of a repository's data sources. The plan is compiled once
+	/// when the repository starts, each tick then runs one tight non-virtual gather loop per data 
+	/// source type, followed by a single pass streaming the csv row in header column order. Data
+	/// sources added to a running repository are appended, the columns before them keep their order.
+	///-------------------------------------------------------------------------------------------------
+
+	class STATSTRACER_API FDataSourceSamplingPlan
+	{
+	public:
+
+		struct FSnapshotColumn
+		{
+			EDataSourceType		Type;
+			const IDataSource*	DataSource;
+
+			// index within the type bucket, and byte offset of the value in a snapshot row
+			uint32				BucketIndex;
+			uint32				SnapshotOffset;
+		};
+
+	private:
+
+		TArray<FDataSource<bool>*>			m_BoolSources;
+		TArray<FDataSource<int32>*>			m_IntSources;
+		TArray<FDataSource<float>*>			m_FloatSources;
+		TArray<FDataSource<uint8>*>			m_ByteSources;
+		TArray<FDataSource<FVector>*>		m_VectorSources;
+		TArray<FDataSource<FRotator>*>		m_RotatorSources;
+		TArray<FDataSource<FTransform>*>	m_TransformSources;
+
+		// all data sources in data group order, and the subset streamed to csv
+		TArray<FSnapshotColumn>				m_Columns;
+		TArray<FSnapshotColumn>				m_CsvColumns;
+
+		int32								m_NumDataSources;
+		uint32								m_SnapshotSize;
+		bool								m_IsCompiled;
+
+		/// Summary:	Adds a data source to its type bucket and the columns, false if its type is unknown.
+		bool								AddToBucket(IDataSource* dataSource);
+
+		/// Summary:	Lays out the snapshot row and collects the csv columns.
+		void								Layout();
+
+	public:
+
+											FDataSourceSamplingPlan();
+											~FDataSourceSamplingPlan();
+
+		void								Compile(const TDataGroupMap& dataGroups);
+		void								Reset();
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FDataSourceSamplingPlan::Append(IDataSource* dataSource);
+		///
+		/// Summary:	Adds a data source to a compiled plan, its column follows all other columns.
+		/// Snapshot offsets change, rows captured before must be consumed first.
+		///
+		/// Parameters:
+		/// dataSource - 	The data source.
+		///-------------------------------------------------------------------------------------------------
+
+		void								Append(IDataSource* dataSource);
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FDataSourceSamplingPlan::Execute(uint64 sequence, CSVStream* stream) const;
+		///
+		/// Summary:	Samples all data sources of the plan and streams one csv row, if a stream is given.
+		///
+		/// Parameters:
+		/// sequence - 	The timeline sequence of this sample.
+		/// stream - 	[in,out] If non-null, the csv stream.
+		///-------------------------------------------------------------------------------------------------
+
+		void								Execute(uint64 sequence, CSVStream* stream) const;
+
+		/// Summary:	Streams the latest sample of all csv columns as one csv row (without line break).
+		void								StreamLatest(CSVStream& stream) const;
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FDataSourceSamplingPlan::Capture(uint8* row) const;
+		///
+		/// Summary:	Copies the raw values of all data sources into a snapshot row of GetSnapshotSize()
+		/// bytes, buckets back to back in type order.
+		///
+		/// Parameters:
+		/// row - 	[out] The snapshot row.
+		///-------------------------------------------------------------------------------------------------
+
+		void								Capture(uint8* row) const;
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FDataSourceSamplingPlan::Apply(const uint8* row, uint64 sequence) const;
+		///
+		/// Summary:	Pushes a snapshot row taken by Capture into the data sources.
+		///
+		/// Parameters:
+		/// row - 	The snapshot row.
+		/// sequence - 	The timeline sequence of this sample.
+		///-------------------------------------------------------------------------------------------------
+
+		void								Apply(const uint8* row, uint64 sequence) const;
+
+		/// Summary:	Streams a snapshot row taken by Capture as one csv row (without line break).
+		void								StreamRow(const uint8* row, CSVStream& stream) const;
+
+		/// Summary:	Byte offset of a data source's value in a snapshot row, INDEX_NONE if not part of the plan.
+		int32								FindSnapshotOffset(const IDataSource* dataSource) const;
+
+		inline const TArray<FSnapshotColumn>& GetSnapshotColumns() const { return this->m_Columns; }
+		inline const TArray<FSnapshotColumn>& GetCsvColumns() const { return this->m_CsvColumns; }
+		inline bool							IsCompiled() const { return this->m_IsCompiled; }
+		inline int32						Num() const { return this->m_NumDataSources; }
+		inline uint32						GetSnapshotSize() const { return this->m_SnapshotSize; }
+	};
+
 	///-------------------------------------------------------------------------------------------------
 	/// Class:	FTracerDataRepository
 	///
@@ -533,11 +1492,22 @@ namespace StatsTracer {
 		const FString							m_RepositoryName;
 		const FText								m_RepositoryDescription;
 
-		AActor*									m_TracedActor;
+		// weak, the lifetime delegates release it, but an editor actor may still be collected before they fire
+		TWeakObjectPtr<AActor>					m_TracedActor;
 		const FName								m_TracedActorFName;
 
 		TWeakPtr<FTracerSession>				m_Session;
 		TDataGroupMap							m_DataGroups;
+
+		// sources waiting for an older session's compression to make room, see AddDeferredDataSources
+		TDataSourceArray						m_DeferredDataSources;
+
+		FTracerTimeline							m_Timeline;
+		FDataSourceSamplingPlan					m_SamplingPlan;
+
+		// the rate the timeline records at, data sources may sample every n-th timeline entry only
+		FTracerSampleRate						m_SampleRate;
+		double									m_NextSampleTime;
 		
 		State									m_State;
 
@@ -546,16 +1516,213 @@ namespace StatsTracer {
 
 		CSVStream*								m_CSVStream;
 
+		// binary alternative to the csv stream, see ETraceFileFormat
+		TUniquePtr<FTraceStream>				m_TraceStream;
+		TArray<uint8>							m_TraceRow;
+
+		/*
+			Disk backed history. Every full chunk of the timeline is sealed and appended to the archive,
+			the ring only stays the hot tier. Stop seals the partial chunk left over before it closes the
+			archive. m_ArchivedSources holds the data sources in column order.
+		*/
+		TUniquePtr<FHistoryArchive>				m_HistoryArchive;
+		TArray<IDataSource*>					m_ArchivedSources;
+		TArray<uint8>							m_ArchiveStaging;
+
+		/*
+			Asynchronous writing. Every sample is published as a record (FSampleRecord followed by the 
+			snapshot row) to a lock-free ring, which is all the game thread does per sample. The session's 
+			writer task consumes the records through m_WriteCursor and streams them to the csv file and 
+			the history archive, the sample rings are filled through m_ViewCursor once someone reads them, 
+			see ApplyPublishedSamples. A repository nobody reads applies them itself once half the ring is
+			pending. The ring only covers a few frames of lag, a consumer falling further behind loses the
+			oldest records instead of stalling the game thread. Other consumers can attach their own cursor
+			to GetPublishedSamples().
+		*/
+		struct FSampleRecord
+		{
+			uint64								Sequence;
+			uint64								Frame;
+			double								ElapsedTime;
+		};
+
+		FSampleBlockRing						m_PublishedSamples;
+		FSampleBlockRing::FCursor				m_WriteCursor;
+		FSampleBlockRing::FCursor				m_ViewCursor;
+		bool									m_WritesAsynchronously;
+
+		// snapshot offset of each archived data source, in column order
+		TArray<uint32>							m_ArchiveSnapshotOffsets;
+
 		float									m_NextColorStartHue;
 
+		// loaded from a recorded trace, see FTracerSession::Import
+		const bool								m_IsImported;
+
+		/*
+			Memory accounting. The repository measures itself whenever its buffers change and posts the
+			difference to its session's account, see SyncMemoryUsage. While the writer task may own the
+			streams and the archive of an asynchronously writing repository, a change is only flagged and
+			the session syncs it once the task finished.
+		*/
+		static const uint32						MEMORY_SYNC_INTERVAL { 64 };
+
+		FMemoryAccount							m_MemoryAccount;
+		bool									m_MemoryChanged;
+
+		uint64									MeasurePhysicalMemorySize();
+		uint64									MeasureUncompressedMemorySize();
+		void									RequestMemorySync();
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FTracerDataRepository::AdmitDataSource(const TDataSourceHandle& dataSource);
+		///
+		/// Summary:	Checks the memory budget and adds the source to its group. If older sessions are
+		/// still being compressed to make room, the source is deferred instead.
+		///
+		/// Parameters:
+		/// dataSource - 	The data source, bound to the repository's timeline and account.
+		///-------------------------------------------------------------------------------------------------
+
+		void									AdmitDataSource(const TDataSourceHandle& dataSource);
+
+		bool									IsSampleDue(uint64 frame, double ElapsedTime);
+		void									ResolveSampleStrides();
+		void									ResolveSampleStride(IDataSource& dataSource);
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FTracerDataRepository::ExtendSchema(IDataSource* dataSource);
+		///
+		/// Summary:	Adds a data source to a running repository. It is appended to the sampling plan,
+		/// the csv file and the binary trace record the frame from which on it is sampled, rows
+		/// written before are left as they are. It is not part of the history archive.
+		///
+		/// Parameters:
+		/// dataSource - 	The data source just added to its group.
+		///-------------------------------------------------------------------------------------------------
+
+		void									ExtendSchema(IDataSource* dataSource);
+		void									WriteCsvHeader();
+
+		void									OpenHistoryArchive(const FString& sessionDirectory);
+		void									ArchiveHistoryChunk(uint64 firstSequence, uint32 numRows);
+		void									AppendStagedChunk(uint32 numRows);
+
+		void									PublishSample(uint64 sequence, uint64 frame, double ElapsedTime);
+		void									WriteSample(const FSampleRecord& record, const uint8* row);
+		void									StageArchiveSample(const FSampleRecord& record, const uint8* row);
+
 	public:
 
 												FTracerDataRepository(const FString& repositoryName, const FString& repositoryDescription, AActor* tracedActor, TSharedPtr<FTracerSession> session, const bool streamToCsv = false, const bool autostart = true);
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	FTracerDataRepository::FTracerDataRepository(const FString& repositoryName, uint32 repositoryId, TSharedPtr<FTracerSession> session, TUniquePtr<FHistoryArchive> trace, const TArray<FTraceStream::FColumn>& columns);
+		///
+		/// Summary:	Creates a completed, read-only repository showing a recorded trace. It has one
+		/// data source per traced stat, all samples are paged in from the trace.
+		///
+		/// Parameters:
+		/// repositoryName - 	The repository name.
+		/// repositoryId - 		The repository id.
+		/// session - 			The owning session.
+		/// trace - 			The trace, see FHistoryArchive::OpenTrace.
+		/// columns - 			The traced stats, in archive column order.
+		///-------------------------------------------------------------------------------------------------
+
+												FTracerDataRepository(const FString& repositoryName, uint32 repositoryId, TSharedPtr<FTracerSession> session, TUniquePtr<FHistoryArchive> trace, const TArray<FTraceStream::FColumn>& columns);
 												~FTracerDataRepository();
 
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FTracerDataRepository::AddDataSource(IDataSource* dataSourcePtr);
+		///
+		/// Summary:	Adds a data source, the repository takes ownership. Sources added while the
+		/// repository is tracing or paused are sampled from the next sample on. If there is not enough
+		/// memory until an older session is compressed, the source is added once that finished.
+		///
+		/// Parameters:
+		/// dataSourcePtr - 	The data source.
+		///-------------------------------------------------------------------------------------------------
+
 		void									AddDataSource(IDataSource* dataSourcePtr);
 
-		void									Update(uint64 frame, float DeltaTime, bool forceUpdate = false);
+		/// Summary:	Retries the sources deferred by AddDataSource, called when a session's compressed history was applied.
+		void									AddDeferredDataSources();
+
+		/// Summary:	Finds a data source by name (in any group), nullptr if there is none.
+		IDataSource*							FindDataSource(const FString& name) const;
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FTracerDataRepository::SetSampleRate(const FTracerSampleRate& rate);
+		///
+		/// Summary:	Sets the rate this repository samples at, an unset rate falls back to the editor
+		/// settings. Takes effect when the repository starts.
+		///-------------------------------------------------------------------------------------------------
+
+		void									SetSampleRate(const FTracerSampleRate& rate);
+		inline const FTracerSampleRate&			GetSampleRate() const { return this->m_SampleRate; }
+
+		void									Update(uint64 frame, double ElapsedTime, bool forceUpdate = false);
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	bool FTracerDataRepository::BeginUpdate(uint64 frame, double ElapsedTime, bool sessionTracing, bool forceUpdate);
+		///
+		/// Summary:	The serial part of an update, game thread only. Stops the repository if its actor
+		/// is gone, decides whether a sample is due and makes room in the published samples.
+		///
+		/// Parameters:
+		/// frame - 			The session frame.
+		/// ElapsedTime - 		The elapsed session time.
+		/// sessionTracing - 	True, if the session is tracing.
+		/// forceUpdate - 		Sample even if the repository or the session is paused.
+		///
+		/// Returns:	True, if SampleUpdate has to be called for this frame.
+		///-------------------------------------------------------------------------------------------------
+
+		bool									BeginUpdate(uint64 frame, double ElapsedTime, bool sessionTracing, bool forceUpdate);
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FTracerDataRepository::SampleUpdate(uint64 frame, double ElapsedTime, bool useCompiledPlan);
+		///
+		/// Summary:	Takes the sample BeginUpdate found due. It only touches the repository's own data
+		/// sources, timeline and streams, so different repositories may sample in parallel while the
+		/// game thread waits for them.
+		///
+		/// Parameters:
+		/// frame - 			The session frame.
+		/// ElapsedTime - 		The elapsed session time.
+		/// useCompiledPlan - 	See UStatsTracerEditorSettings::UseCompiledSamplingPlan.
+		///-------------------------------------------------------------------------------------------------
+
+		void									SampleUpdate(uint64 frame, double ElapsedTime, bool useCompiledPlan);
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FTracerDataRepository::WriteSamples();
+		///
+		/// Summary:	Streams all published samples which are not written yet to the csv file and the
+		/// history archive. Called by the session's writer task, or on the game thread while no such
+		/// task is in flight.
+		///-------------------------------------------------------------------------------------------------
+
+		void									WriteSamples();
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FTracerDataRepository::ApplyPublishedSamples();
+		///
+		/// Summary:	Fills the sample rings with the samples published since the last call. Readers of 
+		/// an asynchronously writing repository's data sources call it on the game thread before they
+		/// read, a synchronous repository fills its rings while sampling and ignores the call. Sampling
+		/// calls it too once half of the published samples' ring is pending, so the rings of a repository
+		/// nobody views stay complete.
+		///-------------------------------------------------------------------------------------------------
+
+		void									ApplyPublishedSamples();
+
+		inline bool								HasPendingWrites() const { return this->m_WritesAsynchronously == true && this->m_PublishedSamples.GetBacklog(this->m_WriteCursor) > 0; }
+
+		/// Summary:	Lock-free feed of all samples recorded since Start, see FSampleBlockRing.
+		inline const FSampleBlockRing&			GetPublishedSamples() const { return this->m_PublishedSamples; }
+		inline const FDataSourceSamplingPlan&	GetSamplingPlan() const { return this->m_SamplingPlan; }
 
 		void									Start(const FDateTime& sessionStart);
 		void									Pause();
@@ -565,17 +1732,56 @@ namespace StatsTracer {
 
 		FColor									GetNextDefaultDataSourceColor();
 
-		uint64									GetRepositoryPhysicalMemorySize();
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FTracerDataRepository::SyncMemoryUsage();
+		///
+		/// Summary:	Measures the repository's buffers and updates its memory account, O(data sources).
+		/// Must not run while the session's writer task owns the repository.
+		///-------------------------------------------------------------------------------------------------
+
+		void									SyncMemoryUsage();
+		inline bool								IsMemorySyncPending() const { return this->m_MemoryChanged; }
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FTracerDataRepository::HandOffStreams();
+		///
+		/// Summary:	Hands what the csv and trace streams staged to the file writer once the flush
+		/// interval passed, also while no samples are written. Must not run while the session's
+		/// writer task owns the repository.
+		///-------------------------------------------------------------------------------------------------
+
+		void									HandOffStreams();
+
+		inline FMemoryAccount&					GetMemoryAccount() { return this->m_MemoryAccount; }
+		inline uint64							GetRepositoryPhysicalMemorySize() const { return this->m_MemoryAccount.GetPhysical(); }
+		inline uint64							GetRepositoryUncompressedMemorySize() const { return this->m_MemoryAccount.GetUncompressed(); }
+
+		/// Summary:	Compresses timeline and data sources, see FTracerSession::CompressSession.
+		void									EncodeHistory();
+		void									ApplyEncodedHistory();
+		void									ReleaseDecodedHistory();
 
 		inline const uint32						GetRepositoryId() const { return this->m_RepositoryId; }
 		inline const FString&					GetRepositoryName() const { return this->m_RepositoryName; }
 		inline const TDataGroupMap&				GetRepositoryData() const { return this->m_DataGroups; }
+		inline const FTracerTimeline&			GetTimeline() const { return this->m_Timeline; }
+
+		/// Summary:	Selects the archived page (first chunk) all views of this repository show, INDEX_NONE shows the latest samples.
+		void									SetHistoryPage(int32 chunk);
+		inline int32							GetHistoryPage() const { return this->m_Timeline.GetHistoryPage(); }
+
+		inline bool								HasHistoryArchive() const { return this->m_HistoryArchive.IsValid(); }
+		inline int32							GetNumArchivedChunks() const { return this->m_HistoryArchive.IsValid() ? this->m_HistoryArchive->GetNumChunks() : 0; }
 		inline const FText&						GetRepositoryDescription() const { return this->m_RepositoryDescription; }
 		
 		bool									HasTracedActor() const;
+		inline AActor*							GetTracedActor() const { return this->m_TracedActor.Get(); }
 
 		void									SelectTracedActor();
 
+		/// Summary:	Called once the traced actor is destroyed or its world or level is torn down, stops tracing and forgets the actor.
+		void									ReleaseTracedActor();
+
 
 		inline TWeakPtr<FTracerSession>			GetSession() const { return this->m_Session; }
 
@@ -586,6 +1792,8 @@ namespace StatsTracer {
 
 		inline bool								ShouldStreamToCsv() const { return this->m_StreamToCsv; }
 		inline bool								ShouldAutostartOnBeginPlay() const { return this->m_AutoStartOnBeginPlay; }
+
+		inline bool								IsImported() const { return this->m_IsImported; }
 	};
 
 	///-------------------------------------------------------------------------------------------------
@@ -623,18 +1831,53 @@ namespace StatsTracer {
 		FDateTime									m_SessionStart;
 		FDateTime									m_SessionEnd;
 
-		TTracerDataRepositoryMapHandle				m_RepositoryMap;
+		// FPlatformTime::Seconds() the session was last looked at, see FTracerDataRepositoryManager::ReclaimPhysicalMemory
+		double										m_LastAccessTime;
+
+		/*
+			Repositories are stored densely, the per frame update walks them back to back. The store's
+			key index finds a repository by id, e.g. the actor traced by it.
+		*/
+		TTracerDataRepositoryStoreHandle			m_Repositories;
 
 		uint64										m_FrameCounter;
-		float										m_ElapsedTime;
+		double										m_ElapsedTime;
+
+		// background compression of a completed session's history
+		FGraphEventRef								m_CompressionTask;
+		bool										m_IsCompressionApplied;
+
+		// writes the samples published by the repositories
+		FGraphEventRef								m_SamplingTask;
+
+		// one output file for all repositories, iff enabled
+		FSessionContainerHandle						m_OutputContainer;
+
+		// repositories sampling in the current frame, kept to reuse its allocation
+		TArray<FTracerDataRepository*>				m_DueRepositories;
+
+		// sum of the repositories' accounts and the sample arena's pages, a child of the manager's account
+		FMemoryAccount								m_MemoryAccount;
+
+		// backs the sample rings of all repositories, shared since sources and views may outlive the session
+		FSampleArenaHandle							m_SampleArena;
+
+		void										DispatchSampling();
+		void										CloseOutputContainer();
 
 	public:
 
-													FTracerSession();
+													FTracerSession(FMemoryAccount* parentAccount = nullptr);
 													~FTracerSession();
 
 		TTracerDataRepositoryHandle					CreateTracerRepository(const FString& repositoryName, const FString& repositoryDescription, AActor* tracedActor, const bool streamToCsv = false, const bool autostart = true);
 		void										DeleteTracerRepository(const uint32 repositoryId);
+
+		/// Summary:	Releases the repository tracing the actor, if any. See FTracerDataRepository::ReleaseTracedActor.
+		void										ReleaseTracedActor(const AActor* actor);
+
+		/// Summary:	Releases all repositories whose actor lives in the level, or in the world if no level is given.
+		void										ReleaseTracedActors(const UWorld* world, const ULevel* level);
 		
 		void										StartSession();
 		void										PauseSession();
@@ -643,8 +1886,70 @@ namespace StatsTracer {
 		void										StopSession();
 		void										EndSession();
 
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FTracerSession::CompressSession();
+		///
+		/// Summary:	Compresses the history of all repositories on a worker thread. The raw samples
+		/// are released on the game thread once the compressed copies are complete.
+		///-------------------------------------------------------------------------------------------------
+
+		void										CompressSession();
+		void										ApplyCompressedHistory();
+		void										WaitForCompression();
+
+		/// Summary:	True once CompressSession was called, the compressed history might still be in the making.
+		inline bool									HasCompressionStarted() const { return this->m_CompressionTask.IsValid(); }
+
+		/// Summary:	True while the compressed history is in the making or not yet applied.
+		inline bool									IsCompressionPending() const { return this->m_CompressionTask.IsValid() && this->m_IsCompressionApplied == false; }
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FTracerSession::WaitForPendingSamples();
+		///
+		/// Summary:	Blocks until the writer task finished. Anything that closes, deletes or measures 
+		/// the csv streams and history archives of an active session must call this first.
+		///-------------------------------------------------------------------------------------------------
+
+		void										WaitForPendingSamples();
+
+		/// Summary:	Waits for the writer task and writes all samples that are still pending.
+		void										FlushPendingSamples();
+
+		void										ReleaseDecodedHistory();
+
+		/// Summary:	Retries the data sources its repositories deferred, see FTracerDataRepository::AddDeferredDataSources.
+		void										AddDeferredDataSources();
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	FSessionContainerHandle FTracerSession::GetOutputContainer();
+		///
+		/// Summary:	The container file all repositories of this session stream to, it is created
+		/// with the first repository that starts and closed when the session stops.
+		///
+		/// Returns:	Null if the container could not be opened or the session stopped already.
+		///-------------------------------------------------------------------------------------------------
+
+		FSessionContainerHandle						GetOutputContainer();
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	bool FTracerSession::Import(const FString& path);
+		///
+		/// Summary:	Fills this (new) session with the recorded traces of a session directory, or a single
+		/// trace file, and completes it. Traces are mapped, not loaded, samples are paged in as the
+		/// views show them.
+		///
+		/// Parameters:
+		/// path - 	A session directory or a (compressed) trace file.
+		///
+		/// Returns:	False, if no trace could be imported.
+		///-------------------------------------------------------------------------------------------------
+
+		bool										Import(const FString& path);
 
-		uint64										GetSessionPhysicalMemorySize();
+		inline FMemoryAccount&						GetMemoryAccount() { return this->m_MemoryAccount; }
+		inline const FSampleArenaHandle&			GetSampleArena() const { return this->m_SampleArena; }
+		inline uint64								GetSessionPhysicalMemorySize() const { return this->m_MemoryAccount.GetPhysical(); }
+		inline uint64								GetSessionUncompressedMemorySize() const { return this->m_MemoryAccount.GetUncompressed(); }
 
 		inline const State							GetSessionState() const { return this->m_State; }
 
@@ -657,12 +1962,44 @@ namespace StatsTracer {
 
 		inline const uint32							GetSessionId() const { return this->m_Id; }
 
-		inline TWeakTracerDataRepositoryMapHandle	GetTracerDataRepositoryMap() const { return this->m_RepositoryMap; }
+		inline TWeakTracerDataRepositoryStoreHandle	GetTracerDataRepositories() const { return this->m_Repositories; }
 
 		inline void									SetAllias(const FString& allias) { this->m_AlliasName = allias; }
 		inline const FString&						GetAllias() const { return this->m_AlliasName; }
+
+		/// Summary:	The frame the session samples next.
+		inline uint64								GetFrameCounter() const { return this->m_FrameCounter; }
+
+		/// Summary:	Marks the session as used, e.g. when it is shown in the editor. Least recently used sessions are evicted first.
+		inline void									MarkAccessed() { this->m_LastAccessTime = FPlatformTime::Seconds(); }
+		inline double								GetLastAccessTime() const { return this->m_LastAccessTime; }
+	};
+
+	///-------------------------------------------------------------------------------------------------
+	/// Struct:	FMemoryReclaimEvent
+	///
+	/// Summary:	Reports one step FTracerDataRepositoryManager::ReclaimPhysicalMemory took to make room.
+	///-------------------------------------------------------------------------------------------------
+
+	struct FMemoryReclaimEvent
+	{
+		enum EAction
+		{
+			ReleasedDecodedHistory = 0,
+			CompressedSession,
+			EvictedSession
+		};
+
+		EAction										Action;
+
+		// the session compressed or evicted, empty for ReleasedDecodedHistory
+		FString										SessionName;
+
+		uint64										FreedBytes;
 	};
 
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnMemoryReclaimed, const FMemoryReclaimEvent&);
+
 	///-------------------------------------------------------------------------------------------------
 	/// Class:	FTracerDataRepositoryManager
 	///
@@ -677,6 +2014,15 @@ namespace StatsTracer {
 	{
 		using Sessions = TArray<TTracerSessionHandle>;
 
+	public:
+
+		enum EReclaimResult
+		{
+			Reclaimed = 0,
+			ReclaimPending,
+			ReclaimExhausted
+		};
+
 	private:
 
 												FTracerDataRepositoryManager(const FTracerDataRepositoryManager&);
@@ -684,9 +2030,24 @@ namespace StatsTracer {
 
 		Sessions								m_Sessions;
 
-		uint64									m_TotalPhysicalMemorySize;
-		float									m_RatioTotalLimit;
-		uint64									m_AvailalbeMemory;
+		// root of all sessions' accounts
+		FMemoryAccount							m_MemoryAccount;
+
+		FOnMemoryReclaimed						m_OnMemoryReclaimed;
+
+		// sessions ReclaimPhysicalMemory compresses, their gain is reported once the history is applied
+		TArray<uint32>							m_ReclaimingSessions;
+
+		// receives OnDestroyed of all traced actors, created with the first repository
+		UTracedActorListener*					m_ActorListener;
+
+		FDelegateHandle							m_WorldCleanupHandle;
+		FDelegateHandle							m_LevelRemovedHandle;
+
+		// updates the active session in the PIE world's frame, at the configured sampling phase
+		TUniquePtr<FTracerSessionTickFunction>	m_SessionTickFunction;
+
+		void									ReportReclaim(FMemoryReclaimEvent::EAction action, const FString& sessionName, uint64 physicalBefore);
 
 	public:
 
@@ -704,11 +2065,43 @@ namespace StatsTracer {
 
 		TTracerDataRepositoryHandle				CreateTracerRepository(const FString& repositoryName, const FString& repositoryDescription, AActor* tracedActor, const bool streamToCsv = false, const bool autostart = true);
 
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FTracerDataRepositoryManager::TrackActorLifetime(AActor* actor);
+		///
+		/// Summary:	Pushes the end of the actor's life to the repositories tracing it, instead of having
+		/// them check the actor every frame. The actor's OnDestroyed delegate as well as world cleanup and
+		/// level removal release the repositories of the actor.
+		///
+		/// Parameters:
+		/// actor - 	The traced actor.
+		///-------------------------------------------------------------------------------------------------
+
+		void									TrackActorLifetime(AActor* actor);
+
+		/// Summary:	Releases the repositories of all sessions tracing the actor.
+		void									ReleaseTracedActor(const AActor* actor);
+
 		void									RemoveSession(const uint32 sessionId);
 
-		void									ConsumePhysicalMemory(uint64 memorySize);
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	TWeakTracerSessionHandle FTracerDataRepositoryManager::ImportSession(const FString& path);
+		///
+		/// Summary:	Imports recorded traces as a completed session, see FTracerSession::Import. The
+		/// imported session never becomes the active session.
+		///
+		/// Returns:	The imported session, invalid if nothing could be imported.
+		///-------------------------------------------------------------------------------------------------
+
+		TWeakTracerSessionHandle				ImportSession(const FString& path);
 
-		inline void								ClearAllSessions() { this->m_Sessions.Empty(); UpdatePhysicalMemoryUsage(); }
+		/// Summary:	Switches a session to its compressed history, called on the game thread once compression
+		/// finished. Data sources deferred for lack of memory are retried afterwards.
+		void									ApplyCompressedSessionHistory(const uint32 sessionId);
+
+		/// Summary:	Drops all samples decoded from compressed sessions.
+		void									ReleaseDecodedHistory();
+
+		inline void								ClearAllSessions() { this->m_Sessions.Empty(); }
 
 		inline int32							GetSessionCount() const { return this->m_Sessions.Num(); }
 
@@ -718,28 +2111,49 @@ namespace StatsTracer {
 		TArray<TWeakTracerSessionHandle>		GetSessionArray();
 
 
-		inline uint64							GetTotalPhysicalMemory() const { return this->m_TotalPhysicalMemorySize; }
-		inline uint64							GetAvailablePhysicalMemory() const { return this->m_AvailalbeMemory; }
-		
-		inline float							GetTotalLimitRatio() const { return this->m_RatioTotalLimit; }
+		/// Summary:	The memory totals of all sessions, O(1) and safe to read from any thread.
+		inline uint64							GetTotalPhysicalMemory() const { return this->m_MemoryAccount.GetPhysical(); }
+		inline uint64							GetTotalUncompressedMemory() const { return this->m_MemoryAccount.GetUncompressed(); }
+
+		uint64									GetAvailablePhysicalMemory() const;
+		float									GetTotalLimitRatio() const;
 
 		///-------------------------------------------------------------------------------------------------
-		/// Fn:	void FTracerDataRepositoryManager::UpdatePhysicalMemoryUsage();
+		/// Fn:	EReclaimResult FTracerDataRepositoryManager::ReclaimPhysicalMemory(uint64 requiredBytes);
 		///
-		/// Summary:	Updates the physical memory usage states.
+		/// Summary:	Makes room for a new allocation by policy, stopping as soon as there is enough.
+		/// Completed sessions are treated least recently used first, the active session is never
+		/// touched: first all decoded history is released, then sessions are compressed (which keeps
+		/// every sample), finally sessions are evicted. Compression runs on a worker thread, one
+		/// session at a time, and sessions are only evicted when none is compressing or left to
+		/// compress. Every step is broadcast by OnMemoryReclaimed. Does nothing if 'Reclaim memory'
+		/// is disabled in the settings.
 		///
-		/// Author:	Tobias Stein
+		/// Parameters:
+		/// requiredBytes - 	The size of the allocation.
 		///
-		/// Date:	4/03/2018
+		/// Returns:	Reclaimed, if there is enough memory available now. ReclaimPending, if a
+		/// compression is under way, the repositories retry their deferred sources once it is applied.
+		/// ReclaimExhausted, if there is nothing left to reclaim.
 		///-------------------------------------------------------------------------------------------------
 
-		void									UpdatePhysicalMemoryUsage();
+		EReclaimResult							ReclaimPhysicalMemory(uint64 requiredBytes);
+
+		inline FOnMemoryReclaimed&				OnMemoryReclaimed() { return this->m_OnMemoryReclaimed; }
 
 	private:
 
 		void									RegisterEditorDelegates();
 		void									UnregisterEditorDelegates();
 
+		void									UnregisterWorldDelegates();
+
+		void									RegisterSessionTick(UWorld* world);
+		void									UnregisterSessionTick();
+
+		void									HandleWorldCleanup(UWorld* world, bool sessionEnded, bool cleanupResources);
+		void									HandleLevelRemovedFromWorld(ULevel* level, UWorld* world);
+
 		void									HandleEditorPreBeginPIE(bool bIsSimulating);
 		void									HandleEditorPostStartedPIE(bool bIsSimulating);
 		void									HandleEditorEndPIE(bool bIsSimulating);
@@ -27,6 +27,39 @@ enum class ETimelineMode : uint8
 	RelativeFrame   UMETA(DisplayName = "Relative Frame")
 };
 
+UENUM(BlueprintType)
+enum class ETraceFileFormat : uint8
+{
+	Csv             UMETA(DisplayName = "CSV"),
+	Binary          UMETA(DisplayName = "Binary (columnar)")
+};
+
+UENUM(BlueprintType)
+enum class ETraceCompression : uint8
+{
+	None            UMETA(DisplayName = "None"),
+	Zlib            UMETA(DisplayName = "Zlib"),
+	Gzip            UMETA(DisplayName = "Gzip"),
+	LZ4             UMETA(DisplayName = "LZ4"),
+	Oodle           UMETA(DisplayName = "Oodle (iff available)")
+};
+
+UENUM(BlueprintType)
+enum class ETracerSampleClock : uint8
+{
+	Frames          UMETA(DisplayName = "Frames"),
+	GameTime        UMETA(DisplayName = "Game time (Hz)"),
+	RealTime        UMETA(DisplayName = "Real time (Hz)")
+};
+
+UENUM(BlueprintType)
+enum class ETracerSamplingPhase : uint8
+{
+	PrePhysics      UMETA(DisplayName = "Pre physics"),
+	PostPhysics     UMETA(DisplayName = "Post physics"),
+	EndOfFrame      UMETA(DisplayName = "End of frame")
+};
+
 /**
  * 
  */
@@ -43,11 +76,14 @@ public:
 
 	static UStatsTracerEditorSettings* GetInstance() { return GetMutableDefault<UStatsTracerEditorSettings>(); }
 
+	/** The sample window in effect: SampleWindowSize rounded down to a power of two, so a tracer never holds more samples than configured (e.g. 10000 gives 8192). */
+	uint32 GetSampleWindowSize() const { return FMath::RoundUpToPowerOfTwo((uint32)FMath::Max(this->SampleWindowSize, 2) + 1) / 2; }
+
 	///-------------------------------------------------------------------------------------------------
 	/// General 
 	///-------------------------------------------------------------------------------------------------
 
-	/** The total amount of samples each tracer can store per session. If the number of sampled data exceeds this buffer size the oldest data sample will be dropped. */
+	/** The total amount of samples each tracer can store per session. If the number of sampled data exceeds this buffer size the oldest data sample will be dropped. The size is rounded down to a power of two. */
 	UPROPERTY(
 		config, 
 		EditAnywhere, 
@@ -58,7 +94,25 @@ public:
 			DisplayName = "Tracer databuffer size"))
 	int32 SampleWindowSize;
 
-	/** The frequency tracers will sample data. This scale is in frames, that is, a frequency of 1 means that each frame data is sampled, a frequency of 5 means every 5 frames ... */
+	/** The clock tracers sample data by. Frames samples every n-th frame, game time and real time sample at a fixed rate in Hz, independent of the frame rate. Tracers and single stats can override the rate. */
+	UPROPERTY(
+		config,
+		EditAnywhere,
+		Category = General,
+		meta = (
+			DisplayName = "Tracer sample clock"))
+	ETracerSampleClock SampleClock;
+
+	/** The point in the frame tracers sample at. Pre physics sees the state before this frame's simulation, post physics right after it, end of frame once all actors and components updated. The phase is fixed when a session starts. */
+	UPROPERTY(
+		config,
+		EditAnywhere,
+		Category = General,
+		meta = (
+			DisplayName = "Tracer sampling phase"))
+	ETracerSamplingPhase SamplingPhase;
+
+	/** The frequency tracers will sample data, if the sample clock is frames. This scale is in frames, that is, a frequency of 1 means that each frame data is sampled, a frequency of 5 means every 5 frames ... */
 	UPROPERTY(
 		config,
 		EditAnywhere,
@@ -69,6 +123,17 @@ public:
 			DisplayName = "Tracer sample frequency (Frames)"))
 	int32 UpdateFrequency;
 
+	/** The rate tracers will sample data, if the sample clock is game or real time. The scale is in samples per second. */
+	UPROPERTY(
+		config,
+		EditAnywhere,
+		Category = General,
+		meta = (
+			UIMin = 0.1, ClampMin = 0.1, 
+			UIMax = 240.0, ClampMax = 1000.0,
+			DisplayName = "Tracer sample rate (Hz)"))
+	float SampleRate;
+
 	/** The maximum number of sessions stored temporarily until the oldest session will be removed. Set this value to zero, if you do not want any session to be removed. (BE AWARE OF POSSIBLE OUT-OF-MEMORY SITUATIONS!) */
 	UPROPERTY(
 		config,
@@ -90,6 +155,77 @@ public:
 			DisplayName = "StatsTracer memory cap (Mbyte)"))
 	int32 PhysicalMemoryLimit;
 
+	/** When the memory cap is reached, make room for new tracers rather than refusing them: first completed sessions are compressed, then the least recently used ones are removed. Each step is reported by a notification. The active session is never affected. */
+	UPROPERTY(
+		config,
+		EditAnywhere,
+		Category = General,
+		meta = (
+			DisplayName = "Reclaim memory"))
+	bool ReclaimMemory;
+
+	/** Samples data sources through a flat, type bucketed plan compiled when a tracer starts. Disable this option to fall back to per data source virtual sampling, e.g. to compare both paths with 'stat StatsTracer-Plugin'. */
+	UPROPERTY(
+		config,
+		EditAnywhere,
+		AdvancedDisplay,
+		Category = General,
+		meta = (
+			DisplayName = "Use compiled sampling plan"))
+	bool UseCompiledSamplingPlan;
+
+	/** Only copies the traced values on the game thread and publishes them to a worker thread, which writes the csv files and history archives. Requires the compiled sampling plan, takes effect when a tracer starts. The game thread only waits for the worker when a tracer starts, stops or changes its data sources. Turned off, every sample is also formatted and written on the game thread. */
+	UPROPERTY(
+		config,
+		EditAnywhere,
+		AdvancedDisplay,
+		Category = General,
+		meta = (
+			DisplayName = "Sample asynchronously",
+			EditCondition = "UseCompiledSamplingPlan"))
+	bool SampleAsynchronously;
+
+	/** Samples the tracers of a session on all worker threads, each tracer still writes its rows in order. Worth it with many traced actors. */
+	UPROPERTY(
+		config,
+		EditAnywhere,
+		AdvancedDisplay,
+		Category = General,
+		meta = (
+			DisplayName = "Update tracers in parallel"))
+	bool UpdateTracersInParallel;
+
+	/** The number of tracers a worker thread samples in one go when tracers are updated in parallel. Smaller batches balance better, larger ones cost less scheduling. */
+	UPROPERTY(
+		config,
+		EditAnywhere,
+		AdvancedDisplay,
+		Category = General,
+		meta = (
+			UIMin = 1, ClampMin = 1,
+			UIMax = 1024, ClampMax = 4096,
+			DisplayName = "Parallel update batch size",
+			EditCondition = "UpdateTracersInParallel"))
+	int32 ParallelUpdateBatchSize;
+
+	/** Compresses the recorded data of a session in the background as soon as it completed. Compressed data is decompressed chunk by chunk when it is displayed. */
+	UPROPERTY(
+		config,
+		EditAnywhere,
+		Category = General,
+		meta = (
+			DisplayName = "Compress completed sessions"))
+	bool CompressCompletedSessions;
+
+	/** Seals the recorded data in chunks and appends them to a history file next to the session's csv files, so the complete history of long sessions can be browsed while memory stays bounded by the tracer databuffer size. */
+	UPROPERTY(
+		config,
+		EditAnywhere,
+		Category = General,
+		meta = (
+			DisplayName = "Archive history to disk"))
+	bool ArchiveHistoryToDisk;
+
 
 	///-------------------------------------------------------------------------------------------------
 	/// Chart Visual Appearance
@@ -174,6 +310,57 @@ public:
 			DisplayName = "Csv file location"))
 	FDirectoryPath CsvOutputDir;
 
+	/** The format tracers stream their samples in. The binary format writes fixed width columns in chunks with a min/max index per chunk, it is a lot smaller and faster to write than csv. Binary traces can be converted to csv with the 'Convert Trace To Csv' blueprint function. */
+	UPROPERTY(
+		config,
+		EditAnywhere,
+		Category = CsvSetting,
+		meta = (
+			DisplayName = "Trace file format"))
+	ETraceFileFormat TraceFileFormat;
+
+	/** Compresses csv, trace and session container files block by block on the file writer thread. Blocks are compressed independently, so a file can still be read up to its last complete block. Compressed files get the '.stz' extension and are read back with the 'Decompress Trace File' blueprint function, 'Convert Trace To Csv' and 'Extract Session Container' read them as they are. */
+	UPROPERTY(
+		config,
+		EditAnywhere,
+		Category = CsvSetting,
+		meta = (
+			DisplayName = "Compression"))
+	ETraceCompression TraceCompression;
+
+	/** Write the output of all tracers of a session into one 'Session.container' file instead of one file per tracer. With many traced actors this saves thousands of open files and small writes. The single files can be extracted again with the 'Extract Session Container' blueprint function. */
+	UPROPERTY(
+		config,
+		EditAnywhere,
+		Category = CsvSetting,
+		meta = (
+			DisplayName = "One file per session"))
+	bool WriteSessionContainer;
+
+	/** All csv and trace files are written by one background thread. Data is handed to it in blocks of this size, larger blocks mean fewer but bigger writes. The unit scale is in kilobytes. */
+	UPROPERTY(
+		config,
+		EditAnywhere,
+		AdvancedDisplay,
+		Category = CsvSetting,
+		meta = (
+			UIMin = 4, ClampMin = 4,
+			UIMax = 16384, ClampMax = 16384,
+			DisplayName = "File writer block size (Kbyte)"))
+	int32 TraceWriterBlockSize;
+
+	/** The longest time recorded data may stay in a partial trace chunk, container block or file writer block before it is written to disk (checked once per frame), that is how much a crash can lose at most. The unit scale is in seconds. */
+	UPROPERTY(
+		config,
+		EditAnywhere,
+		AdvancedDisplay,
+		Category = CsvSetting,
+		meta = (
+			UIMin = 0.05, ClampMin = 0.05,
+			UIMax = 60.0, ClampMax = 60.0,
+			DisplayName = "File writer flush interval (Seconds)"))
+	float TraceWriterFlushInterval;
+
 	/** To reduce the result set of stats detected by 'Tracer' components you can specify filter here. Each entry resembles one filter. Filter can be regular expressions. */
 	UPROPERTY(
 		config,
@@ -26,15 +26,38 @@ DECLARE_CYCLE_STAT(TEXT("UTracerComponent::ScanStats"), STAT_UTracerComponent_Sc
 
 DECLARE_CYCLE_STAT(TEXT("CreateSession"), STAT_CreateSession, STATGROUP_StatsTracerPlugin);
 DECLARE_CYCLE_STAT(TEXT("RemoveSession"), STAT_RemoveSession, STATGROUP_StatsTracerPlugin);
+DECLARE_CYCLE_STAT(TEXT("ImportSession"), STAT_ImportSession, STATGROUP_StatsTracerPlugin);
 
 DECLARE_CYCLE_STAT(TEXT("CreateRepository"), STAT_CreateRepository, STATGROUP_StatsTracerPlugin);
 DECLARE_CYCLE_STAT(TEXT("RemoveRepository"), STAT_RemoveRepository, STATGROUP_StatsTracerPlugin);
 DECLARE_CYCLE_STAT(TEXT("UpdateRepository"), STAT_UpdateRepository, STATGROUP_StatsTracerPlugin);
+DECLARE_CYCLE_STAT(TEXT("UpdateSession"), STAT_UpdateSession, STATGROUP_StatsTracerPlugin);
 
 DECLARE_CYCLE_STAT(TEXT("AddDatasource"), STAT_AddDatasource, STATGROUP_StatsTracerPlugin);
+DECLARE_CYCLE_STAT(TEXT("ExtendSchema"), STAT_ExtendSchema, STATGROUP_StatsTracerPlugin);
 DECLARE_CYCLE_STAT(TEXT("SampleDatasource"), STAT_SampleDatasource, STATGROUP_StatsTracerPlugin);
 
+DECLARE_CYCLE_STAT(TEXT("SampleRepository (compiled plan)"), STAT_SampleRepositoryPlan, STATGROUP_StatsTracerPlugin);
+DECLARE_CYCLE_STAT(TEXT("SampleRepository (virtual)"), STAT_SampleRepositoryVirtual, STATGROUP_StatsTracerPlugin);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sampled datasources"), STAT_SampledDataSources, STATGROUP_StatsTracerPlugin);
+
+DECLARE_CYCLE_STAT(TEXT("PublishSample"), STAT_PublishSample, STATGROUP_StatsTracerPlugin);
+DECLARE_CYCLE_STAT(TEXT("WriteSamples"), STAT_WriteSamples, STATGROUP_StatsTracerPlugin);
+DECLARE_CYCLE_STAT(TEXT("ApplyPublishedSamples"), STAT_ApplyPublishedSamples, STATGROUP_StatsTracerPlugin);
+
+DECLARE_CYCLE_STAT(TEXT("CompressSession"), STAT_CompressSession, STATGROUP_StatsTracerPlugin);
+
+DECLARE_CYCLE_STAT(TEXT("ArchiveHistoryChunk"), STAT_ArchiveHistoryChunk, STATGROUP_StatsTracerPlugin);
+DECLARE_CYCLE_STAT(TEXT("PageInHistory"), STAT_PageInHistory, STATGROUP_StatsTracerPlugin);
+DECLARE_CYCLE_STAT(TEXT("DecodeTraceChunk"), STAT_DecodeTraceChunk, STATGROUP_StatsTracerPlugin);
+
 DECLARE_CYCLE_STAT(TEXT("CSVStream::operator<<"), STAT_CSVSteamOperator, STATGROUP_StatsTracerPlugin);
 DECLARE_CYCLE_STAT(TEXT("CSVStream::Flush()"), STAT_CSVFlush, STATGROUP_StatsTracerPlugin);
 
-DECLARE_CYCLE_STAT(TEXT("UpdatePhysicalMemoryUsage"), STAT_UpdatePhysicalMemoryUsage, STATGROUP_StatsTracerPlugin);
\ No newline at end of file
+DECLARE_CYCLE_STAT(TEXT("FTraceStream::WriteRow"), STAT_TraceStreamWriteRow, STATGROUP_StatsTracerPlugin);
+DECLARE_CYCLE_STAT(TEXT("FTraceStream::WriteChunk"), STAT_TraceStreamWriteChunk, STATGROUP_StatsTracerPlugin);
+DECLARE_CYCLE_STAT(TEXT("FTraceFileWriter::WriteBlocks"), STAT_TraceWriterWriteBlocks, STATGROUP_StatsTracerPlugin);
+DECLARE_CYCLE_STAT(TEXT("FTraceFileWriter::CompressBlock"), STAT_TraceWriterCompressBlock, STATGROUP_StatsTracerPlugin);
+
+DECLARE_CYCLE_STAT(TEXT("SyncMemoryUsage"), STAT_SyncMemoryUsage, STATGROUP_StatsTracerPlugin);
+DECLARE_CYCLE_STAT(TEXT("ReclaimMemory"), STAT_ReclaimMemory, STATGROUP_StatsTracerPlugin);
\ No newline at end of file
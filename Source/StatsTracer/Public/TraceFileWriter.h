@@ -0,0 +1,162 @@
+///-------------------------------------------------------------------------------------------------
+/// File:	StatsTracer\Public\TraceFileWriter.h
+///
+/// Summary:	Declares the background trace file writer.
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+
+class IFileHandle;
+class FRunnableThread;
+class FEvent;
+
+namespace StatsTracer {
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	FTraceFileWriter
+	///
+	/// Summary:	One background thread doing all file I/O of the csv and trace streams. Producers
+	/// append to a per file block, full blocks are handed off to the writer thread which writes them
+	/// in batches. Partially filled blocks are picked up after at most the configured flush interval,
+	/// producers that stage data of their own hand it off within the same interval (see
+	/// FTraceOutput::HandOff), which bounds how much recorded data a crash can lose. Producers never
+	/// touch the file handle.
+	/// If compression is enabled the writer thread compresses every block on its own, see
+	/// DecompressFile for the file layout.
+	///-------------------------------------------------------------------------------------------------
+
+	class STATSTRACER_API FTraceFileWriter : public FRunnable
+	{
+	public:
+
+		class FFile
+		{
+			friend class FTraceFileWriter;
+
+			const FString				m_FileName;
+			const int32					m_BlockSize;
+
+			// compression format, none if the file is written as is
+			const FName					m_Compression;
+
+			// producer side
+			FCriticalSection			m_Lock;
+			TArray<uint8>				m_Block;
+			TArray<TArray<uint8>>		m_FilledBlocks;
+
+			// writer side, also taken by Close so blocks are written in order
+			FCriticalSection			m_WriteLock;
+			IFileHandle*				m_Handle;
+			TArray<uint8>				m_Compressed;
+
+			// set once a write failed, the file stays open but further data is dropped
+			volatile int32				m_Failed;
+
+		public:
+
+			FFile(const FString& fileName, IFileHandle* handle, int32 blockSize, FName compression);
+			~FFile();
+
+			inline const FString&		GetFileName() const { return this->m_FileName; }
+			inline bool					IsValid() const { return FPlatformAtomics::AtomicRead(&this->m_Failed) == 0; }
+		};
+
+		using FFileHandle = TSharedPtr<FFile, ESPMode::ThreadSafe>;
+
+		static const uint32				COMPRESSED_MAGIC { 0x465A5453 }; // 'STZF'
+		static const uint32				COMPRESSED_VERSION { 1 };
+
+		// appended to the name of compressed files
+		static const TCHAR*				COMPRESSED_EXTENSION;
+
+	private:
+
+		static FTraceFileWriter*		Instance;
+
+		FRunnableThread*				m_Thread;
+		FEvent*							m_WakeUp;
+		FThreadSafeCounter				m_StopRequested;
+
+		FCriticalSection				m_FilesLock;
+		TArray<FFileHandle>				m_Files;
+
+		// copied from the settings by Open, read by the writer thread under m_FilesLock
+		double							m_FlushInterval;
+		double							m_NextFlushTime;
+
+										FTraceFileWriter();
+										~FTraceFileWriter();
+
+		/// Summary:	Writes the file's full blocks, and the partial block too iff requested. Returns false if there was nothing to write.
+		bool							WriteBlocks(FFile& file, bool includePartialBlock);
+
+		/// Summary:	Writes blocks taken from the file, the caller holds the file's write lock. Marks the file failed if writing failed.
+		static void						WriteTakenBlocks(FFile& file, const TArray<TArray<uint8>>& blocks);
+
+		/// Summary:	Writes one compressed frame of the given block. Returns false if writing failed.
+		static bool						WriteCompressedBlock(FFile& file, const TArray<uint8>& block);
+
+	public:
+
+		static FTraceFileWriter&		Get();
+
+		/// Summary:	Stops the writer thread and closes all files, called when the module shuts down.
+		static void						Shutdown();
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	FFileHandle FTraceFileWriter::Open(const FString& fileName);
+		///
+		/// Summary:	Creates (or overwrites) a file. The file is opened on the calling thread, so
+		/// failures are reported right away. If compression is enabled COMPRESSED_EXTENSION is
+		/// appended to the file name, see FFile::GetFileName.
+		///
+		/// Returns:	Null if the file could not be opened.
+		///-------------------------------------------------------------------------------------------------
+
+		FFileHandle						Open(const FString& fileName);
+
+		/// Summary:	Appends data to the file's current block, hands the block off once it is full. Thread safe.
+		void							Write(FFile& file, const void* data, int64 size);
+
+		/// Summary:	Hands the file's partially filled block off right away, the writer thread writes it with its next batch. Thread safe.
+		void							HandOff(FFile& file);
+
+		/// Summary:	Writes everything still pending and closes the file. Blocks the calling thread.
+		void							Close(const FFileHandle& file);
+
+		/// Summary:	Writes the blocks already handed off of all open files on the calling thread, from a crash handler. Never waits for a lock, files in use are skipped. Does nothing if the writer was never used.
+		static void						Flush();
+
+		/// Summary:	True, if the file was written with compression.
+		static bool						IsCompressedFile(const FString& fileName);
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	static bool FTraceFileWriter::DecompressFile(const FString& compressedFileName, const FString& fileName);
+		///
+		/// Summary:	Decompresses a file written with compression, frame by frame. A file cut short
+		/// (e.g. by a crash) is decompressed up to its last complete frame.
+		///
+		/// Parameters:
+		/// compressedFileName - 	The compressed file.
+		/// fileName - 				The file to create, the compressed file name without COMPRESSED_EXTENSION if empty.
+		///
+		/// Returns:	False, if the file is not compressed or could not be read or written.
+		///-------------------------------------------------------------------------------------------------
+
+		static bool						DecompressFile(const FString& compressedFileName, const FString& fileName = FString());
+
+		/// Summary:	Loads a file into memory, decompressing it if it was written with compression.
+		static bool						LoadFile(const FString& fileName, TArray<uint8>& outData);
+
+		/// Summary:	The file name without COMPRESSED_EXTENSION.
+		static FString					GetUncompressedFileName(const FString& fileName);
+
+		// FRunnable
+		virtual uint32					Run() override;
+		virtual void					Stop() override;
+	};
+
+} // namespace StatsTracer
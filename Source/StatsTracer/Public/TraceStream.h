@@ -0,0 +1,298 @@
+///-------------------------------------------------------------------------------------------------
+/// File:	StatsTracer\Public\TraceStream.h
+///
+/// Summary:	Declares the binary columnar trace stream class.
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SessionContainer.h"
+
+namespace StatsTracer {
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	FTraceStream
+	///
+	/// Summary:	A binary, column chunked alternative to CSVStream. Rows are staged column-wise and
+	/// written a chunk at a time, each column holds fixed width little-endian values (the same values
+	/// and component order as the csv file). Every chunk ends with a footer holding the min/max of
+	/// each component, so tools can skip chunks without decoding them. Columns added while recording
+	/// are announced by a schema record, later chunks hold them after the earlier columns. ConvertToCsv
+	/// turns a trace back into the csv file the repository would have written. Chunks are handed to the 
+	/// FTraceFileWriter, which does the actual file I/O on its own thread, either into a trace file of
+	/// their own or into a stream of the session container. A chunk is sealed early once the flush
+	/// interval passed, see HandOffIfDue. Chunks and schema records are self-delimiting
+	/// and carry a checksum, so a trace cut short or damaged by a crash is read up to its last intact
+	/// chunk, see FTraceReader.
+	///-------------------------------------------------------------------------------------------------
+
+	class STATSTRACER_API FTraceStream
+	{
+	public:
+
+		struct FColumn
+		{
+			// EDataSourceType of the traced stat
+			uint32						Type;
+
+			// byte offset of the value in the snapshot rows passed to WriteRow
+			uint32						SnapshotOffset;
+
+			// one csv column name per component, e.g. 'Velocity.X'
+			TArray<FString>				ComponentNames;
+		};
+
+		static const uint32				MAGIC { 0x52545453 }; // 'STTR'
+		static const uint32				CHUNK_MAGIC { 0x43545453 }; // 'STTC'
+		static const uint32				SCHEMA_MAGIC { 0x53545453 }; // 'STTS'
+		static const uint32				VERSION { 3 };
+
+		// rows per chunk
+		static const uint32				CHUNK_LENGTH { 1024 };
+
+	private:
+
+		FString							m_FileName;
+
+		TArray<FColumn>					m_Columns;
+		TArray<uint32>					m_ColumnOffsets; // byte offset of each column inside the staged chunk
+		TArray<uint32>					m_ComponentOffsets; // index of each column's first component min/max
+
+		// staged chunk: frames, elapsed times, columns
+		TArray<uint8>					m_Chunk;
+		TArray<double>					m_Min;
+		TArray<double>					m_Max;
+		uint32							m_NumRows;
+		uint32							m_NumChunks;
+
+		FTraceOutput					m_Output;
+
+										FTraceStream(const TArray<FColumn>& columns);
+
+		/// Summary:	Lays out the staged chunk, no rows must be staged.
+		void							Layout();
+
+		void							WriteHeader();
+
+		/// Summary:	Serializes the schema of the columns starting at the given column.
+		void							WriteColumns(FArchive& writer, int32 firstColumn);
+
+		/// Summary:	Writes the staged rows as a chunk, or drops them if the output failed.
+		void							WriteChunk();
+
+		/// Summary:	Empties the staged chunk.
+		void							ResetChunk();
+
+		// a record's payload, written piece by piece
+		using FPayload = TArray<TPair<const void*, uint32>, TInlineAllocator<16>>;
+
+		/// Summary:	Writes a record: its magic, the payload size and the payload's CRC32, then the payload pieces.
+		void							WriteRecord(uint32 magic, const FPayload& payload);
+
+	public:
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	FTraceStream::FTraceStream(const FString& sessionName, const FString& tracerName, const TArray<FColumn>& columns);
+		///
+		/// Summary:	Creates '<tracerName>.trace' in the session's csv output directory and writes the
+		/// schema header.
+		///
+		/// Parameters:
+		/// sessionName - 	The session directory.
+		/// tracerName - 	The file name.
+		/// columns - 		The traced stats, in csv column order.
+		///-------------------------------------------------------------------------------------------------
+
+										FTraceStream(const FString& sessionName, const FString& tracerName, const TArray<FColumn>& columns);
+
+		/// Summary:	Writes to the stream '<tracerName>.trace' of the session container.
+										FTraceStream(const FSessionContainerHandle& container, const FString& tracerName, const TArray<FColumn>& columns);
+										~FTraceStream();
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FTraceStream::WriteRow(uint64 frame, double elapsedTime, const uint8* row);
+		///
+		/// Summary:	Stages one sample, the chunk is written once CHUNK_LENGTH rows are staged or
+		/// the flush interval passed, see HandOffIfDue.
+		///
+		/// Parameters:
+		/// frame - 		The frame number.
+		/// elapsedTime - 	The elapsed session time.
+		/// row - 			A snapshot row, see FDataSourceSamplingPlan::Capture.
+		///-------------------------------------------------------------------------------------------------
+
+		void							WriteRow(uint64 frame, double elapsedTime, const uint8* row);
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FTraceStream::ExtendColumns(uint64 frame, const TArray<FColumn>& columns);
+		///
+		/// Summary:	Updates the columns after the repository's sampling plan changed. The snapshot
+		/// offsets of all columns are taken over, columns beyond the current ones are added: the
+		/// staged chunk is written and a schema record announces the new columns.
+		///
+		/// Parameters:
+		/// frame - 	The first frame sampled with the new columns.
+		/// columns - 	All columns, starting with the current ones.
+		///-------------------------------------------------------------------------------------------------
+
+		void							ExtendColumns(uint64 frame, const TArray<FColumn>& columns);
+
+		/// Summary:	Writes the partially staged chunk and the trailer and closes the file.
+		void							Close();
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	void FTraceStream::HandOffIfDue();
+		///
+		/// Summary:	Once the flush interval passed, writes the staged rows as a (partial) chunk and
+		/// hands everything written to the file writer, so a crash loses at most that interval.
+		/// Readers take chunks of any length up to CHUNK_LENGTH.
+		///-------------------------------------------------------------------------------------------------
+
+		void							HandOffIfDue();
+
+		inline bool						IsValid() const { return this->m_Output.IsValid(); }
+		inline const FString&			GetFileName() const { return this->m_FileName; }
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	static bool FTraceStream::ConvertToCsv(const FString& traceFileName, const FString& csvFileName);
+		///
+		/// Summary:	Converts a trace file into a csv file.
+		///
+		/// Parameters:
+		/// traceFileName - 	The trace file.
+		/// csvFileName - 		The csv file to create, next to the trace file if empty.
+		///
+		/// Returns:	False, if the trace could not be read or the csv file could not be written.
+		///-------------------------------------------------------------------------------------------------
+
+		static bool						ConvertToCsv(const FString& traceFileName, const FString& csvFileName = FString());
+
+		/// Summary:	Number of values a traced stat of the given type is written as.
+		static uint32					GetNumComponents(uint32 type);
+
+		/// Summary:	Width of a single component of the given type in bytes.
+		static uint32					GetComponentSize(uint32 type);
+
+		/// Summary:	Size of a chunk's body (timeline, columns and footer) holding the given number of rows.
+		static int64					GetChunkSize(const TArray<FColumn>& columns, uint32 numRows);
+	};
+
+	///-------------------------------------------------------------------------------------------------
+	/// Class:	FTraceReader
+	///
+	/// Summary:	Walks the records of a trace in memory. Every record is checked against its size
+	/// and checksum (a chunk's checksum may be left to its reader, see the constructor), a damaged
+	/// record is skipped and the reader resynchronizes on the next intact one, so everything complete
+	/// is salvaged from a trace cut short or damaged by a crash. Traces of version 1 and 2 have no
+	/// checksums, they are read up to their first damaged chunk.
+	///-------------------------------------------------------------------------------------------------
+
+	class STATSTRACER_API FTraceReader
+	{
+	public:
+
+		enum ERecord
+		{
+			Chunk = 0,
+			SchemaChange,
+			End
+		};
+
+		struct FChunk
+		{
+			// frames, elapsed times, columns and footer, see FTraceStream::GetChunkSize
+			const uint8*				Body;
+			uint32						NumRows;
+			uint64						FirstFrame;
+			uint64						LastFrame;
+
+			// the checksummed payload, empty for traces without checksums
+			const uint8*				Payload;
+			uint32						PayloadSize;
+			uint32						Checksum;
+		};
+
+	private:
+
+		const uint8*					m_Cursor;
+		const uint8*					m_End;
+
+		uint32							m_Version;
+		uint32							m_ChunkLength;
+		TArray<FTraceStream::FColumn>	m_Columns;
+
+		// the last record read
+		FChunk							m_Chunk;
+		uint64							m_SchemaFrame;
+		int32							m_FirstAddedColumn;
+
+		int32							m_NumChunks;
+		int32							m_NumDamagedRecords;
+		bool							m_IsComplete;
+
+		// chunks found where the previous record ended are not checksummed, see IsIntact
+		const bool						m_DeferChunkChecks;
+
+		/// Summary:	Reads the record at the given position, false if it is not an intact record. A chunk's checksum is only checked if requested.
+		bool							ReadRecord(const uint8* record, ERecord& outRecord, bool checkChunk);
+
+		/// Summary:	Reads the payload of a schema record, appends the added columns.
+		bool							ReadSchemaChange(const uint8*& cursor, const uint8* end);
+
+	public:
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	FTraceReader::FTraceReader(const uint8* data, int64 size, bool deferChunkChecks = false);
+		///
+		/// Summary:	Constructor.
+		///
+		/// Parameters:
+		/// data - 				The trace.
+		/// size - 				The size of the trace in bytes.
+		/// deferChunkChecks - 	If true, chunks are only checked against their sizes while walking the
+		/// 					trace, their checksums are left to the reader of the chunk, see IsIntact.
+		/// 					Chunks found while resynchronizing after a damaged part are always checked.
+		///-------------------------------------------------------------------------------------------------
+
+										FTraceReader(const uint8* data, int64 size, bool deferChunkChecks = false);
+
+		/// Summary:	Reads the schema header, false if the data is not a trace, has an unsupported version or a corrupt header.
+		bool							ReadHeader();
+
+		///-------------------------------------------------------------------------------------------------
+		/// Fn:	ERecord FTraceReader::Next();
+		///
+		/// Summary:	Reads the next intact record. A chunk is described by GetChunk(), a schema change
+		/// appended its columns to GetColumns() and is described by GetSchemaFrame() and
+		/// GetFirstAddedColumn().
+		///
+		/// Returns:	The record read, End once the trailer or the end of the data is reached.
+		///-------------------------------------------------------------------------------------------------
+
+		ERecord							Next();
+
+		inline uint32					GetVersion() const { return this->m_Version; }
+		inline uint32					GetChunkLength() const { return this->m_ChunkLength; }
+
+		/// Summary:	The traced stats, in csv column order. The SnapshotOffset of the columns is not set.
+		inline const TArray<FTraceStream::FColumn>& GetColumns() const { return this->m_Columns; }
+
+		inline const FChunk&			GetChunk() const { return this->m_Chunk; }
+
+		/// Summary:	Checks a chunk's payload against its checksum, true for traces without checksums.
+		static bool						IsIntact(const FChunk& chunk);
+
+		inline uint64					GetSchemaFrame() const { return this->m_SchemaFrame; }
+		inline int32					GetFirstAddedColumn() const { return this->m_FirstAddedColumn; }
+
+		inline int32					GetNumChunks() const { return this->m_NumChunks; }
+
+		/// Summary:	Number of damaged or incomplete parts skipped so far.
+		inline int32					GetNumDamagedRecords() const { return this->m_NumDamagedRecords; }
+
+		/// Summary:	True, once the trailer was read, i.e. the trace was closed properly.
+		inline bool						IsComplete() const { return this->m_IsComplete; }
+	};
+
+} // namespace StatsTracer
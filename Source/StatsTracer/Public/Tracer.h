@@ -53,7 +53,7 @@ public:
 
 	void Initialize(const FString& name, const FString& description, AActor* TracedActor, const bool streamToCsv = false, const bool autostartOnBeginPlay = true);
 
-	/** Adds a new data-source for a bool type variable of the target object to the data-repository. */
+	/** Adds a new data-source for a bool type variable of the target object to the data-repository. If 'recordChangesOnly' is set, samples are only stored when the value changes (for slowly varying stats). */
 	UFUNCTION(BlueprintCallable, Category = "Stats Tracer")
 	void AddBoolStat(
 		UPARAM(ref) const bool& value,
@@ -61,9 +61,10 @@ public:
 		const FString& group = "",
 		const FString& description = "",
 		const FColor color = FColor(0, 0, 0, 0),
-		const bool streamToCsv = true);
+		const bool streamToCsv = true,
+		const bool recordChangesOnly = false);
 
-	/** Adds a new data-source for an int32 type variable of the target object to the data-repository. */
+	/** Adds a new data-source for an int32 type variable of the target object to the data-repository. If 'recordChangesOnly' is set, samples are only stored when the value changes (for slowly varying stats). */
 	UFUNCTION(BlueprintCallable, Category = "Stats Tracer")
 	void AddIntStat(
 		UPARAM(ref) const int32& value,
@@ -71,7 +72,8 @@ public:
 		const FString& group = "",
 		const FString& description = "",
 		const FColor color = FColor(0, 0, 0, 0),
-		const bool streamToCsv = true);
+		const bool streamToCsv = true,
+		const bool recordChangesOnly = false);
 	
 	/** Adds a new data-source for a float type variable of the target object to the data-repository. */
 	UFUNCTION(BlueprintCallable, Category = "Stats Tracer")
@@ -83,7 +85,7 @@ public:
 		const FColor color = FColor(0, 0, 0, 0),
 		const bool streamToCsv = true);
 	
-	/** Adds a new data-source for a byte type variable of the target object to the data-repository. */
+	/** Adds a new data-source for a byte type variable of the target object to the data-repository. If 'recordChangesOnly' is set, samples are only stored when the value changes (for slowly varying stats). */
 	UFUNCTION(BlueprintCallable, Category = "Stats Tracer")
 	void AddByteStat(
 		UPARAM(ref) const uint8& value,
@@ -91,7 +93,8 @@ public:
 		const FString& group = "",
 		const FString& description = "",
 		const FColor color = FColor(0, 0, 0, 0),
-		const bool streamToCsv = true);
+		const bool streamToCsv = true,
+		const bool recordChangesOnly = false);
 	
 	/** Adds a new data-source for a FVector type variable of the target object to the data-repository. */
 	UFUNCTION(BlueprintCallable, Category = "Stats Tracer")
@@ -123,8 +126,21 @@ public:
 		const FColor color = FColor(0, 0, 0, 0),
 		const bool streamToCsv = true);
 
+	/** Sets the rate the tracer samples at. With the 'Frames' clock the rate is the number of frames between two samples, with a time based clock it is in Hz. A rate of zero uses the editor settings. Must be called before the tracer starts. */
+	UFUNCTION(BlueprintCallable, Category = "Stats Tracer")
+	void SetSampleRate(
+		const ETracerSampleClock clock,
+		const float rate);
+
+	/** Lets a single data-source sample slower than the tracer, e.g. every 10th frame or at 2 Hz. The clock must match the tracer's clock, a rate of zero samples at the tracer's rate. Must be called before the tracer starts. */
+	UFUNCTION(BlueprintCallable, Category = "Stats Tracer")
+	void SetStatSampleRate(
+		const FString& name,
+		const ETracerSampleClock clock,
+		const float rate);
+
 
-	/** Stats the tracer. This method should be called after all data-sources are added. After calling this method no more data-sources can be added. */
+	/** Starts the tracer. Data-sources added before this call are sampled from the first sample on. Data-sources added while the tracer runs join with its next sample, their earlier samples read as zero and the csv and trace output continue with an extended header. */
 	UFUNCTION(BlueprintCallable, Category = "Stats Tracer")
 	void StartTracer();
 
@@ -15,6 +15,7 @@
 
 #include "Engine.h"
 #include "Components/ActorComponent.h"
+#include "StatsTracerEditorSettings.h"
 
 #include "TracerComponent.generated.h"
 
@@ -61,6 +62,13 @@ struct FTracableStat
 	UPROPERTY()
 	bool							StreamToCsv;
 
+	UPROPERTY()
+	bool							RecordChangesOnly;
+
+	// in the tracer's sample clock, zero samples at the tracer's rate
+	UPROPERTY()
+	float							SampleRate;
+
 	FTracableStat() :
 		OutterName(TEXT("")),
 		PropertyName(TEXT("INAVLID")),
@@ -70,7 +78,9 @@ struct FTracableStat
 		Description(TEXT("")),
 		Color(FLinearColor::MakeRandomColor()),
 		IsTraced(false),
-		StreamToCsv(false)
+		StreamToCsv(false),
+		RecordChangesOnly(false),
+		SampleRate(0.0f)
 	{}
 
 	FTracableStat(const UProperty* uprop, FLinearColor color) :
@@ -82,7 +92,9 @@ struct FTracableStat
 		Description(TEXT("")),
 		Color(color),
 		IsTraced(false),
-		StreamToCsv(true)
+		StreamToCsv(true),
+		RecordChangesOnly(false),
+		SampleRate(0.0f)
 	{}
 
 	FTracableStat(const FTracableStat& other) :
@@ -94,7 +106,9 @@ struct FTracableStat
 		Description(other.Description),
 		Color(other.Color),
 		IsTraced(other.IsTraced),
-		StreamToCsv(true)
+		StreamToCsv(true),
+		RecordChangesOnly(other.RecordChangesOnly),
+		SampleRate(other.SampleRate)
 	{}
 
 	FTracableStat& operator=(const FTracableStat& other)
@@ -111,10 +125,18 @@ struct FTracableStat
 		this->Color = other.Color;
 		this->IsTraced = other.IsTraced;
 		this->StreamToCsv = other.StreamToCsv;
+		this->RecordChangesOnly = other.RecordChangesOnly;
+		this->SampleRate = other.SampleRate;
 
 		return *this;
 	}
 
+	/** True, if the stat is of a discrete type for which change-only recording is supported (bool, int32, uint8). */
+	inline bool SupportsRecordChangesOnly() const
+	{
+		return this->PropertyType.Equals("bool") || this->PropertyType.Equals("int32") || this->PropertyType.Equals("uint8");
+	}
+
 	///-------------------------------------------------------------------------------------------------
 	/// Fn:	inline bool operator==(const UProperty* uprop) const
 	///
@@ -188,6 +210,13 @@ public:
 	UPROPERTY()
 	bool								EnableStreamToCsv;
 
+	UPROPERTY()
+	ETracerSampleClock					SampleClock;
+
+	// zero uses the editor settings
+	UPROPERTY()
+	float								SampleRate;
+
 	// Sets default values for this component's properties
 	UTracerComponent();
 
@@ -72,10 +72,16 @@ void FStatsTracerEditorModule::StartupModule()
 	// Register TracerComponent details customization
 	FPropertyEditorModule& PropertyModule = FModuleManager::GetModuleChecked<FPropertyEditorModule>("PropertyEditor");
 	PropertyModule.RegisterCustomClassLayout("TracerComponent", FOnGetDetailCustomizationInstance::CreateStatic(&TracerComponentCustomization::MakeInstance));
+
+	// report sessions compressed or removed to make room for new tracers
+	if (StatsTracer::TDRM != nullptr)
+		MemoryReclaimedHandle = StatsTracer::TDRM->OnMemoryReclaimed().AddRaw(this, &FStatsTracerEditorModule::HandleMemoryReclaimed);
 }
 
 void FStatsTracerEditorModule::ShutdownModule()
 {
+	if (StatsTracer::TDRM != nullptr)
+		StatsTracer::TDRM->OnMemoryReclaimed().Remove(MemoryReclaimedHandle);
 
 	// Unregister TracerComponent details customization
 	FPropertyEditorModule& PropertyModule = FModuleManager::GetModuleChecked<FPropertyEditorModule>("PropertyEditor");
@@ -107,6 +113,34 @@ void FStatsTracerEditorModule::PluginButtonClicked()
 	FGlobalTabmanager::Get()->InvokeTab(StatsTracerEditorMajorTabName);
 }
 
+void FStatsTracerEditorModule::HandleMemoryReclaimed(const StatsTracer::FMemoryReclaimEvent& ReclaimEvent)
+{
+	const FText Freed = FText::AsMemory(ReclaimEvent.FreedBytes);
+	const FText Session = FText::FromString(ReclaimEvent.SessionName);
+
+	FText Message;
+	switch (ReclaimEvent.Action)
+	{
+		case StatsTracer::FMemoryReclaimEvent::ReleasedDecodedHistory:
+			Message = FText::Format(LOCTEXT("MemoryReclaimedDecoded", "StatsTracer memory cap reached: released {0} of decoded history."), Freed);
+			break;
+
+		case StatsTracer::FMemoryReclaimEvent::CompressedSession:
+			Message = FText::Format(LOCTEXT("MemoryReclaimedCompressed", "StatsTracer memory cap reached: compressed '{0}', freed {1}."), Session, Freed);
+			break;
+
+		case StatsTracer::FMemoryReclaimEvent::EvictedSession:
+			Message = FText::Format(LOCTEXT("MemoryReclaimedEvicted", "StatsTracer memory cap reached: removed '{0}', freed {1}."), Session, Freed);
+			break;
+	}
+
+	FNotificationInfo Info(Message);
+	Info.ExpireDuration = 5.0f;
+	Info.bUseLargeFont = false;
+
+	FSlateNotificationManager::Get().AddNotification(Info);
+}
+
 void FStatsTracerEditorModule::AddMenuExtension(FMenuBuilder& Builder)
 {
 	Builder.AddMenuEntry(FStatsTracerEditorCommands::Get().OpenPluginWindow);
@@ -661,6 +661,75 @@ TSharedRef<ITableRow> STracerPropertyListUI::OnGenerateRowForPropertyOwnerListVi
 													]
 												] 
 											]
+
+											+SVerticalBox::Slot() 
+											.HAlign(HAlign_Fill)
+											.AutoHeight()					
+											[ 
+												SNew(SBorder)
+												.HAlign(HAlign_Fill)
+												.VAlign(VAlign_Fill)
+												.Visibility(Item->GetStat().SupportsRecordChangesOnly() ? EVisibility::Visible : EVisibility::Collapsed)
+												[
+													SNew(SHorizontalBox)
+													+SHorizontalBox::Slot()
+													.AutoWidth()
+													[
+														SNew(SCheckBox)
+														.ToolTipText(FText::FromString(TEXT("If enabled a new sample is only stored when the value of this stat changes. Saves a lot of memory for slowly varying stats like states, flags or counters.")))
+														.IsChecked(Item->GetStat().RecordChangesOnly ? ECheckBoxState::Checked : ECheckBoxState::Unchecked)
+														.OnCheckStateChanged_Lambda([&](ECheckBoxState checkState)
+														{
+															Item->GetStat().RecordChangesOnly = (checkState == ECheckBoxState::Checked);
+														})
+													]
+
+													+SHorizontalBox::Slot()
+													.FillWidth(1.0f)
+													[
+														SNew(STextBlock)
+														.Text(FText::FromString(TEXT("Record changes only")))
+													]
+												] 
+											]
+
+											+SVerticalBox::Slot() 
+											.HAlign(HAlign_Fill)
+											.AutoHeight()					
+											[ 
+												SNew(SBorder)
+												.HAlign(HAlign_Fill)
+												.VAlign(VAlign_Fill)
+												[
+													SNew(SHorizontalBox)
+													+SHorizontalBox::Slot()
+													.AutoWidth()
+													[
+														SNew(SBox)
+														.WidthOverride(64.0f)
+														[
+															SNew(SSpinBox<float>)
+															.ToolTipText(FText::FromString(TEXT("Lets this stat sample slower than the tracer. The rate is in the tracer's sample clock, that is frames between two samples or samples per second.")))
+															.MinValue(0.0f)
+															.MaxValue(1000.0f)
+															.Value_Lambda([&]() { return Item->GetStat().SampleRate; })
+															.OnValueChanged_Lambda([&](float value)
+															{
+																Item->GetStat().SampleRate = value;
+															})
+														]
+													]
+
+													+SHorizontalBox::Slot()
+													.FillWidth(1.0f)
+													.VAlign(VAlign_Center)
+													.Padding(4.0f, 0.0f, 0.0f, 0.0f)
+													[
+														SNew(STextBlock)
+														.Text(FText::FromString(TEXT("Sample rate (0 = tracer rate)")))
+													]
+												] 
+											]
 										]
 									]
 								]
@@ -769,6 +838,60 @@ void TracerComponentCustomization::CustomizeDetails(IDetailLayoutBuilder& Detail
 					]
 				]
 
+				// Tracer Sample Rate
+				+SVerticalBox::Slot()
+				.HAlign(HAlign_Fill)
+				.AutoHeight()
+				.MaxHeight(24.0f)
+				.Padding(0.0f, 4.0f, 0.0f, 0.0f)
+				[
+					SNew(SHorizontalBox)
+					+SHorizontalBox::Slot()
+					.AutoWidth()
+					.VAlign(VAlign_Center)
+					[
+						SNew(STextBlock).Text(FText::FromString("Sample rate:"))
+					]
+
+					+SHorizontalBox::Slot()
+					.FillWidth(1.0f)
+					.Padding(4.0f, 0.0f, 0.0f, 0.0f)
+					[
+						SNew(SSpinBox<float>)
+						.ToolTipText(FText::FromString(TEXT("Frames between two samples with the frames clock, samples per second with a time based clock. 0 uses the editor settings.")))
+						.MinValue(0.0f)
+						.MaxValue(1000.0f)
+						.Value_Lambda([this]() { return this->m_TracerComp.IsValid() ? this->m_TracerComp->SampleRate : 0.0f; })
+						.OnValueChanged_Lambda([this](float value)
+						{
+							if (this->m_TracerComp.IsValid() == true)
+								this->m_TracerComp->SampleRate = value;
+						})
+					]
+
+					+SHorizontalBox::Slot()
+					.AutoWidth()
+					.Padding(2.0f, 0.0f, 0.0f, 0.0f)
+					[
+						SNew(SButton)
+						.ToolTipText(FText::FromString(TEXT("The clock the tracer samples by, click to change.")))
+						.Text_Lambda([this]()
+						{
+							if (this->m_TracerComp.IsValid() == false)
+								return FText::FromString(TEXT(""));
+
+							return StaticEnum<ETracerSampleClock>()->GetDisplayNameTextByValue((int64)this->m_TracerComp->SampleClock);
+						})
+						.OnClicked_Lambda([this]()
+						{
+							if (this->m_TracerComp.IsValid() == true)
+								this->m_TracerComp->SampleClock = (ETracerSampleClock)(((uint8)this->m_TracerComp->SampleClock + 1) % ((uint8)ETracerSampleClock::RealTime + 1));
+
+							return FReply::Handled();
+						})
+					]
+				]
+
 				// Tracer Description
 				+SVerticalBox::Slot()
 				.HAlign(HAlign_Fill)
@@ -112,8 +112,15 @@ void SStatsTracerMemoryLoadDisplay::Construct(const FArguments& InArgs)
 								.Font(FStatsTracerEditorStyle::Get().GetFontStyle("NormalBoldFont"))
 								.Text_Lambda([]()
 								{
-									return FText::FromString(FString::Printf(TEXT("%.2f Mbyte"), ((float)StatsTracer::TDRM->GetTotalPhysicalMemory() / 1048576.0f))); // convert to megebyte
+									const float physical = (float)StatsTracer::TDRM->GetTotalPhysicalMemory() / 1048576.0f; // convert to megebyte
+									const float uncompressed = (float)StatsTracer::TDRM->GetTotalUncompressedMemory() / 1048576.0f;
+
+									if (StatsTracer::TDRM->GetTotalUncompressedMemory() > StatsTracer::TDRM->GetTotalPhysicalMemory())
+										return FText::FromString(FString::Printf(TEXT("%.2f Mbyte (%.2f Mbyte raw)"), physical, uncompressed));
+
+									return FText::FromString(FString::Printf(TEXT("%.2f Mbyte"), physical));
 								})
+								.ToolTipText(FText::FromString("Memory used by all sessions. Completed sessions are stored compressed, the raw size is what they would occupy uncompressed."))
 							]
 						]
 
@@ -314,7 +314,7 @@ void STracerDataChart::SPlotArea::Tick(const FGeometry & AllottedGeometry, const
 	if (this->IsIndexed == true)
 		for (auto& DSItem : this->TracerDataChart->TracerDataSourceListItems)
 			if (DSItem.IsValid() == true)
-				DSItem->DataSourceIndex = this->BufferIndex;
+				DSItem->DataSourceIndex = DSItem->DataSource.IsValid() == true ? DSItem->DataSource->FindSampleIndex(this->BufferIndex) : INDEX_NONE;
 }
 
 int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList & OutDrawElements, int32 LayerId, const FWidgetStyle & InWidgetStyle, bool bParentEnabled) const
@@ -355,7 +355,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 
 		ETimelineMode							Mode;
 
-		float									MaxTime;
+		double									MaxTime;
 		uint64									MaxFrame;
 
 		const StatsTracer::TDataSourceHandle	DataSource0;
@@ -368,8 +368,8 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 		{
 			if (InDataSource0.IsValid())
 			{
-				MaxTime  = InDataSource0->GetElapsedTime(InDataSource0->GetSampleCount() - 1);
-				MaxFrame = InDataSource0->GetFrameNumber(InDataSource0->GetSampleCount() - 1);
+				MaxTime  = InDataSource0->GetTimelineElapsedTime(InDataSource0->GetTimelineCount() - 1);
+				MaxFrame = InDataSource0->GetTimelineFrameNumber(InDataSource0->GetTimelineCount() - 1);
 			}
 		}
 
@@ -378,7 +378,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 
 		FString GetLabelForIndex(uint32 index)
 		{
-			if ( this->Mode == ETimelineMode::None || this->DataSource0.IsValid() == false || index >= this->DataSource0->GetSampleCount())
+			if ( this->Mode == ETimelineMode::None || this->DataSource0.IsValid() == false || index >= this->DataSource0->GetTimelineCount())
 				return FString("");
 
 			FString OutLabel = "";
@@ -388,28 +388,28 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 				// Time
 				case ETimelineMode::Time:
 				{
-					OutLabel = FTimespan::FromSeconds(this->DataSource0->GetElapsedTime(index)).ToString().RightChop(1);
+					OutLabel = FTimespan::FromSeconds(this->DataSource0->GetTimelineElapsedTime(index)).ToString().RightChop(1);
 					break;
 				}
 
 				// Relative Time
 				case ETimelineMode::RelativeTime:
 				{
-					OutLabel = FTimespan::FromSeconds(this->MaxTime - this->DataSource0->GetElapsedTime(index)).ToString().RightChop(1);
+					OutLabel = FTimespan::FromSeconds(this->MaxTime - this->DataSource0->GetTimelineElapsedTime(index)).ToString().RightChop(1);
 					break;
 				}
 
 				// Frame
 				case ETimelineMode::Frame:
 				{
-					OutLabel = FString::Printf(TEXT("%u"), this->DataSource0->GetFrameNumber(index));
+					OutLabel = FString::Printf(TEXT("%u"), this->DataSource0->GetTimelineFrameNumber(index));
 					break;
 				}
 
 				// Relative Frame
 				case ETimelineMode::RelativeFrame:
 				{
-					OutLabel = FString::Printf(TEXT("%u"), this->MaxFrame - this->DataSource0->GetFrameNumber(index));
+					OutLabel = FString::Printf(TEXT("%u"), this->MaxFrame - this->DataSource0->GetTimelineFrameNumber(index));
 					break;
 				}
 			}
@@ -701,7 +701,8 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 		Layout.SetY1(FMath::IsNearlyZero(DS_MaxValue) ? (FMath::Abs(DS_MinValue) > 1.0f ?  1.0f :  1.0f / FMath::Pow(10.0f, FMath::Max<float>(1.0f, precisionMin))) : DS_MaxValue * 1.05f);
 
 		Layout.SetPrecision(FMath::Max<int32>(precisionMin, precisionMax));
-		Layout.SetSampleWindowSize((*this->TracerDataChart)[0]->DataSource->GetSampleWindowSize());
+		// the x axis spans the repository's timeline, sources sampling at a stride are spread across it
+		Layout.SetSampleWindowSize((*this->TracerDataChart)[0]->DataSource->GetTimelineWindowSize());
 
 		Layout.Update();
 	}
@@ -902,11 +903,23 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 
 	// Chart Layer
 	;{
+		// builds one plot vertex per sample, streaming straight through the source's storage; samples are placed at the timeline entry they were taken at
+		auto BuildPlotValues = [&Layout](const auto* DataSource, TArray<FVector2D>& OutValues, auto&& Project)
+		{
+			OutValues.Reset(DataSource->GetSampleCount());
+
+			const int32 t0 = (int32)DataSource->GetTimelineIndex(0);
+			const int32 dt = DataSource->GetSampleCount() > 1 ? (int32)DataSource->GetTimelineIndex(1) - t0 : 1;
+
+			int32 t = t0;
+			DataSource->ForEachSample([&](const auto& V) { OutValues.Emplace(Layout.GetXPos(t), Layout.GetYPos(Project(V))); t += dt; });
+		};
+
 		//ParallelFor(this->TracerDataChart->GetDataSourceCount(), [this, Layout](int32 i)
 		for (int i = 0; i < this->TracerDataChart->GetDataSourceCount(); ++i)
 		{
-			// only care about visible data sources
-			if ((*this->TracerDataChart)[i]->IsVisible == false)
+			// only care about visible data sources, which have been sampled already
+			if ((*this->TracerDataChart)[i]->IsVisible == false || (*this->TracerDataChart)[i]->DataSource->GetSampleCount() == 0)
 				continue;
 
 			StatsTracer::TDataSourceHandle dataSourceHandle = (*this->TracerDataChart)[i]->DataSource;
@@ -919,8 +932,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 				case StatsTracer::Bool:
 				{
 					auto ds = dataSourceHandle->GetAs<StatsTracer::FBoolDataSource>();
-					for (uint32 t = 0; t < ds->GetSampleCount(); ++t)
-						new (TimePlotValues)FVector2D(Layout.GetXPos(t), Layout.GetYPos((*ds)[t].Value));
+					BuildPlotValues(ds, TimePlotValues, [](const auto& V) { return V; });
 
 					// plot it!
 					FSlateDrawElement::MakeLines
@@ -941,8 +953,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 				{
 					auto ds = dataSourceHandle->GetAs<StatsTracer::FIntDataSource>();
 
-					for (uint32 t = 0; t < ds->GetSampleCount(); ++t)
-						new (TimePlotValues)FVector2D(Layout.GetXPos(t), Layout.GetYPos((*ds)[t].Value));
+					BuildPlotValues(ds, TimePlotValues, [](const auto& V) { return V; });
 
 					// plot it!
 					FSlateDrawElement::MakeLines
@@ -962,8 +973,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 				case StatsTracer::Float:
 				{
 					auto ds = dataSourceHandle->GetAs<StatsTracer::FFloatDataSource>();
-					for (uint32 t = 0; t < ds->GetSampleCount(); ++t)
-						new (TimePlotValues)FVector2D(Layout.GetXPos(t), Layout.GetYPos((*ds)[t].Value));
+					BuildPlotValues(ds, TimePlotValues, [](const auto& V) { return V; });
 
 					// plot it!
 					FSlateDrawElement::MakeLines
@@ -983,8 +993,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 				case StatsTracer::Byte:
 				{
 					auto ds = dataSourceHandle->GetAs<StatsTracer::FByteDataSource>();
-					for (uint32 t = 0; t < ds->GetSampleCount(); ++t)
-						new (TimePlotValues)FVector2D(Layout.GetXPos(t), Layout.GetYPos((*ds)[t].Value));
+					BuildPlotValues(ds, TimePlotValues, [](const auto& V) { return V; });
 
 					// plot it!
 					FSlateDrawElement::MakeLines
@@ -1010,10 +1019,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 					// plot X
 					if (li->ShowX == true)
 					{
-						TimePlotValues.Empty();
-
-						for (uint32 t = 0; t < ds->GetSampleCount(); ++t)
-							new (TimePlotValues)FVector2D(Layout.GetXPos(t), Layout.GetYPos((*ds)[t].Value.X));
+						BuildPlotValues(ds, TimePlotValues, [](const auto& V) { return V.X; });
 
 						FSlateDrawElement::MakeLines
 						(
@@ -1029,7 +1035,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 
 						// draw an label along the index line
 						DrawIndexAidLabels(
-							(*ds)[FMath::Clamp<int32>(this->BufferIndex, 0, ds->GetSampleCount() - 1)].Value.X,
+							(*ds)[ds->FindSampleIndex(this->BufferIndex)].X,
 							ds->GetColor(),
 							TEXT(".X"),
 							AllottedGeometry,
@@ -1042,10 +1048,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 					// plot Y
 					if (li->ShowY == true)
 					{
-						TimePlotValues.Empty();
-
-						for (uint32 t = 0; t < ds->GetSampleCount(); ++t)
-							new (TimePlotValues)FVector2D(Layout.GetXPos(t), Layout.GetYPos((*ds)[t].Value.Y));
+						BuildPlotValues(ds, TimePlotValues, [](const auto& V) { return V.Y; });
 
 						FSlateDrawElement::MakeLines
 						(
@@ -1061,7 +1064,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 
 						// draw an label along the index line
 						DrawIndexAidLabels(
-							(*ds)[FMath::Clamp<int32>(this->BufferIndex, 0, ds->GetSampleCount() - 1)].Value.Y,
+							(*ds)[ds->FindSampleIndex(this->BufferIndex)].Y,
 							ds->GetColor(),
 							TEXT(".Y"),
 							AllottedGeometry,
@@ -1074,10 +1077,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 					// plot Z
 					if (li->ShowZ == true)
 					{
-						TimePlotValues.Empty();
-
-						for (uint32 t = 0; t < ds->GetSampleCount(); ++t)
-							new (TimePlotValues)FVector2D(Layout.GetXPos(t), Layout.GetYPos((*ds)[t].Value.Z));
+						BuildPlotValues(ds, TimePlotValues, [](const auto& V) { return V.Z; });
 
 						FSlateDrawElement::MakeLines
 						(
@@ -1093,7 +1093,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 
 						// draw an label along the index line
 						DrawIndexAidLabels(
-							(*ds)[FMath::Clamp<int32>(this->BufferIndex, 0, ds->GetSampleCount() - 1)].Value.Z,
+							(*ds)[ds->FindSampleIndex(this->BufferIndex)].Z,
 							ds->GetColor(),
 							TEXT(".Z"),
 							AllottedGeometry,
@@ -1115,10 +1115,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 					// plot X
 					if (li->ShowX == true)
 					{
-						TimePlotValues.Empty();
-
-						for (uint32 t = 0; t < ds->GetSampleCount(); ++t)
-							new (TimePlotValues)FVector2D(Layout.GetXPos(t), Layout.GetYPos((*ds)[t].Value.Roll));
+						BuildPlotValues(ds, TimePlotValues, [](const auto& V) { return V.Roll; });
 
 						FSlateDrawElement::MakeLines
 						(
@@ -1134,7 +1131,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 
 						// draw an label along the index line
 						DrawIndexAidLabels(
-							(*ds)[FMath::Clamp<int32>(this->BufferIndex, 0, ds->GetSampleCount() - 1)].Value.Roll,
+							(*ds)[ds->FindSampleIndex(this->BufferIndex)].Roll,
 							ds->GetColor(),
 							TEXT(".Roll"),
 							AllottedGeometry,
@@ -1147,10 +1144,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 					// plot Y
 					if (li->ShowY == true)
 					{
-						TimePlotValues.Empty();
-
-						for (uint32 t = 0; t < ds->GetSampleCount(); ++t)
-							new (TimePlotValues)FVector2D(Layout.GetXPos(t), Layout.GetYPos((*ds)[t].Value.Pitch));
+						BuildPlotValues(ds, TimePlotValues, [](const auto& V) { return V.Pitch; });
 
 						FSlateDrawElement::MakeLines
 						(
@@ -1166,7 +1160,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 
 						// draw an label along the index line
 						DrawIndexAidLabels(
-							(*ds)[FMath::Clamp<int32>(this->BufferIndex, 0, ds->GetSampleCount() - 1)].Value.Pitch,
+							(*ds)[ds->FindSampleIndex(this->BufferIndex)].Pitch,
 							ds->GetColor(),
 							TEXT(".Pitch"),
 							AllottedGeometry,
@@ -1179,10 +1173,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 					// plot Z
 					if (li->ShowZ == true)
 					{
-						TimePlotValues.Empty();
-
-						for (uint32 t = 0; t < ds->GetSampleCount(); ++t)
-							new (TimePlotValues)FVector2D(Layout.GetXPos(t), Layout.GetYPos((*ds)[t].Value.Yaw));
+						BuildPlotValues(ds, TimePlotValues, [](const auto& V) { return V.Yaw; });
 
 						FSlateDrawElement::MakeLines
 						(
@@ -1198,7 +1189,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 
 						// draw an label along the index line
 						DrawIndexAidLabels(
-							(*ds)[FMath::Clamp<int32>(this->BufferIndex, 0, ds->GetSampleCount() - 1)].Value.Yaw,
+							(*ds)[ds->FindSampleIndex(this->BufferIndex)].Yaw,
 							ds->GetColor(),
 							TEXT(".Yaw"),
 							AllottedGeometry,
@@ -1222,10 +1213,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 						// plot PX
 						if (li->ShowPX == true)
 						{
-							TimePlotValues.Empty();
-
-							for (uint32 t = 0; t < ds->GetSampleCount(); ++t)
-								new (TimePlotValues)FVector2D(Layout.GetXPos(t), Layout.GetYPos((*ds)[t].Value.GetLocation().X));
+							BuildPlotValues(ds, TimePlotValues, [](const auto& V) { return V.GetLocation().X; });
 
 							FSlateDrawElement::MakeLines
 							(
@@ -1241,7 +1229,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 
 							// draw an label along the index line
 							DrawIndexAidLabels(
-								(*ds)[FMath::Clamp<int32>(this->BufferIndex, 0, ds->GetSampleCount() - 1)].Value.GetLocation().X,
+								(*ds)[ds->FindSampleIndex(this->BufferIndex)].GetLocation().X,
 								ds->GetColor(),
 								TEXT(".Location.X"),
 								AllottedGeometry,
@@ -1254,10 +1242,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 						// plot PY
 						if (li->ShowPY == true)
 						{
-							TimePlotValues.Empty();
-
-							for (uint32 t = 0; t < ds->GetSampleCount(); ++t)
-								new (TimePlotValues)FVector2D(Layout.GetXPos(t), Layout.GetYPos((*ds)[t].Value.GetLocation().Y));
+							BuildPlotValues(ds, TimePlotValues, [](const auto& V) { return V.GetLocation().Y; });
 
 							FSlateDrawElement::MakeLines
 							(
@@ -1273,7 +1258,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 
 							// draw an label along the index line
 							DrawIndexAidLabels(
-								(*ds)[FMath::Clamp<int32>(this->BufferIndex, 0, ds->GetSampleCount() - 1)].Value.GetLocation().Y,
+								(*ds)[ds->FindSampleIndex(this->BufferIndex)].GetLocation().Y,
 								ds->GetColor(),
 								TEXT(".Location.Y"),
 								AllottedGeometry,
@@ -1286,10 +1271,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 						// plot PZ
 						if (li->ShowPZ == true)
 						{
-							TimePlotValues.Empty();
-
-							for (uint32 t = 0; t < ds->GetSampleCount(); ++t)
-								new (TimePlotValues)FVector2D(Layout.GetXPos(t), Layout.GetYPos((*ds)[t].Value.GetLocation().Z));
+							BuildPlotValues(ds, TimePlotValues, [](const auto& V) { return V.GetLocation().Z; });
 
 							FSlateDrawElement::MakeLines
 							(
@@ -1305,7 +1287,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 
 							// draw an label along the index line
 							DrawIndexAidLabels(
-								(*ds)[FMath::Clamp<int32>(this->BufferIndex, 0, ds->GetSampleCount() - 1)].Value.GetLocation().Z,
+								(*ds)[ds->FindSampleIndex(this->BufferIndex)].GetLocation().Z,
 								ds->GetColor(),
 								TEXT(".Location.Z"),
 								AllottedGeometry,
@@ -1322,10 +1304,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 						// plot RX
 						if (li->ShowRX == true)
 						{
-							TimePlotValues.Empty();
-
-							for (uint32 t = 0; t < ds->GetSampleCount(); ++t)
-								new (TimePlotValues)FVector2D(Layout.GetXPos(t), Layout.GetYPos((*ds)[t].Value.GetRotation().Rotator().Roll));
+							BuildPlotValues(ds, TimePlotValues, [](const auto& V) { return V.GetRotation().Rotator().Roll; });
 
 							FSlateDrawElement::MakeLines
 							(
@@ -1341,7 +1320,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 
 							// draw an label along the index line
 							DrawIndexAidLabels(
-								(*ds)[FMath::Clamp<int32>(this->BufferIndex, 0, ds->GetSampleCount() - 1)].Value.GetRotation().Rotator().Roll,
+								(*ds)[ds->FindSampleIndex(this->BufferIndex)].GetRotation().Rotator().Roll,
 								ds->GetColor(),
 								TEXT(".Rotation.Roll"),
 								AllottedGeometry,
@@ -1354,10 +1333,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 						// plot RY
 						if (li->ShowRY == true)
 						{
-							TimePlotValues.Empty();
-
-							for (uint32 t = 0; t < ds->GetSampleCount(); ++t)
-								new (TimePlotValues)FVector2D(Layout.GetXPos(t), Layout.GetYPos((*ds)[t].Value.GetRotation().Rotator().Pitch));
+							BuildPlotValues(ds, TimePlotValues, [](const auto& V) { return V.GetRotation().Rotator().Pitch; });
 
 							FSlateDrawElement::MakeLines
 							(
@@ -1373,7 +1349,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 
 							// draw an label along the index line
 							DrawIndexAidLabels(
-								(*ds)[FMath::Clamp<int32>(this->BufferIndex, 0, ds->GetSampleCount() - 1)].Value.GetRotation().Rotator().Pitch,
+								(*ds)[ds->FindSampleIndex(this->BufferIndex)].GetRotation().Rotator().Pitch,
 								ds->GetColor(),
 								TEXT(".Rotation.Pitch"),
 								AllottedGeometry,
@@ -1386,10 +1362,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 						// plot RZ
 						if (li->ShowRZ == true)
 						{
-							TimePlotValues.Empty();
-
-							for (uint32 t = 0; t < ds->GetSampleCount(); ++t)
-								new (TimePlotValues)FVector2D(Layout.GetXPos(t), Layout.GetYPos((*ds)[t].Value.GetRotation().Rotator().Yaw));
+							BuildPlotValues(ds, TimePlotValues, [](const auto& V) { return V.GetRotation().Rotator().Yaw; });
 
 							FSlateDrawElement::MakeLines
 							(
@@ -1405,7 +1378,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 
 							// draw an label along the index line
 							DrawIndexAidLabels(
-								(*ds)[FMath::Clamp<int32>(this->BufferIndex, 0, ds->GetSampleCount() - 1)].Value.GetRotation().Rotator().Yaw,
+								(*ds)[ds->FindSampleIndex(this->BufferIndex)].GetRotation().Rotator().Yaw,
 								ds->GetColor(),
 								TEXT(".Rotation.Yaw"),
 								AllottedGeometry,
@@ -1422,10 +1395,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 						// plot SX
 						if (li->ShowSX == true)
 						{
-							TimePlotValues.Empty();
-
-							for (uint32 t = 0; t < ds->GetSampleCount(); ++t)
-								new (TimePlotValues)FVector2D(Layout.GetXPos(t), Layout.GetYPos((*ds)[t].Value.GetScale3D().X));
+							BuildPlotValues(ds, TimePlotValues, [](const auto& V) { return V.GetScale3D().X; });
 
 							FSlateDrawElement::MakeLines
 							(
@@ -1441,7 +1411,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 
 							// draw an label along the index line
 							DrawIndexAidLabels(
-								(*ds)[FMath::Clamp<int32>(this->BufferIndex, 0, ds->GetSampleCount() - 1)].Value.GetScale3D().X,
+								(*ds)[ds->FindSampleIndex(this->BufferIndex)].GetScale3D().X,
 								ds->GetColor(),
 								TEXT(".Scale.X"),
 								AllottedGeometry,
@@ -1454,10 +1424,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 						// plot SY
 						if (li->ShowSY == true)
 						{
-							TimePlotValues.Empty();
-
-							for (uint32 t = 0; t < ds->GetSampleCount(); ++t)
-								new (TimePlotValues)FVector2D(Layout.GetXPos(t), Layout.GetYPos((*ds)[t].Value.GetScale3D().Y));
+							BuildPlotValues(ds, TimePlotValues, [](const auto& V) { return V.GetScale3D().Y; });
 
 							FSlateDrawElement::MakeLines
 							(
@@ -1473,7 +1440,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 
 							// draw an label along the index line
 							DrawIndexAidLabels(
-								(*ds)[FMath::Clamp<int32>(this->BufferIndex, 0, ds->GetSampleCount() - 1)].Value.GetScale3D().Y,
+								(*ds)[ds->FindSampleIndex(this->BufferIndex)].GetScale3D().Y,
 								ds->GetColor(),
 								TEXT(".Scale.Y"),
 								AllottedGeometry,
@@ -1486,10 +1453,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 						// plot SZ
 						if (li->ShowSZ == true)
 						{
-							TimePlotValues.Empty();
-
-							for (uint32 t = 0; t < ds->GetSampleCount(); ++t)
-								new (TimePlotValues)FVector2D(Layout.GetXPos(t), Layout.GetYPos((*ds)[t].Value.GetScale3D().Z));
+							BuildPlotValues(ds, TimePlotValues, [](const auto& V) { return V.GetScale3D().Z; });
 
 							FSlateDrawElement::MakeLines
 							(
@@ -1505,7 +1469,7 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 
 							// draw an label along the index line
 							DrawIndexAidLabels(
-								(*ds)[FMath::Clamp<int32>(this->BufferIndex, 0, ds->GetSampleCount() - 1)].Value.GetScale3D().Z,
+								(*ds)[ds->FindSampleIndex(this->BufferIndex)].GetScale3D().Z,
 								ds->GetColor(),
 								TEXT(".Scale.Z"),
 								AllottedGeometry,
@@ -1582,8 +1546,8 @@ int32 STracerDataChart::SPlotArea::OnPaint(const FPaintArgs& Args, const FGeomet
 			uint64 frameNumber = HX * this->TracerDataChart->GetSampleUpdateFrequency();
 
 			StatsTracer::TDataSourceHandle dataSourceHandle = (*this->TracerDataChart)[0]->DataSource;
-			if(dataSourceHandle->GetSampleCount() == dataSourceHandle->GetSampleWindowSize())
-				frameNumber = dataSourceHandle->GetFrameNumber(HX);	
+			if(dataSourceHandle->GetTimelineCount() == dataSourceHandle->GetTimelineWindowSize())
+				frameNumber = dataSourceHandle->GetTimelineFrameNumber(HX);	
 
 
 
@@ -1669,7 +1633,7 @@ void STracerDataChart::SPlotArea::DrawIndexAidLabels(
 		const float LabelXPos = FMath::Clamp<int32>(
 			Layout.InnerRect.X0 + this->MousePosition.X,
 			Layout.InnerRect.X0 + Layout.GetYAxisLabelAreaWidth(),
-			Layout.GetXPos((*this->TracerDataChart)[0]->DataSource->GetSampleCount()));
+			Layout.GetXPos((*this->TracerDataChart)[0]->DataSource->GetTimelineCount()));
 
 		const float LabelYPos = Layout.GetYPos(value);
 
@@ -1797,7 +1761,7 @@ TSharedRef<SWidget> STracerDataChart::FSimpleTracerDataSourceListItem::BuildWidg
 						{
 							auto ds = this->DataSource->GetAs<StatsTracer::FBoolDataSource>();
 							if (ds != nullptr)
-								valueStr = ((*ds)[this->DataSourceIndex].Value == true ? TEXT("true") : TEXT("false"));
+								valueStr = ((*ds)[this->DataSourceIndex] == true ? TEXT("true") : TEXT("false"));
 
 							break;
 						}
@@ -1805,7 +1769,7 @@ TSharedRef<SWidget> STracerDataChart::FSimpleTracerDataSourceListItem::BuildWidg
 						{
 							auto ds = this->DataSource->GetAs<StatsTracer::FIntDataSource>();
 							if (ds != nullptr)
-								valueStr = FString::Printf(TEXT("%d"), (*ds)[this->DataSourceIndex].Value);
+								valueStr = FString::Printf(TEXT("%d"), (*ds)[this->DataSourceIndex]);
 
 							break;
 						}
@@ -1813,7 +1777,7 @@ TSharedRef<SWidget> STracerDataChart::FSimpleTracerDataSourceListItem::BuildWidg
 						{
 							auto ds = this->DataSource->GetAs<StatsTracer::FFloatDataSource>();
 							if (ds != nullptr)
-								valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].Value);
+								valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex]);
 
 							break;
 						}
@@ -1821,7 +1785,7 @@ TSharedRef<SWidget> STracerDataChart::FSimpleTracerDataSourceListItem::BuildWidg
 						{
 							auto ds = this->DataSource->GetAs<StatsTracer::FByteDataSource>();
 							if (ds != nullptr)
-								valueStr = FString::Printf(TEXT("%u"), (*ds)[this->DataSourceIndex].Value);
+								valueStr = FString::Printf(TEXT("%u"), (*ds)[this->DataSourceIndex]);
 
 							break;
 						}
@@ -1950,13 +1914,13 @@ TSharedRef<SWidget> STracerDataChart::FVectorTracerDataSourceListItem::BuildWidg
 							{
 								auto ds = this->DataSource->GetAs<StatsTracer::FVectorDataSource>();
 								if (ds != nullptr)
-									valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].Value.X);
+									valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].X);
 							}
 							else
 							{
 								auto ds = this->DataSource->GetAs<StatsTracer::FRotatorDataSource>();
 								if (ds != nullptr)
-									valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].Value.Roll);
+									valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].Roll);
 							}
 
 							return FText::FromString(valueStr);
@@ -2009,13 +1973,13 @@ TSharedRef<SWidget> STracerDataChart::FVectorTracerDataSourceListItem::BuildWidg
 							{
 								auto ds = this->DataSource->GetAs<StatsTracer::FVectorDataSource>();
 								if (ds != nullptr)
-									valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].Value.Y);
+									valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].Y);
 							}
 							else
 							{
 								auto ds = this->DataSource->GetAs<StatsTracer::FRotatorDataSource>();
 								if (ds != nullptr)
-									valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].Value.Pitch);
+									valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].Pitch);
 							}
 
 							return FText::FromString(valueStr);
@@ -2068,13 +2032,13 @@ TSharedRef<SWidget> STracerDataChart::FVectorTracerDataSourceListItem::BuildWidg
 							{
 								auto ds = this->DataSource->GetAs<StatsTracer::FVectorDataSource>();
 								if (ds != nullptr)
-									valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].Value.Z);
+									valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].Z);
 							}
 							else
 							{
 								auto ds = this->DataSource->GetAs<StatsTracer::FRotatorDataSource>();
 								if (ds != nullptr)
-									valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].Value.Yaw);
+									valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].Yaw);
 							}
 
 							return FText::FromString(valueStr);
@@ -2242,7 +2206,7 @@ TSharedRef<SWidget> STracerDataChart::FTransformTracerDataSourceListItem::BuildW
 										FString valueStr(TEXT("#ERR-VAL"));
 										auto ds = this->DataSource->GetAs<StatsTracer::FTransformDataSource>();
 										if (ds != nullptr)
-											valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].Value.GetTranslation().X);
+											valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].GetTranslation().X);
 
 										return FText::FromString(valueStr);
 									})
@@ -2289,7 +2253,7 @@ TSharedRef<SWidget> STracerDataChart::FTransformTracerDataSourceListItem::BuildW
 										FString valueStr(TEXT("#ERR-VAL"));
 										auto ds = this->DataSource->GetAs<StatsTracer::FTransformDataSource>();
 										if (ds != nullptr)
-											valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].Value.GetTranslation().Y);
+											valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].GetTranslation().Y);
 
 										return FText::FromString(valueStr);
 									})
@@ -2336,7 +2300,7 @@ TSharedRef<SWidget> STracerDataChart::FTransformTracerDataSourceListItem::BuildW
 										FString valueStr(TEXT("#ERR-VAL"));
 										auto ds = this->DataSource->GetAs<StatsTracer::FTransformDataSource>();
 										if (ds != nullptr)
-											valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].Value.GetTranslation().Z);
+											valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].GetTranslation().Z);
 
 										return FText::FromString(valueStr);
 									})
@@ -2428,7 +2392,7 @@ TSharedRef<SWidget> STracerDataChart::FTransformTracerDataSourceListItem::BuildW
 										FString valueStr(TEXT("#ERR-VAL"));
 										auto ds = this->DataSource->GetAs<StatsTracer::FTransformDataSource>();
 										if (ds != nullptr)
-											valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].Value.GetRotation().Rotator().Roll);
+											valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].GetRotation().Rotator().Roll);
 
 										return FText::FromString(valueStr);
 									})
@@ -2475,7 +2439,7 @@ TSharedRef<SWidget> STracerDataChart::FTransformTracerDataSourceListItem::BuildW
 										FString valueStr(TEXT("#ERR-VAL"));
 										auto ds = this->DataSource->GetAs<StatsTracer::FTransformDataSource>();
 										if (ds != nullptr)
-											valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].Value.GetRotation().Rotator().Pitch);
+											valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].GetRotation().Rotator().Pitch);
 
 										return FText::FromString(valueStr);
 									})
@@ -2522,7 +2486,7 @@ TSharedRef<SWidget> STracerDataChart::FTransformTracerDataSourceListItem::BuildW
 										FString valueStr(TEXT("#ERR-VAL"));
 										auto ds = this->DataSource->GetAs<StatsTracer::FTransformDataSource>();
 										if (ds != nullptr)
-											valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].Value.GetRotation().Rotator().Yaw);
+											valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].GetRotation().Rotator().Yaw);
 
 										return FText::FromString(valueStr);
 									})
@@ -2615,7 +2579,7 @@ TSharedRef<SWidget> STracerDataChart::FTransformTracerDataSourceListItem::BuildW
 										FString valueStr(TEXT("#ERR-VAL"));
 										auto ds = this->DataSource->GetAs<StatsTracer::FTransformDataSource>();
 										if (ds != nullptr)
-											valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].Value.GetScale3D().X);
+											valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].GetScale3D().X);
 
 										return FText::FromString(valueStr);
 									})
@@ -2662,7 +2626,7 @@ TSharedRef<SWidget> STracerDataChart::FTransformTracerDataSourceListItem::BuildW
 										FString valueStr(TEXT("#ERR-VAL"));
 										auto ds = this->DataSource->GetAs<StatsTracer::FTransformDataSource>();
 										if (ds != nullptr)
-											valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].Value.GetScale3D().Y);
+											valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].GetScale3D().Y);
 
 										return FText::FromString(valueStr);
 									})
@@ -2709,7 +2673,7 @@ TSharedRef<SWidget> STracerDataChart::FTransformTracerDataSourceListItem::BuildW
 										FString valueStr(TEXT("#ERR-VAL"));
 										auto ds = this->DataSource->GetAs<StatsTracer::FTransformDataSource>();
 										if (ds != nullptr)
-											valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].Value.GetScale3D().Z);
+											valueStr = FString::Printf(TEXT("%f"), (*ds)[this->DataSourceIndex].GetScale3D().Z);
 
 										return FText::FromString(valueStr);
 									})
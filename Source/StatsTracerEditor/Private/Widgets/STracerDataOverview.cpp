@@ -269,9 +269,6 @@ void STracerDataOverview::Construct(const FArguments& InArgs)
 
 						if (this->Parent.IsValid() == true)
 							((STracerSessionOverview*)this->Parent.Pin().Get())->RefreshSessionTracerList();
-
-						if (StatsTracer::TDRM != nullptr)
-							StatsTracer::TDRM->UpdatePhysicalMemoryUsage();
 						
 						return FReply::Handled();
 					})
@@ -282,6 +279,71 @@ void STracerDataOverview::Construct(const FArguments& InArgs)
 						.Image(FStatsTracerEditorStyle::Get().GetBrush("DeleteIcon")))
 					]
 				]
+
+				// archived history, the right end of the slider shows the latest samples
+				+SHorizontalBox::Slot()
+				.HAlign(HAlign_Right)
+				.VAlign(VAlign_Center)
+				.FillWidth(1.0f)
+				[
+					SNew(SBox)
+					.MinDesiredWidth(250.0f)
+					.Visibility_Lambda([this]()
+					{
+						if (this->TracerData.IsValid() && this->TracerData.Pin()->HasHistoryArchive() == true)
+							return EVisibility::Visible;
+
+						return EVisibility::Collapsed;
+					})
+					[
+						SNew(SHorizontalBox)
+						+SHorizontalBox::Slot()
+						.HAlign(HAlign_Fill)
+						.FillWidth(1.0f)
+						[
+							SNew(SSlider)
+							.ToolTipText(FText::FromString("Browse archived history"))
+							.Orientation(EOrientation::Orient_Horizontal)
+							.Value_Lambda([this]()
+							{
+								if (this->TracerData.IsValid() == false)
+									return 1.0f;
+
+								auto pinnedTracerData = this->TracerData.Pin();
+								if (pinnedTracerData->GetHistoryPage() == INDEX_NONE)
+									return 1.0f;
+
+								return (float)pinnedTracerData->GetHistoryPage() / FMath::Max<float>(1.0f, (float)pinnedTracerData->GetNumArchivedChunks());
+							})
+							.OnValueChanged_Lambda([this](float NewValue)
+							{
+								if (this->TracerData.IsValid() == false)
+									return;
+
+								auto pinnedTracerData = this->TracerData.Pin();
+								const int32 chunk = FMath::FloorToInt(NewValue * pinnedTracerData->GetNumArchivedChunks());
+
+								pinnedTracerData->SetHistoryPage(chunk < pinnedTracerData->GetNumArchivedChunks() ? chunk : INDEX_NONE);
+							})
+						]
+
+						+SHorizontalBox::Slot()
+						.AutoWidth()
+						.Padding(4.0f, 0.0f, 2.0f, 0.0f)
+						[
+							SNew(STextBlock)
+							.Font(FStatsTracerEditorStyle::Get().GetFontStyle("NormalBoldFont"))
+							.Text_Lambda([this]()
+							{
+								if (this->TracerData.IsValid() == false || this->TracerData.Pin()->GetHistoryPage() == INDEX_NONE)
+									return FText::FromString("Latest");
+
+								auto pinnedTracerData = this->TracerData.Pin();
+								return FText::FromString(FString::Printf(TEXT("Chunk %d/%d"), pinnedTracerData->GetHistoryPage() + 1, pinnedTracerData->GetNumArchivedChunks()));
+							})
+						]
+					]
+				]
 			]
 		]
 
@@ -414,6 +476,15 @@ void STracerDataOverview::Construct(const FArguments& InArgs)
 }
 END_SLATE_FUNCTION_BUILD_OPTIMIZATION
 
+void STracerDataOverview::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	// the charts read the sample rings, an asynchronously writing tracer fills them for open views only
+	if (this->TracerData.IsValid() == true)
+		this->TracerData.Pin()->ApplyPublishedSamples();
+
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+}
+
 FText STracerDataOverview::GetSessionId() const
 {
 	if (this->TracerData.IsValid() == false || this->TracerData.Pin()->GetSession().IsValid() == false)
@@ -84,6 +84,8 @@ public:
 	/** Constructs this widget with InArgs */
 	void Construct(const FArguments& InArgs);
 
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+
 	inline TWeakPtr<StatsTracer::FTracerSession> GetSessionHandle() const 
 	{ 
 		if (this->TracerData.IsValid() == false)
@@ -14,6 +14,8 @@
 #include "STracerSessionOverview.h"
 #include "StatsTracerEditorPCH.h"
 
+#include "Developer/DesktopPlatform/Public/DesktopPlatformModule.h"
+
 
 STracerSessionOverview::TOpenTabArray STracerSessionOverview::OpenTabArray = STracerSessionOverview::TOpenTabArray();
 
@@ -265,6 +267,46 @@ void STracerSessionOverview::Construct(const FArguments& InArgs)
 							.Image(FStatsTracerEditorStyle::Get().GetBrush("DeleteIcon")))
 						]
 					]
+
+					+SHorizontalBox::Slot()
+					.MaxWidth(32.0f)
+					[
+						SNew(SButton)
+						.OnClicked_Lambda([this]()
+						{
+							IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+							if (DesktopPlatform == nullptr)
+								return FReply::Handled();
+
+							// sessions are recorded into directories of their own
+							FString sessionDirectory;
+							if (DesktopPlatform->OpenDirectoryDialog(FSlateApplication::Get().FindBestParentWindowHandleForDialogs(this->AsShared()), TEXT("Import recorded session"), UStatsTracerEditorSettings::GetInstance()->CsvOutputDir.Path, sessionDirectory) == false)
+								return FReply::Handled();
+
+							auto importedSession = StatsTracer::TDRM->ImportSession(sessionDirectory);
+							if (importedSession.IsValid() == false)
+								return FReply::Handled();
+
+							RefreshSessionItemArray();
+
+							for (auto it : this->SessionItemArray)
+							{
+								if (it.IsValid() == true && it->SessionHandle.IsValid() == true && it->SessionHandle.Pin()->GetSessionId() == importedSession.Pin()->GetSessionId())
+								{
+									OnSessionSelectionChanged(it, ESelectInfo::Direct);
+									break;
+								}
+							}
+
+							return FReply::Handled();
+						})
+						.ForegroundColor(FSlateColor::UseForeground())
+						[
+							TSharedRef<SWidget>(SNew(SImage)
+							.ToolTipText(FText::FromString("Import recorded session"))
+							.Image(FStatsTracerEditorStyle::Get().GetBrush("FolderOpenIcon")))
+						]
+					]
 				]
 
 				// SESSION PROPERTIES
@@ -420,14 +462,11 @@ void STracerSessionOverview::RefreshSessionTracerList()
 	{
 		auto pinnedSessionHandle = this->SelectedSessionItem->SessionHandle.Pin();
 
-		if (pinnedSessionHandle->GetTracerDataRepositoryMap().IsValid() == true)
+		if (pinnedSessionHandle->GetTracerDataRepositories().IsValid() == true)
 		{
-			StatsTracer::TTracerDataRepositoryMapHandle TDR = pinnedSessionHandle->GetTracerDataRepositoryMap().Pin();
+			StatsTracer::TTracerDataRepositoryStoreHandle TDR = pinnedSessionHandle->GetTracerDataRepositories().Pin();
 
-			TArray<StatsTracer::TTracerDataRepositoryHandle> temp;
-			TDR->GenerateValueArray(temp);
-
-			for (auto it : temp)
+			for (auto it : TDR->GetElements())
 			{
 				if (it.IsValid() == false)
 					continue;
@@ -601,6 +640,14 @@ void STracerSessionOverview::OnSessionSelectionChanged(TSessionComboboxItem NewV
 	this->SelectedSessionItem.Reset();
 	this->SelectedSessionItem = NewValue;
 
+	// viewed sessions are the last to be evicted when memory runs short
+	if (NewValue.IsValid() == true && NewValue->SessionHandle.IsValid() == true)
+		NewValue->SessionHandle.Pin()->MarkAccessed();
+
+	// samples decoded for the previously viewed session are not needed anymore
+	if (StatsTracer::TDRM != nullptr)
+		StatsTracer::TDRM->ReleaseDecodedHistory();
+
 	this->RefreshSessionTracerList();
 } 
 
@@ -930,9 +977,6 @@ TSharedRef<ITableRow> STracerSessionOverview::OnGenerateRowForTracerListView(TTr
 											}
 										}
 
-										if (StatsTracer::TDRM != nullptr)
-											StatsTracer::TDRM->UpdatePhysicalMemoryUsage();
-
 										return FReply::Handled();
 									})
 									.ForegroundColor(FSlateColor::UseForeground())
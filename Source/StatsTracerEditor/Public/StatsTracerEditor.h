@@ -23,6 +23,8 @@ static const FName StatsTracerEditorMajorTabName("StatsTracerEditorMajorTab");
 class FToolBarBuilder;
 class FMenuBuilder;
 
+namespace StatsTracer { struct FMemoryReclaimEvent; }
+
 class FStatsTracerEditorModule : public IModuleInterface
 {
 public:
@@ -41,7 +43,12 @@ private:
 
 	TSharedRef<class SDockTab> OnSpawnPluginTab(const class FSpawnTabArgs& SpawnTabArgs);
 
+	/** Shows a notification for each step the plugin took to stay below its memory cap. */
+	void HandleMemoryReclaimed(const StatsTracer::FMemoryReclaimEvent& ReclaimEvent);
+
 private:
 
 	TSharedPtr<class FUICommandList> PluginCommands;
+
+	FDelegateHandle MemoryReclaimedHandle;
 };
\ No newline at end of file
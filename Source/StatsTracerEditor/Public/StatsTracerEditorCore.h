@@ -98,22 +98,22 @@ namespace StatsTracer {
 			this->m_MaxValue = TNumericLimits<T>::Min();
 			T sum = 0;
 
-			for (uint32 i = 0; i < this->m_DataSource->GetSampleCount(); ++i)
+			this->m_DataSource->ForEachSample([&](const T& value)
 			{
-				if (FMath::IsWithinInclusive<T>((*this->m_DataSource)[i].Value, TNumericLimits<T>::Min(), TNumericLimits<T>::Max()) == false)
-					continue;
+				if (FMath::IsWithinInclusive<T>(value, TNumericLimits<T>::Min(), TNumericLimits<T>::Max()) == false)
+					return;
 
 				// update min
-				if ((*this->m_DataSource)[i].Value < this->m_MinValue)
-					this->m_MinValue = (*this->m_DataSource)[i].Value;
+				if (value < this->m_MinValue)
+					this->m_MinValue = value;
 
 				// update max
-				if ((*this->m_DataSource)[i].Value > this->m_MaxValue)
-					this->m_MaxValue = (*this->m_DataSource)[i].Value;
+				if (value > this->m_MaxValue)
+					this->m_MaxValue = value;
 
 				// acc sum
-				sum += (*this->m_DataSource)[i].Value;
-			}
+				sum += value;
+			});
 
 			this->m_AvgValue = (T)(sum / FMath::Max<int32>(1, this->m_DataSource->GetSampleCount()));
 		}
@@ -122,7 +122,7 @@ namespace StatsTracer {
 		inline T					GetMaxValue() const { return this->m_MaxValue; }
 		inline T					GetAvgValue() const { return this->m_AvgValue; }
 		
-		const T&					operator[](int32 i) const { return (*this->m_DataSource)[i].Value; }
+		const T&					operator[](int32 i) const { return (*this->m_DataSource)[i]; }
 	};
 
 	///-------------------------------------------------------------------------------------------------
@@ -161,18 +161,18 @@ namespace StatsTracer {
 			if (this->m_DataSource == nullptr)
 				return;
 
-			for (uint32 i = 0; i < this->m_DataSource->GetSampleCount(); ++i)
+			this->m_DataSource->ForEachSample([&](const bool& value)
 			{
 				// acc sum
-				sum += ((*this->m_DataSource)[i].Value == true ? 1 : 0);
-			}
+				sum += (value == true ? 1 : 0);
+			});
 
 			this->m_AvgValue = (float)(sum / FMath::Min<int32>(1, this->m_DataSource->GetSampleCount()));
 		}
 
 		inline float GetAvgTrueStateValue() const { return this->m_AvgValue; }
 
-		const bool	operator[](int32 i) const { return (*this->m_DataSource)[i].Value; }
+		const bool	operator[](int32 i) const { return (*this->m_DataSource)[i]; }
 	};
 	
 	template<>
@@ -209,11 +209,11 @@ namespace StatsTracer {
 			this->m_MinValue[X] = this->m_MinValue[Y] = this->m_MinValue[Z] = TNumericLimits<float>::Max();
 			this->m_MaxValue[X] = this->m_MaxValue[Y] = this->m_MaxValue[Z] = TNumericLimits<float>::Min();
 			
-			for (uint32 i = 0; i < this->m_DataSource->GetSampleCount(); ++i)
+			this->m_DataSource->ForEachSample([&](const FVector& value)
 			{
-				const float x = (*this->m_DataSource)[i].Value.X;
-				const float y = (*this->m_DataSource)[i].Value.Y;
-				const float z = (*this->m_DataSource)[i].Value.Z;
+				const float x = value.X;
+				const float y = value.Y;
+				const float z = value.Z;
 
 				if (FMath::IsNaN(x) == false && FMath::IsFinite(x))
 				{
@@ -241,7 +241,7 @@ namespace StatsTracer {
 					if (z > this->m_MaxValue[Z])
 						this->m_MaxValue[Z] = z;
 				}
-			}
+			});
 		}
 
 
@@ -252,7 +252,7 @@ namespace StatsTracer {
 		inline const float GetMinValueZ() const { return this->m_MinValue[Z]; }
 		inline const float GetMaxValueZ() const { return this->m_MaxValue[Z]; }
 
-		inline const FVector operator[](int32 i) const { return (*this->m_DataSource)[i].Value; }
+		inline const FVector operator[](int32 i) const { return (*this->m_DataSource)[i]; }
 	};
 
 	template<>
@@ -289,11 +289,11 @@ namespace StatsTracer {
 			this->m_MinValue[X] = this->m_MinValue[Y] = this->m_MinValue[Z] = TNumericLimits<float>::Max();
 			this->m_MaxValue[X] = this->m_MaxValue[Y] = this->m_MaxValue[Z] = TNumericLimits<float>::Min();
 
-			for (uint32 i = 0; i < this->m_DataSource->GetSampleCount(); ++i)
+			this->m_DataSource->ForEachSample([&](const FRotator& value)
 			{
-				const float x = (*this->m_DataSource)[i].Value.Roll;
-				const float y = (*this->m_DataSource)[i].Value.Pitch;
-				const float z = (*this->m_DataSource)[i].Value.Yaw;
+				const float x = value.Roll;
+				const float y = value.Pitch;
+				const float z = value.Yaw;
 
 				if (FMath::IsNaN(x) == false && FMath::IsFinite(x))
 				{
@@ -321,7 +321,7 @@ namespace StatsTracer {
 					if (z > this->m_MaxValue[Z])
 						this->m_MaxValue[Z] = z;
 				}
-			}
+			});
 		}
 
 		inline const float GetMinValueX() const { return this->m_MinValue[X]; }
@@ -331,7 +331,7 @@ namespace StatsTracer {
 		inline const float GetMinValueZ() const { return this->m_MinValue[Z]; }
 		inline const float GetMaxValueZ() const { return this->m_MaxValue[Z]; }
 
-		inline const FRotator operator[](int32 i) const { return (*this->m_DataSource)[i].Value; }
+		inline const FRotator operator[](int32 i) const { return (*this->m_DataSource)[i]; }
 	};
 
 	template<>
@@ -384,11 +384,11 @@ namespace StatsTracer {
 			this->m_MaxValue[RX] = this->m_MaxValue[RY] = this->m_MaxValue[RZ] =
 			this->m_MaxValue[SX] = this->m_MaxValue[SY] = this->m_MaxValue[SZ] = TNumericLimits<float>::Min();
 
-			for (uint32 i = 0; i < this->m_DataSource->GetSampleCount(); ++i)
+			this->m_DataSource->ForEachSample([&](const FTransform& value)
 			{
-				const FVector	P = (*this->m_DataSource)[i].Value.GetLocation();
-				const FRotator	R = (*this->m_DataSource)[i].Value.GetRotation().Rotator();
-				const FVector	S = (*this->m_DataSource)[i].Value.GetScale3D();
+				const FVector	P = value.GetLocation();
+				const FRotator	R = value.GetRotation().Rotator();
+				const FVector	S = value.GetScale3D();
 
 				// Position
 				if (FMath::IsNaN(P.X) == false && FMath::IsFinite(P.X))
@@ -474,7 +474,7 @@ namespace StatsTracer {
 					if (S.Z > this->m_MaxValue[SZ])
 						this->m_MaxValue[SZ] = S.Z;
 				}
-			}
+			});
 		}
 
 		inline const float GetMinValuePX() const { return this->m_MinValue[PX]; }
@@ -498,7 +498,7 @@ namespace StatsTracer {
 		inline const float GetMinValueSZ() const { return this->m_MinValue[SZ]; }
 		inline const float GetMaxValueSZ() const { return this->m_MaxValue[SZ]; }
 
-		inline const FTransform operator[](int32 i) const { return (*this->m_DataSource)[i].Value; }
+		inline const FTransform operator[](int32 i) const { return (*this->m_DataSource)[i]; }
 	};
 
 	///-------------------------------------------------------------------------------------------------
@@ -60,6 +60,7 @@ public class StatsTracerEditor : ModuleRules
                 "AppFramework",
                 "ApplicationCore",
                 "StatsTracer",
+                "DesktopPlatform",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);